@@ -15,29 +15,22 @@ if [ -d result ]; then
     mkdir result
 fi
 
+# Each grid point runs in its own process and writes to its own directory,
+# on all cores by default (set JOBS to limit)
+JOBS=${JOBS:-$(nproc)}
+SWEEP="./build/bin/sync-paxos-sweep --jobs=${JOBS}"
+
 ################################################
 #        Synchronous Paxos
 ################################################    
 # Change parameters and run the program
 # Message Delay Bound Array
-delay_bound_arr=(50000 5000 500 50 5)
+delay_bound_arr="50000us,5000us,500us,50us,5us"
 # Sync Error Parameter Array
-sync_error_arr=(50000 5000 500 50 5)
-
-mkdir -p result/Sync
-
-for i in "${delay_bound_arr[@]}"
-do
-    for j in "${sync_error_arr[@]}"
-    do
-        mkdir -p result/Sync/Delay_${i}us/Sync_${j}ns
-       
-        ./build/bin/sync-paxos --sync=1 --clockSyncError=${j}ns --boundedMessageDelay=${i}us
+sync_error_arr="50000ns,5000ns,500ns,50ns,5ns"
 
-       # move the result to the result folder
-        mv *.dat result/Sync/Delay_${i}us/Sync_${j}ns/
-    done
-done
+${SWEEP} --outputDir=result/Sync --fixed="--sync=1" \
+    --grid="Delay:boundedMessageDelay=${delay_bound_arr};Sync:clockSyncError=${sync_error_arr}"
 
 ################################################
 #        Asynchronous Paxos
@@ -45,16 +38,20 @@ done
 
 # Change parameters and run the program
 # Message Delay
-delay_arr=(50000 5000 500 50 5)
+delay_arr="50000us,5000us,500us,50us,5us"
 
-mkdir -p result/Async
+${SWEEP} --outputDir=result/Async --fixed="--sync=0" --grid="Delay:linkDelay=${delay_arr}"
 
-for i in "${delay_arr[@]}"
-do
-    mkdir -p result/Async/Delay_${i}us
-    
-    ./build/bin/sync-paxos --sync=0 --linkDelay=${i}us 
+################################################
+#        Sequencer Paxos
+################################################
+
+# Same delays as asynchronous Paxos
+${SWEEP} --outputDir=result/Sequencer --fixed="--mode=sequencer" --grid="Delay:linkDelay=${delay_arr}"
+
+################################################
+#        Leaderless Paxos
+################################################
 
-    # move the result to the result folder
-    mv *.dat result/Async/Delay_${i}us/
-done
+# Same delays as asynchronous Paxos
+${SWEEP} --outputDir=result/Leaderless --fixed="--mode=leaderless" --grid="Delay:linkDelay=${delay_arr}"
@@ -1154,6 +1154,11 @@ macro(process_options)
   if(${NS3_ASSERT} OR (${build_profile} STREQUAL "debug"))
     add_definitions(-DNS3_ASSERT_ENABLE)
   endif()
+  # Thread safe reference counts and packet allocation, needed to run the
+  # MultithreadedSimulatorImpl on more than one thread
+  if(${NS3_MTP})
+    add_definitions(-DNS3_MTP)
+  endif()
 
   set(ENABLE_TAP OFF)
   if(${NS3_TAP})
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/aodv/helper/aodv-helper.h"
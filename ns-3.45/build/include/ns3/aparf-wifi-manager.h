@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/wifi/model/rate-control/aparf-wifi-manager.h"
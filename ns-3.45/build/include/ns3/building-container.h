@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/buildings/helper/building-container.h"
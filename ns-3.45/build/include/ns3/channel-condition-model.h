@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/propagation/model/channel-condition-model.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/spectrum/model/constant-spectrum-propagation-loss.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/wifi/model/eht/default-ap-emlsr-manager.h"
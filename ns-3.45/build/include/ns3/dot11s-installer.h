@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/mesh/helper/dot11s/dot11s-installer.h"
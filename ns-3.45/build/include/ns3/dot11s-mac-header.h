@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/mesh/model/dot11s/dot11s-mac-header.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/fd-net-device/model/fd-net-device.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/config-store/model/file-config.h"
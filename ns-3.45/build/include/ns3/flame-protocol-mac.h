@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/mesh/model/flame/flame-protocol-mac.h"
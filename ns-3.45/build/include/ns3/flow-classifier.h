@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/flow-monitor/model/flow-classifier.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/stats/model/gnuplot-aggregator.h"
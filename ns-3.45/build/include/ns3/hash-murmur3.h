@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/core/model/hash-murmur3.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/buildings/model/hybrid-buildings-propagation-loss-model.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/mesh/model/dot11s/ie-dot11s-beacon-timing.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/internet/helper/ipv4-interface-container.h"
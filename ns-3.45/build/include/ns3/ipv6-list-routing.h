@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/internet/model/ipv6-list-routing.h"
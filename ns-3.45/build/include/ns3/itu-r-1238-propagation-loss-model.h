@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/buildings/model/itu-r-1238-propagation-loss-model.h"
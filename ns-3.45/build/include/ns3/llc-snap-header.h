@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/network/utils/llc-snap-header.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/buildings/model/mobility-building-info.h"
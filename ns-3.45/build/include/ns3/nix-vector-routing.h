@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/nix-vector-routing/model/nix-vector-routing.h"
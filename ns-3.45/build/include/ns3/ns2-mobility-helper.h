@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/mobility/helper/ns2-mobility-helper.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/spectrum/model/phased-array-spectrum-propagation-loss-model.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/point-to-point/model/point-to-point-channel.h"
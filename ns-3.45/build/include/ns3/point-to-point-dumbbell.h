@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/point-to-point-layout/model/point-to-point-dumbbell.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/lte/helper/radio-bearer-stats-calculator.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/wifi/model/he/rr-multi-user-scheduler.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/core/model/simulator-impl.h"
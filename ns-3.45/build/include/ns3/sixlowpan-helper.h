@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/sixlowpan/helper/sixlowpan-helper.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/tap-bridge/model/tap-encode-decode.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/spectrum/model/three-gpp-spectrum-propagation-loss-model.h"
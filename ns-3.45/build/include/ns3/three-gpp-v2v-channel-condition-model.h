@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/buildings/model/three-gpp-v2v-channel-condition-model.h"
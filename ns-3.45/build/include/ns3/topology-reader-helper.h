@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/topology-read/helper/topology-reader-helper.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/uan/model/uan-header-common.h"
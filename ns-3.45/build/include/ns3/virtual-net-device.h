@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/virtual-net-device/model/virtual-net-device.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/wifi/model/wifi-default-protection-manager.h"
@@ -0,0 +1 @@
+#include "/root/repo/ns-3.45/src/wifi/helper/wifi-phy-rx-trace-helper.h"
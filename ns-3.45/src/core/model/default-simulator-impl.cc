@@ -12,6 +12,7 @@
 #include "log.h"
 #include "scheduler.h"
 #include "simulator.h"
+#include "string.h"
 
 #include <cmath>
 
@@ -37,7 +38,22 @@ DefaultSimulatorImpl::GetTypeId()
     static TypeId tid = TypeId("ns3::DefaultSimulatorImpl")
                             .SetParent<SimulatorImpl>()
                             .SetGroupName("Core")
-                            .AddConstructor<DefaultSimulatorImpl>();
+                            .AddConstructor<DefaultSimulatorImpl>()
+                            .AddAttribute("TraceFile",
+                                          "Record the event queue operations to this file, "
+                                          "for replay by utils/bench-scheduler",
+                                          TypeId::ATTR_CONSTRUCT | TypeId::ATTR_SET,
+                                          StringValue(""),
+                                          MakeStringAccessor(&DefaultSimulatorImpl::SetTraceFile),
+                                          MakeStringChecker())
+                            .AddAttribute("ProfileFile",
+                                          "Profile the wall clock time and count of the events "
+                                          "per callback, and write the report to this file "
+                                          "at Simulator::Destroy(), \"-\" for the standard output",
+                                          TypeId::ATTR_CONSTRUCT | TypeId::ATTR_SET,
+                                          StringValue(""),
+                                          MakeStringAccessor(&DefaultSimulatorImpl::SetProfileFile),
+                                          MakeStringChecker());
     return tid;
 }
 
@@ -51,7 +67,6 @@ DefaultSimulatorImpl::DefaultSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
-    m_eventsWithContextEmpty = true;
     m_mainThreadId = std::this_thread::get_id();
 }
 
@@ -72,6 +87,7 @@ DefaultSimulatorImpl::DoDispose()
         next.impl->Unref();
     }
     m_events = nullptr;
+    m_trace.Close();
     SimulatorImpl::DoDispose();
 }
 
@@ -89,6 +105,7 @@ DefaultSimulatorImpl::Destroy()
             ev->Invoke();
         }
     }
+    m_profiler.Report();
 }
 
 void
@@ -108,6 +125,30 @@ DefaultSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
     m_events = scheduler;
 }
 
+void
+DefaultSimulatorImpl::SetTraceFile(std::string filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    if (filename.empty())
+    {
+        m_trace.Close();
+        return;
+    }
+    m_trace.Open(filename);
+}
+
+void
+DefaultSimulatorImpl::SetProfileFile(std::string filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    if (filename.empty())
+    {
+        m_profiler.Disable();
+        return;
+    }
+    m_profiler.Enable(filename);
+}
+
 // System ID for non-distributed simulation is always zero
 uint32_t
 DefaultSimulatorImpl::GetSystemId() const
@@ -119,6 +160,10 @@ void
 DefaultSimulatorImpl::ProcessOneEvent()
 {
     Scheduler::Event next = m_events->RemoveNext();
+    if (m_trace.IsOpen())
+    {
+        m_trace.Record(EventTraceRecord::REMOVE_NEXT, next.key.m_uid, next.key.m_ts);
+    }
 
     PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
 
@@ -130,7 +175,16 @@ DefaultSimulatorImpl::ProcessOneEvent()
     m_currentTs = next.key.m_ts;
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
-    next.impl->Invoke();
+    if (m_profiler.IsEnabled())
+    {
+        m_profiler.Start();
+        next.impl->Invoke();
+        m_profiler.Stop(*next.impl);
+    }
+    else
+    {
+        next.impl->Invoke();
+    }
     next.impl->Unref();
 
     ProcessEventsWithContext();
@@ -145,22 +199,15 @@ DefaultSimulatorImpl::IsFinished() const
 void
 DefaultSimulatorImpl::ProcessEventsWithContext()
 {
-    if (m_eventsWithContextEmpty)
+    if (m_eventsWithContext.IsEmpty())
     {
         return;
     }
 
-    // swap queues
-    EventsWithContext eventsWithContext;
-    {
-        std::unique_lock lock{m_eventsWithContextMutex};
-        m_eventsWithContext.swap(eventsWithContext);
-        m_eventsWithContextEmpty = true;
-    }
-    while (!eventsWithContext.empty())
+    // take all the queued events at once, in the order they were pushed
+    m_eventsWithContext.PopAll(m_eventsWithContextReceived);
+    for (const auto& event : m_eventsWithContextReceived)
     {
-        EventWithContext event = eventsWithContext.front();
-        eventsWithContext.pop_front();
         Scheduler::Event ev;
         ev.impl = event.event;
         ev.key.m_ts = m_currentTs + event.timestamp;
@@ -169,7 +216,12 @@ DefaultSimulatorImpl::ProcessEventsWithContext()
         m_uid++;
         m_unscheduledEvents++;
         m_events->Insert(ev);
+        if (m_trace.IsOpen())
+        {
+            m_trace.Record(EventTraceRecord::INSERT, ev.key.m_uid, ev.key.m_ts);
+        }
     }
+    m_eventsWithContextReceived.clear();
 }
 
 void
@@ -226,6 +278,10 @@ DefaultSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
     m_uid++;
     m_unscheduledEvents++;
     m_events->Insert(ev);
+    if (m_trace.IsOpen())
+    {
+        m_trace.Record(EventTraceRecord::INSERT, ev.key.m_uid, ev.key.m_ts);
+    }
     return EventId(event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
 }
 
@@ -245,6 +301,10 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
         m_uid++;
         m_unscheduledEvents++;
         m_events->Insert(ev);
+        if (m_trace.IsOpen())
+        {
+            m_trace.Record(EventTraceRecord::INSERT, ev.key.m_uid, ev.key.m_ts);
+        }
     }
     else
     {
@@ -253,11 +313,7 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
         // Current time added in ProcessEventsWithContext()
         ev.timestamp = delay.GetTimeStep();
         ev.event = event;
-        {
-            std::unique_lock lock{m_eventsWithContextMutex};
-            m_eventsWithContext.push_back(ev);
-            m_eventsWithContextEmpty = false;
-        }
+        m_eventsWithContext.Push(ev);
     }
 }
 
@@ -328,6 +384,10 @@ DefaultSimulatorImpl::Remove(const EventId& id)
     event.key.m_context = id.GetContext();
     event.key.m_uid = id.GetUid();
     m_events->Remove(event);
+    if (m_trace.IsOpen())
+    {
+        m_trace.Record(EventTraceRecord::REMOVE, event.key.m_uid, event.key.m_ts);
+    }
     event.impl->Cancel();
     // whenever we remove an event from the event list, we have to unref it.
     event.impl->Unref();
@@ -341,6 +401,10 @@ DefaultSimulatorImpl::Cancel(const EventId& id)
     if (!IsExpired(id))
     {
         id.PeekEventImpl()->Cancel();
+        if (m_trace.IsOpen() && id.GetUid() != EventId::UID::DESTROY)
+        {
+            m_trace.Record(EventTraceRecord::CANCEL, id.GetUid(), id.GetTs());
+        }
     }
 }
 
@@ -9,11 +9,14 @@
 #ifndef DEFAULT_SIMULATOR_IMPL_H
 #define DEFAULT_SIMULATOR_IMPL_H
 
+#include "event-profiler.h"
+#include "event-trace.h"
+#include "mpsc-queue.h"
 #include "simulator-impl.h"
 
 #include <list>
-#include <mutex>
 #include <thread>
+#include <vector>
 
 /**
  * @file
@@ -70,6 +73,18 @@ class DefaultSimulatorImpl : public SimulatorImpl
   private:
     void DoDispose() override;
 
+    /**
+     * Record every event queue operation to a file.
+     * @param [in] filename The event trace file, empty to stop recording.
+     */
+    void SetTraceFile(std::string filename);
+    /**
+     * Profile the events, and write the report at Destroy().
+     * @param [in] filename The report file, "-" for the standard output,
+     *             empty to stop profiling.
+     */
+    void SetProfileFile(std::string filename);
+
     /** Process the next event. */
     void ProcessOneEvent();
     /** Move events from a different context into the main event queue. */
@@ -87,16 +102,14 @@ class DefaultSimulatorImpl : public SimulatorImpl
     };
 
     /** Container type for the events from a different context. */
-    typedef std::list<EventWithContext> EventsWithContext;
-    /** The container of events from a different context. */
-    EventsWithContext m_eventsWithContext;
+    typedef std::vector<EventWithContext> EventsWithContext;
     /**
-     * Flag \c true if all events with context have been moved to the
-     * primary event queue.
+     * The lock free queue of events from a different context, so that
+     * many threads can inject events without contending on a mutex.
      */
-    bool m_eventsWithContextEmpty;
-    /** Mutex to control access to the list of events with context. */
-    std::mutex m_eventsWithContextMutex;
+    MpscQueue<EventWithContext> m_eventsWithContext;
+    /** The events taken from the queue, kept to reuse the memory. */
+    EventsWithContext m_eventsWithContextReceived;
 
     /** Container type for the events to run at Simulator::Destroy() */
     typedef std::list<EventId> DestroyEvents;
@@ -125,6 +138,11 @@ class DefaultSimulatorImpl : public SimulatorImpl
 
     /** Main execution thread. */
     std::thread::id m_mainThreadId;
+
+    /** The event queue operations, when recording. */
+    EventTraceWriter m_trace;
+    /** The time spent per event type, when profiling. */
+    EventProfiler m_profiler;
 };
 
 } // namespace ns3
@@ -10,6 +10,8 @@
 
 #include "log.h"
 
+#include <new>
+
 /**
  * @file
  * @ingroup events
@@ -21,6 +23,114 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("EventImpl");
 
+namespace
+{
+
+/**
+ * @ingroup events
+ * Per-thread free lists of event storage, one per size class.
+ *
+ * Blocks are always allocated with the rounded size of their class, so a
+ * block freed by another thread than the one which allocated it (as with
+ * Simulator::ScheduleWithContext()) simply moves to the free list of the
+ * releasing thread.
+ *
+ * The pool is trivially destructible on purpose: events may still be
+ * released during static destruction, after thread-local objects with a
+ * destructor are gone. The cached blocks of an exiting thread are leaked,
+ * which is bounded by the per-class limit.
+ */
+struct EventImplPool
+{
+    /** Size class granularity, in bytes. */
+    static constexpr std::size_t GRANULARITY = 16;
+    /** Number of size classes, the largest pooled event is 256 bytes. */
+    static constexpr std::size_t N_CLASSES = 16;
+    /** Maximum number of cached blocks per size class. */
+    static constexpr uint32_t MAX_FREE = 4096;
+
+    /** A cached block, linked through its own storage. */
+    struct FreeBlock
+    {
+        FreeBlock* next; //!< Next cached block.
+    };
+
+    FreeBlock* m_free[N_CLASSES]; //!< Free list heads.
+    uint32_t m_count[N_CLASSES];  //!< Free list lengths.
+};
+
+/** The pool of the current thread, zero-initialized. */
+thread_local EventImplPool g_eventPool;
+
+/** Whether event storage is recycled. */
+bool g_eventPooling = true;
+
+/**
+ * Get the size class of an allocation.
+ * @param [in] size The allocation size.
+ * @returns The size class index, N_CLASSES or more if not pooled.
+ */
+inline std::size_t
+EventSizeClass(std::size_t size)
+{
+    return (size - 1) / EventImplPool::GRANULARITY;
+}
+
+} // unnamed namespace
+
+void*
+EventImpl::operator new(std::size_t size)
+{
+    std::size_t sizeClass = EventSizeClass(size);
+    if (sizeClass >= EventImplPool::N_CLASSES)
+    {
+        return ::operator new(size);
+    }
+    EventImplPool& pool = g_eventPool;
+    EventImplPool::FreeBlock* block = pool.m_free[sizeClass];
+    if (g_eventPooling && block != nullptr)
+    {
+        pool.m_free[sizeClass] = block->next;
+        pool.m_count[sizeClass]--;
+        return block;
+    }
+    return ::operator new((sizeClass + 1) * EventImplPool::GRANULARITY);
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size)
+{
+    std::size_t sizeClass = EventSizeClass(size);
+    if (sizeClass >= EventImplPool::N_CLASSES)
+    {
+        ::operator delete(p);
+        return;
+    }
+    EventImplPool& pool = g_eventPool;
+    if (!g_eventPooling || pool.m_count[sizeClass] >= EventImplPool::MAX_FREE)
+    {
+        ::operator delete(p);
+        return;
+    }
+    auto block = static_cast<EventImplPool::FreeBlock*>(p);
+    block->next = pool.m_free[sizeClass];
+    pool.m_free[sizeClass] = block;
+    pool.m_count[sizeClass]++;
+}
+
+void
+EventImpl::SetPoolingEnabled(bool enable)
+{
+    NS_LOG_FUNCTION(enable);
+    g_eventPooling = enable;
+}
+
+bool
+EventImpl::IsPoolingEnabled()
+{
+    return g_eventPooling;
+}
+
 EventImpl::~EventImpl()
 {
     NS_LOG_FUNCTION(this);
@@ -56,4 +166,10 @@ EventImpl::IsCancelled()
     return m_cancel;
 }
 
+std::string_view
+EventImpl::GetCallback() const
+{
+    return {};
+}
+
 } // namespace ns3
@@ -10,7 +10,9 @@
 
 #include "simple-ref-count.h"
 
+#include <cstddef>
 #include <stdint.h>
+#include <string_view>
 
 /**
  * @file
@@ -55,6 +57,48 @@ class EventImpl : public SimpleRefCount<EventImpl>
      * Checked by the simulation engine before calling Invoke().
      */
     bool IsCancelled();
+    /**
+     * Get the function or method called by the event, for EventProfiler.
+     *
+     * @returns The bytes of the function or member function pointer,
+     *          empty if the event does not keep one.
+     */
+    virtual std::string_view GetCallback() const;
+
+    /**
+     * Allocate storage for an event from the size-class pools.
+     *
+     * Events are allocated for every Simulator::Schedule() and freed
+     * right after they run, so the storage is recycled through
+     * thread-local free lists, one per 16 byte size class.
+     * Larger events fall through to the global operator new.
+     *
+     * @param [in] size The size of the event object.
+     * @returns The storage for the event.
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Return the storage of an event to the pool of the calling thread.
+     *
+     * @param [in] p The storage to release.
+     * @param [in] size The size of the event object.
+     */
+    static void operator delete(void* p, std::size_t size);
+
+    /**
+     * Enable or disable the event pools.
+     *
+     * Pooling is enabled by default. Disabling it makes every event
+     * go to the global allocator, which is mostly useful to benchmark
+     * the pools. It can be toggled at any time.
+     *
+     * @param [in] enable Whether to recycle event storage.
+     */
+    static void SetPoolingEnabled(bool enable);
+    /**
+     * @returns true if event storage is recycled through the pools.
+     */
+    static bool IsPoolingEnabled();
 
   protected:
     /**
@@ -0,0 +1,217 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "event-profiler.h"
+
+#include "demangle.h"
+#include "event-impl.h"
+#include "fatal-error.h"
+#include "log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#ifndef __WIN32__
+#include <dlfcn.h>
+#endif
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EventProfiler");
+
+EventProfiler::EventProfiler()
+    : m_enabled(false)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+EventProfiler::Enable(const std::string& filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    m_filename = filename;
+    m_entries.clear();
+    m_enableTime = std::chrono::steady_clock::now();
+    m_enabled = true;
+}
+
+void
+EventProfiler::Disable()
+{
+    NS_LOG_FUNCTION(this);
+    m_enabled = false;
+}
+
+void
+EventProfiler::Stop(const EventImpl& event)
+{
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now() - m_start)
+                  .count();
+    Key key{std::type_index(typeid(event)), {0, 0}, 0};
+    std::string_view callback = event.GetCallback();
+    key.size = std::min(callback.size(), sizeof(key.callback));
+    std::memcpy(key.callback, callback.data(), key.size);
+    Entry& entry = m_entries[key];
+    entry.count++;
+    entry.totalNs += ns;
+    entry.maxNs = std::max<uint64_t>(entry.maxNs, ns);
+}
+
+void
+EventProfiler::Report()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_enabled)
+    {
+        return;
+    }
+    m_enabled = false;
+    if (m_filename == "-")
+    {
+        Report(std::cout);
+        return;
+    }
+    std::ofstream file(m_filename, std::ios::out | std::ios::trunc);
+    if (!file.is_open())
+    {
+        NS_FATAL_ERROR("Can not open event profile file " << m_filename);
+    }
+    Report(file);
+}
+
+void
+EventProfiler::Report(std::ostream& os) const
+{
+    // The events of a method bound to objects of different classes have
+    // different types, a line per name sums them
+    std::unordered_map<std::string, Entry> byName;
+    for (const auto& [key, entry] : m_entries)
+    {
+        std::string name = GetEventName(key.type);
+        std::string callback =
+            GetCallbackName({reinterpret_cast<const char*>(key.callback), key.size});
+        if (!callback.empty())
+        {
+            name += " " + callback;
+        }
+        Entry& sum = byName[name];
+        sum.count += entry.count;
+        sum.totalNs += entry.totalNs;
+        sum.maxNs = std::max(sum.maxNs, entry.maxNs);
+    }
+    std::vector<std::pair<std::string, Entry>> entries(byName.begin(), byName.end());
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        return a.second.totalNs > b.second.totalNs;
+    });
+    uint64_t totalNs = 0;
+    uint64_t count = 0;
+    for (const auto& [name, entry] : entries)
+    {
+        totalNs += entry.totalNs;
+        count += entry.count;
+    }
+    auto wallNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - m_enableTime)
+                      .count();
+
+    std::ios::fmtflags flags = os.flags();
+    os << "Event profile: " << count << " events, " << totalNs / 1000000 << " ms in events, "
+       << wallNs / 1000000 << " ms wall clock" << std::endl;
+    os << std::right << std::setw(10) << "total(ms)" << std::setw(8) << "%" << std::setw(12)
+       << "count" << std::setw(10) << "mean(ns)" << std::setw(12) << "max(ns)"
+       << "  event" << std::endl;
+    for (const auto& [name, entry] : entries)
+    {
+        os << std::fixed << std::setprecision(3) << std::setw(10) << entry.totalNs / 1e6
+           << std::setprecision(1) << std::setw(8)
+           << (totalNs > 0 ? 100.0 * entry.totalNs / totalNs : 0.0)
+           << std::setw(12) << entry.count << std::setw(10) << entry.totalNs / entry.count
+           << std::setw(12) << entry.maxNs << "  " << name << std::endl;
+    }
+    os.flags(flags);
+}
+
+std::string
+EventProfiler::GetEventName(const std::type_index& type)
+{
+    std::string name = Demangle(type.name());
+    // The events of MakeEvent() are local classes of the function
+    // template, named after it: keep its first parameter, the callback
+    const std::string prefix = "ns3::MakeEvent<";
+    if (name.compare(0, prefix.size(), prefix) != 0)
+    {
+        return name;
+    }
+    int depth = 0;
+    std::size_t first = std::string::npos;
+    for (std::size_t i = prefix.size() - 1; i < name.size(); i++)
+    {
+        char c = name[i];
+        if (c == '<' || c == '(')
+        {
+            if (depth == 0 && c == '(')
+            {
+                first = i + 1;
+            }
+            depth++;
+        }
+        else if (c == '>' || c == ')')
+        {
+            depth--;
+            if (depth == 0 && first != std::string::npos)
+            {
+                return name.substr(first, i - first);
+            }
+        }
+        else if (c == ',' && depth == 1 && first != std::string::npos)
+        {
+            return name.substr(first, i - first);
+        }
+    }
+    return name;
+}
+
+std::string
+EventProfiler::GetCallbackName(std::string_view callback)
+{
+    uintptr_t code[2] = {0, 0};
+    std::memcpy(code, callback.data(), std::min(callback.size(), sizeof(code)));
+    if (code[0] == 0)
+    {
+        return "";
+    }
+    // A member function pointer is the address of the function and the
+    // adjustment of the object, or one plus the offset of the method in
+    // the virtual table if it is virtual (Itanium C++ ABI)
+    std::ostringstream oss;
+    if (callback.size() == 2 * sizeof(uintptr_t) && (code[0] & 1))
+    {
+        oss << "virtual at vtable offset " << code[0] - 1;
+        return oss.str();
+    }
+#ifndef __WIN32__
+    Dl_info info;
+    if (dladdr(reinterpret_cast<void*>(code[0]), &info) && info.dli_sname != nullptr)
+    {
+        return Demangle(info.dli_sname);
+    }
+#endif
+    oss << "at 0x" << std::hex << code[0];
+    return oss.str();
+}
+
+} // namespace ns3
@@ -0,0 +1,150 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include <chrono>
+#include <ostream>
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <unordered_map>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * @ingroup simulator
+ * @brief Wall clock time and count of the events run, per callback.
+ *
+ * The events are keyed by the dynamic type of their EventImpl, the class
+ * made by MakeEvent() for each callback signature, and by the function or
+ * method they call (see EventImpl::GetCallback()), so that two methods of
+ * a class with the same signature get a line each.  The report names the
+ * callback from the symbols of the binaries, the executables need to
+ * export theirs (ENABLE_EXPORTS in CMake); a virtual method is named by
+ * its slot in the virtual table.  The lambdas have a type each.
+ *
+ * The simulator calls Start() and Stop() around each event, only when
+ * the profiler is enabled, so that it costs a single test otherwise.
+ */
+class EventProfiler
+{
+  public:
+    /** Constructor, disabled. */
+    EventProfiler();
+
+    /**
+     * Start profiling, and forget the previous profile.
+     * @param [in] filename The report file, "-" for the standard output.
+     */
+    void Enable(const std::string& filename);
+    /** Stop profiling, without writing the report. */
+    void Disable();
+    /**
+     * @returns true if the events are profiled.
+     */
+    inline bool IsEnabled() const
+    {
+        return m_enabled;
+    }
+
+    /** Called before running an event. */
+    inline void Start()
+    {
+        m_start = std::chrono::steady_clock::now();
+    }
+
+    /**
+     * Called after running an event.
+     * @param [in] event The event which ran.
+     */
+    void Stop(const EventImpl& event);
+
+    /**
+     * Write the report to the file given to Enable(), then disable.
+     */
+    void Report();
+    /**
+     * Write the report, the callbacks sorted by decreasing total time.
+     * @param [in,out] os The output stream.
+     */
+    void Report(std::ostream& os) const;
+
+    /**
+     * Get a readable name for an event type: the callback signature
+     * for the events made by MakeEvent().
+     * @param [in] type The dynamic type of the EventImpl.
+     * @returns The name of the event type.
+     */
+    static std::string GetEventName(const std::type_index& type);
+
+    /**
+     * Get a readable name for the callback of an event, see EventImpl::GetCallback().
+     * @param [in] callback The bytes of the function or member function pointer.
+     * @returns The name of the function, empty if there is no callback.
+     */
+    static std::string GetCallbackName(std::string_view callback);
+
+  private:
+    /** The profile key of an event: its type and the pointer to its callback. */
+    struct Key
+    {
+        std::type_index type; //!< The dynamic type of the EventImpl.
+        uintptr_t callback[2]; //!< The callback pointer, zero padded.
+        uint8_t size;          //!< The size of the callback pointer, 0 for none.
+
+        /**
+         * @param [in] other The other key.
+         * @returns true if both keys are the same.
+         */
+        bool operator==(const Key& other) const
+        {
+            return type == other.type && callback[0] == other.callback[0] &&
+                   callback[1] == other.callback[1] && size == other.size;
+        }
+    };
+
+    /** Hash of a Key. */
+    struct KeyHash
+    {
+        /**
+         * @param [in] key The key.
+         * @returns The hash of the key.
+         */
+        std::size_t operator()(const Key& key) const
+        {
+            return std::hash<std::type_index>()(key.type) ^ (key.callback[0] * 31) ^
+                   key.callback[1];
+        }
+    };
+
+    /** The profile of an event type. */
+    struct Entry
+    {
+        uint64_t count{0};   //!< Number of events run.
+        uint64_t totalNs{0}; //!< Total wall clock time, in ns.
+        uint64_t maxNs{0};   //!< Longest event, in ns.
+    };
+
+    bool m_enabled;                                       //!< Whether events are profiled.
+    std::string m_filename;                               //!< The report file.
+    std::chrono::steady_clock::time_point m_start;        //!< Start of the current event.
+    std::chrono::steady_clock::time_point m_enableTime;   //!< When profiling started.
+    std::unordered_map<Key, Entry, KeyHash> m_entries;    //!< The profile per callback.
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
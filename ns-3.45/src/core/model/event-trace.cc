@@ -0,0 +1,94 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "event-trace.h"
+
+#include "fatal-error.h"
+#include "log.h"
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::EventTraceWriter and ns3::EventTraceReader implementations.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EventTrace");
+
+EventTraceWriter::EventTraceWriter()
+    : m_open(false),
+      m_used(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+EventTraceWriter::~EventTraceWriter()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+void
+EventTraceWriter::Open(const std::string& filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    Close();
+    m_file.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open())
+    {
+        NS_FATAL_ERROR("Can not open event trace file " << filename);
+    }
+    m_file.write(MAGIC, sizeof(MAGIC) - 1);
+    m_used = 0;
+    m_open = true;
+}
+
+void
+EventTraceWriter::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_open)
+    {
+        return;
+    }
+    Flush();
+    m_file.close();
+    m_open = false;
+}
+
+void
+EventTraceWriter::Flush()
+{
+    m_file.write(m_buffer, m_used);
+    m_used = 0;
+}
+
+bool
+EventTraceReader::Read(const std::string& filename, std::vector<EventTraceRecord>& records)
+{
+    NS_LOG_FUNCTION(filename);
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    char magic[sizeof(EventTraceWriter::MAGIC) - 1];
+    if (!file.read(magic, sizeof(magic)) ||
+        std::memcmp(magic, EventTraceWriter::MAGIC, sizeof(magic)) != 0)
+    {
+        NS_LOG_ERROR("Not an event trace: " << filename);
+        return false;
+    }
+
+    char raw[EventTraceWriter::RECORD_SIZE];
+    while (file.read(raw, sizeof(raw)))
+    {
+        EventTraceRecord record;
+        record.op = static_cast<EventTraceRecord::Op>(raw[0]);
+        std::memcpy(&record.uid, raw + 1, sizeof(record.uid));
+        std::memcpy(&record.ts, raw + 1 + sizeof(record.uid), sizeof(record.ts));
+        records.push_back(record);
+    }
+    return true;
+}
+
+} // namespace ns3
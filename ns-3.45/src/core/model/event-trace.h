@@ -0,0 +1,133 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef EVENT_TRACE_H
+#define EVENT_TRACE_H
+
+#include <cstring>
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::EventTraceWriter and ns3::EventTraceReader declarations.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup simulator
+ * @brief One operation on the event queue, as stored in an event trace.
+ *
+ * An event trace is the sequence of operations the simulator performed
+ * on its Scheduler, so that the exact same sequence can be replayed
+ * against other schedulers, see `utils/bench-scheduler.cc`.
+ *
+ * The file starts with an 8 byte magic string, followed by the records
+ * in host byte order, each 13 bytes long: the operation, the event
+ * unique id and the event time stamp.
+ */
+struct EventTraceRecord
+{
+    /** The event queue operations. */
+    enum Op : uint8_t
+    {
+        INSERT = 0,      //!< Scheduler::Insert()
+        REMOVE_NEXT = 1, //!< Scheduler::RemoveNext(), the event is run
+        REMOVE = 2,      //!< Scheduler::Remove(), from Simulator::Remove()
+        CANCEL = 3,      //!< Simulator::Cancel(), the event stays in the queue
+    };
+
+    Op op;       //!< The operation.
+    uint32_t uid; //!< The event unique id.
+    uint64_t ts;  //!< The event time stamp, in time steps.
+};
+
+/**
+ * @ingroup simulator
+ * @brief Buffered writer of an event trace.
+ */
+class EventTraceWriter
+{
+  public:
+    /** Constructor. */
+    EventTraceWriter();
+    /** Destructor, flushes and closes the file. */
+    ~EventTraceWriter();
+
+    /**
+     * Start a new trace.
+     * @param [in] filename The trace file, truncated if it exists.
+     */
+    void Open(const std::string& filename);
+    /** Flush the pending records and close the file. */
+    void Close();
+    /**
+     * @returns true if records are being written.
+     */
+    inline bool IsOpen() const
+    {
+        return m_open;
+    }
+
+    /**
+     * Append a record.
+     * @param [in] op The operation.
+     * @param [in] uid The event unique id.
+     * @param [in] ts The event time stamp.
+     */
+    inline void Record(EventTraceRecord::Op op, uint32_t uid, uint64_t ts)
+    {
+        char* p = m_buffer + m_used;
+        *p = op;
+        std::memcpy(p + 1, &uid, sizeof(uid));
+        std::memcpy(p + 1 + sizeof(uid), &ts, sizeof(ts));
+        m_used += RECORD_SIZE;
+        if (m_used + RECORD_SIZE > BUFFER_SIZE)
+        {
+            Flush();
+        }
+    }
+
+    /** Size of a record in the file. */
+    static constexpr uint32_t RECORD_SIZE = 13;
+    /** The magic string at the start of the file. */
+    static constexpr char MAGIC[9] = "NS3EVTR1";
+
+  private:
+    /** Write the buffered records to the file. */
+    void Flush();
+
+    /** Size of the record buffer, a multiple of RECORD_SIZE. */
+    static constexpr uint32_t BUFFER_SIZE = RECORD_SIZE * 4096;
+
+    std::ofstream m_file;        //!< The trace file.
+    bool m_open;                 //!< Whether a trace is open.
+    char m_buffer[BUFFER_SIZE];  //!< Records not written yet.
+    uint32_t m_used;             //!< Bytes used in the buffer.
+};
+
+/**
+ * @ingroup simulator
+ * @brief Reader of an event trace written by EventTraceWriter.
+ */
+class EventTraceReader
+{
+  public:
+    /**
+     * Read a whole trace in memory.
+     * @param [in] filename The trace file.
+     * @param [out] records The records, in order.
+     * @returns false if the file can not be read or is not an event trace.
+     */
+    static bool Read(const std::string& filename, std::vector<EventTraceRecord>& records);
+};
+
+} // namespace ns3
+
+#endif /* EVENT_TRACE_H */
@@ -11,8 +11,10 @@
 #include "warnings.h"
 
 #include <functional>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 /**
  * @file
@@ -138,7 +140,9 @@ MakeEvent(MEM mem_ptr, OBJ obj, Ts... args)
         EventMemberImpl() = delete;
 
         EventMemberImpl(OBJ obj, MEM function, Ts... args)
-            : m_function(std::bind(function, obj, args...))
+            : m_function(function),
+              m_obj(obj),
+              m_arguments(args...)
         {
         }
 
@@ -150,10 +154,20 @@ MakeEvent(MEM mem_ptr, OBJ obj, Ts... args)
       private:
         void Notify() override
         {
-            m_function();
+            std::apply([this](auto&... args) { std::invoke(m_function, m_obj, args...); },
+                       m_arguments);
+        }
+
+        std::string_view GetCallback() const override
+        {
+            return {reinterpret_cast<const char*>(&m_function), sizeof(m_function)};
         }
 
-        std::function<void()> m_function;
+        // Keep the call inline, so the whole closure lives in the
+        // (pooled) event storage without a second allocation.
+        MEM m_function;
+        OBJ m_obj;
+        std::tuple<std::remove_reference_t<Ts>...> m_arguments;
     }* ev = new EventMemberImpl(obj, mem_ptr, args...);
 
     return ev;
@@ -183,6 +197,11 @@ MakeEvent(void (*f)(Us...), Ts... args)
             std::apply([this](Ts... args) { (*m_function)(args...); }, m_arguments);
         }
 
+        std::string_view GetCallback() const override
+        {
+            return {reinterpret_cast<const char*>(&m_function), sizeof(m_function)};
+        }
+
         void (*m_function)(Us...);
         std::tuple<std::remove_reference_t<Ts>...> m_arguments;
     }* ev = new EventFunctionImpl(f, args...);
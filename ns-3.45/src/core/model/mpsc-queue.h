@@ -0,0 +1,122 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::MpscQueue declaration and template implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup simulator
+ * @brief A lock free multiple producer, single consumer queue.
+ *
+ * Any thread may Push() items, a single thread takes them all at once,
+ * in the order they were pushed, with PopAll().  Producers link their
+ * item at the head of a list with a compare and swap; the consumer
+ * detaches the whole list with an exchange and reverses it, so neither
+ * side ever waits for the other.
+ *
+ * This is the queue of the events scheduled from other threads in
+ * ns3::DefaultSimulatorImpl, and the inbound queue of the events sent
+ * to a logical process of ns3::MultithreadedSimulatorImpl.
+ *
+ * @tparam T \explicit The type of the items, copied in the queue.
+ */
+template <typename T>
+class MpscQueue
+{
+  public:
+    /** Constructor. */
+    MpscQueue()
+        : m_head(nullptr)
+    {
+    }
+
+    /** Destructor, drops the items left. */
+    ~MpscQueue()
+    {
+        Node* node = m_head.load(std::memory_order_acquire);
+        while (node != nullptr)
+        {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * Append an item, from any thread.
+     * @param [in] item The item.
+     */
+    void Push(const T& item)
+    {
+        Node* node = new Node{item, m_head.load(std::memory_order_relaxed)};
+        while (!m_head.compare_exchange_weak(node->next,
+                                             node,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed))
+        {
+        }
+    }
+
+    /**
+     * @returns true if no item is waiting.
+     */
+    bool IsEmpty() const
+    {
+        return m_head.load(std::memory_order_acquire) == nullptr;
+    }
+
+    /**
+     * Take all the items, from the consumer thread only.
+     * @param [out] items The items are appended, in push order.
+     */
+    void PopAll(std::vector<T>& items)
+    {
+        Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+        Node* fifo = nullptr;
+        while (node != nullptr)
+        {
+            Node* next = node->next;
+            node->next = fifo;
+            fifo = node;
+            node = next;
+        }
+        while (fifo != nullptr)
+        {
+            Node* next = fifo->next;
+            items.push_back(fifo->item);
+            delete fifo;
+            fifo = next;
+        }
+    }
+
+  private:
+    /** A queued item. */
+    struct Node
+    {
+        T item;     //!< The item.
+        Node* next; //!< The item pushed before this one.
+    };
+
+    std::atomic<Node*> m_head; //!< The item pushed last.
+};
+
+} // namespace ns3
+
+#endif /* MPSC_QUEUE_H */
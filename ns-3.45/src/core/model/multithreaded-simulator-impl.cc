@@ -0,0 +1,777 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+#include "scheduler.h"
+#include "simulator.h"
+#include "uinteger.h"
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+thread_local MultithreadedSimulatorImpl::LogicalProcess* MultithreadedSimulatorImpl::g_currentLp =
+    nullptr;
+
+namespace
+{
+
+/** Time stamp of an empty event list. */
+constexpr uint64_t NO_EVENT = std::numeric_limits<uint64_t>::max();
+
+/**
+ * Wait a little while polling another thread: spin first, then give
+ * the core away, which matters when there are more threads than cores.
+ * @param [in,out] spins The number of polls so far.
+ */
+void
+Pause(uint32_t& spins)
+{
+    if (++spins > 64)
+    {
+        std::this_thread::yield();
+    }
+}
+
+} // unnamed namespace
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MultithreadedSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<MultithreadedSimulatorImpl>()
+            .AddAttribute("Lookahead",
+                          "Smallest delay of an event for another partition, "
+                          "which is also the length of the time windows",
+                          TimeValue(MicroSeconds(1)),
+                          MakeTimeAccessor(&MultithreadedSimulatorImpl::SetLookahead),
+                          MakeTimeChecker(TimeStep(1)))
+            .AddAttribute("MaxThreads",
+                          "Maximum number of threads, 0 for one per core",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&MultithreadedSimulatorImpl::m_maxThreads),
+                          MakeUintegerChecker<uint32_t>());
+    return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+    m_partitioned = false;
+    m_stop = false;
+    m_lookahead = 1;
+    m_maxThreads = 0;
+    m_windowEnd = 0;
+    m_inbox = 0;
+    m_parallel = false;
+    m_window = 0;
+    m_busyThreads = 0;
+    m_quit = false;
+    m_mainThreadId = std::this_thread::get_id();
+    // The public LP
+    CreateLp();
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& lp : m_lps)
+    {
+        for (auto& inbox : lp->inbox)
+        {
+            inbox.PopAll(lp->received);
+        }
+        for (auto& ev : lp->received)
+        {
+            ev.event->Unref();
+        }
+        lp->received.clear();
+        while (lp->events && !lp->events->IsEmpty())
+        {
+            Scheduler::Event next = lp->events->RemoveNext();
+            next.impl->Unref();
+        }
+        lp->events = nullptr;
+    }
+    SimulatorImpl::DoDispose();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_destroyEvents.empty())
+    {
+        Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
+        m_destroyEvents.pop_front();
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::CreateLp()
+{
+    NS_LOG_FUNCTION(this);
+    auto lp = std::make_unique<LogicalProcess>();
+    lp->index = m_lps.size();
+    if (m_schedulerFactory.IsTypeIdSet())
+    {
+        lp->events = m_schedulerFactory.Create<Scheduler>();
+    }
+    for (auto& ts : lp->inboxTs)
+    {
+        ts = NO_EVENT;
+    }
+    lp->uid = EventId::UID::VALID;
+    lp->currentUid = EventId::UID::INVALID;
+    lp->currentTs = m_lps.empty() ? 0 : m_lps[0]->currentTs;
+    lp->currentContext = Simulator::NO_CONTEXT;
+    m_lps.push_back(std::move(lp));
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    m_schedulerFactory = schedulerFactory;
+    for (auto& lp : m_lps)
+    {
+        Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler>();
+        if (lp->events)
+        {
+            while (!lp->events->IsEmpty())
+            {
+                Scheduler::Event next = lp->events->RemoveNext();
+                scheduler->Insert(next);
+            }
+        }
+        lp->events = scheduler;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetLookahead(Time lookahead)
+{
+    NS_LOG_FUNCTION(this << lookahead);
+    m_lookahead = std::max<int64_t>(lookahead.GetTimeStep(), 1);
+}
+
+void
+MultithreadedSimulatorImpl::SetPartition(uint32_t context, uint32_t partition)
+{
+    NS_LOG_FUNCTION(this << context << partition);
+    NS_ASSERT_MSG(!m_partitioned, "The partitions must be set before Simulator::Run()");
+    NS_ASSERT(context != Simulator::NO_CONTEXT);
+    while (m_lps.size() < partition + 2)
+    {
+        CreateLp();
+    }
+    if (context >= m_lpOfContext.size())
+    {
+        m_lpOfContext.resize(context + 1, 0);
+    }
+    m_lpOfContext[context] = partition + 1;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartitionCount() const
+{
+    return m_lps.size() - 1;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartition(uint32_t context) const
+{
+    if (context >= m_lpOfContext.size() || m_lpOfContext[context] == 0)
+    {
+        return UINT32_MAX;
+    }
+    return m_lpOfContext[context] - 1;
+}
+
+// There is a single address space
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId() const
+{
+    return 0;
+}
+
+MultithreadedSimulatorImpl::LogicalProcess&
+MultithreadedSimulatorImpl::CurrentLp() const
+{
+    return g_currentLp != nullptr ? *g_currentLp : *m_lps[0];
+}
+
+MultithreadedSimulatorImpl::LogicalProcess&
+MultithreadedSimulatorImpl::LpOf(uint32_t context) const
+{
+    if (!m_partitioned || context >= m_lpOfContext.size())
+    {
+        return *m_lps[0];
+    }
+    return *m_lps[m_lpOfContext[context]];
+}
+
+uint64_t
+MultithreadedSimulatorImpl::NextTs(const LogicalProcess& lp) const
+{
+    uint64_t next = lp.inboxTs[1 - m_inbox].load(std::memory_order_relaxed);
+    if (!lp.events->IsEmpty())
+    {
+        next = std::min(next, lp.events->PeekNext().key.m_ts);
+    }
+    return next;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::Insert(LogicalProcess& lp,
+                                   uint64_t ts,
+                                   uint32_t context,
+                                   EventImpl* event)
+{
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = ts;
+    ev.key.m_context = context;
+    ev.key.m_uid = lp.uid;
+    lp.uid++;
+    lp.unscheduledEvents++;
+    lp.events->Insert(ev);
+    return ev.key.m_uid;
+}
+
+void
+MultithreadedSimulatorImpl::ReceiveEvents(LogicalProcess& lp)
+{
+    uint32_t inbox = 1 - m_inbox;
+    if (lp.inboxTs[inbox].load(std::memory_order_relaxed) == NO_EVENT)
+    {
+        return;
+    }
+    lp.inboxTs[inbox].store(NO_EVENT, std::memory_order_relaxed);
+    lp.inbox[inbox].PopAll(lp.received);
+
+    // The order of arrival depends on the threads, the uids must not
+    std::sort(lp.received.begin(),
+              lp.received.end(),
+              [](const RemoteEvent& a, const RemoteEvent& b) {
+                  return std::tie(a.ts, a.source, a.sequence) <
+                         std::tie(b.ts, b.source, b.sequence);
+              });
+    for (auto& ev : lp.received)
+    {
+        Insert(lp, ev.ts, ev.context, ev.event);
+    }
+    lp.received.clear();
+}
+
+void
+MultithreadedSimulatorImpl::ProcessOneEvent(LogicalProcess& lp)
+{
+    Scheduler::Event next = lp.events->RemoveNext();
+
+    PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
+
+    NS_ASSERT(next.key.m_ts >= lp.currentTs);
+    lp.unscheduledEvents--;
+    lp.eventCount++;
+
+    NS_LOG_LOGIC("handle " << next.key.m_ts);
+    lp.currentTs = next.key.m_ts;
+    lp.currentContext = next.key.m_context;
+    lp.currentUid = next.key.m_uid;
+    next.impl->Invoke();
+    next.impl->Unref();
+}
+
+void
+MultithreadedSimulatorImpl::ProcessWindow(LogicalProcess& lp)
+{
+    LogicalProcess* previous = g_currentLp;
+    g_currentLp = &lp;
+    ReceiveEvents(lp);
+
+    uint64_t eventCount = lp.eventCount;
+    while (!lp.events->IsEmpty() && lp.events->PeekNext().key.m_ts < m_windowEnd &&
+           !m_stop.load(std::memory_order_relaxed))
+    {
+        ProcessOneEvent(lp);
+    }
+    lp.lastWindowEvents = lp.eventCount - eventCount;
+    g_currentLp = previous;
+}
+
+bool
+MultithreadedSimulatorImpl::TakeWork(uint32_t thread, bool steal, uint32_t& index)
+{
+    std::atomic<uint64_t>& range = m_workQueues[thread].range;
+    uint64_t current = range.load(std::memory_order_relaxed);
+    while (true)
+    {
+        uint64_t first = current >> 32;
+        uint64_t end = current & 0xffffffff;
+        if (first >= end)
+        {
+            return false;
+        }
+        uint64_t next = steal ? (first << 32 | (end - 1)) : ((first + 1) << 32 | end);
+        if (range.compare_exchange_weak(current,
+                                        next,
+                                        std::memory_order_acq_rel,
+                                        std::memory_order_relaxed))
+        {
+            index = steal ? end - 1 : first;
+            return true;
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::RunWindow(uint32_t thread)
+{
+    uint32_t index;
+    while (TakeWork(thread, false, index))
+    {
+        ProcessWindow(*m_ready[index]);
+    }
+    // Nothing is added to the work queues during a window, so
+    // this thread is done once the others have no LP left either
+    uint32_t threads = m_threads.size() + 1;
+    for (uint32_t i = 1; i < threads; i++)
+    {
+        uint32_t victim = (thread + i) % threads;
+        while (TakeWork(victim, true, index))
+        {
+            ProcessWindow(*m_ready[index]);
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Worker(uint32_t thread, uint64_t window)
+{
+    while (true)
+    {
+        uint32_t spins = 0;
+        uint64_t current;
+        while ((current = m_window.load(std::memory_order_acquire)) == window)
+        {
+            if (spins > 4096)
+            {
+                // A long serial phase, sleep until the next window
+                m_window.wait(window, std::memory_order_acquire);
+            }
+            Pause(spins);
+        }
+        window = current;
+        if (m_quit)
+        {
+            return;
+        }
+        RunWindow(thread);
+        m_busyThreads.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Partition()
+{
+    if (m_partitioned)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+    m_partitioned = true;
+
+    LogicalProcess& pub = *m_lps[0];
+    for (auto& lp : m_lps)
+    {
+        lp->uid = pub.uid;
+    }
+    std::vector<Scheduler::Event> events;
+    while (!pub.events->IsEmpty())
+    {
+        events.push_back(pub.events->RemoveNext());
+    }
+    for (auto& ev : events)
+    {
+        LogicalProcess& lp = LpOf(ev.key.m_context);
+        lp.events->Insert(ev);
+        pub.unscheduledEvents--;
+        lp.unscheduledEvents++;
+    }
+    NS_LOG_INFO(m_lps.size() - 1 << " partitions, " << events.size() << " events");
+}
+
+void
+MultithreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    // Set the current threadId as the main threadId
+    m_mainThreadId = std::this_thread::get_id();
+    Partition();
+    m_stop = false;
+
+    uint32_t threads = m_maxThreads != 0 ? m_maxThreads : std::thread::hardware_concurrency();
+    threads = std::clamp<uint32_t>(threads, 1, std::max<uint32_t>(m_lps.size() - 1, 1));
+#ifndef NS3_MTP
+    if (threads > 1)
+    {
+        NS_LOG_WARN("ns-3 is not configured with NS3_MTP, "
+                    "the partitions run on the main thread only");
+        threads = 1;
+    }
+#endif
+    NS_LOG_INFO("Running " << m_lps.size() - 1 << " partitions on " << threads << " threads");
+    m_workQueues = std::make_unique<WorkQueue[]>(threads);
+    m_quit = false;
+    for (uint32_t i = 1; i < threads; i++)
+    {
+        m_threads.emplace_back(&MultithreadedSimulatorImpl::Worker, this, i, m_window.load());
+    }
+
+    LogicalProcess& pub = *m_lps[0];
+    std::vector<std::vector<LogicalProcess*>> dealt(threads);
+    while (!m_stop)
+    {
+        ReceiveEvents(pub);
+        uint64_t next = NO_EVENT;
+        for (uint32_t i = 1; i < m_lps.size(); i++)
+        {
+            next = std::min(next, NextTs(*m_lps[i]));
+        }
+        uint64_t publicNext = NextTs(pub);
+        if (next == NO_EVENT && publicNext == NO_EVENT)
+        {
+            break;
+        }
+
+        if (publicNext <= next)
+        {
+            // The public events may touch any LP, they run alone
+            while (!pub.events->IsEmpty() && pub.events->PeekNext().key.m_ts == publicNext &&
+                   !m_stop)
+            {
+                ProcessOneEvent(pub);
+            }
+            continue;
+        }
+
+        m_windowEnd = next > NO_EVENT - m_lookahead ? NO_EVENT : next + m_lookahead;
+        m_windowEnd = std::min(m_windowEnd, publicNext);
+
+        // Deal the LPs with events in the window, or events to take in,
+        // to the threads, the busiest first
+        m_ready.clear();
+        for (uint32_t i = 1; i < m_lps.size(); i++)
+        {
+            LogicalProcess* lp = m_lps[i].get();
+            if (NextTs(*lp) < m_windowEnd || lp->inboxTs[1 - m_inbox] != NO_EVENT)
+            {
+                m_ready.push_back(lp);
+            }
+        }
+        std::stable_sort(m_ready.begin(),
+                         m_ready.end(),
+                         [](const LogicalProcess* a, const LogicalProcess* b) {
+                             return a->lastWindowEvents > b->lastWindowEvents;
+                         });
+        for (uint32_t i = 0; i < m_ready.size(); i++)
+        {
+            dealt[i % threads].push_back(m_ready[i]);
+        }
+        m_ready.clear();
+        for (uint32_t t = 0; t < threads; t++)
+        {
+            uint64_t first = m_ready.size();
+            m_ready.insert(m_ready.end(), dealt[t].begin(), dealt[t].end());
+            m_workQueues[t].range.store(first << 32 | m_ready.size(), std::memory_order_relaxed);
+            dealt[t].clear();
+        }
+
+        m_parallel = true;
+        m_busyThreads.store(threads - 1, std::memory_order_relaxed);
+        m_window.fetch_add(1, std::memory_order_release);
+        m_window.notify_all();
+        RunWindow(0);
+        uint32_t spins = 0;
+        while (m_busyThreads.load(std::memory_order_acquire) != 0)
+        {
+            Pause(spins);
+        }
+        m_parallel = false;
+        m_inbox = 1 - m_inbox;
+    }
+
+    m_quit = true;
+    m_window.fetch_add(1, std::memory_order_release);
+    m_window.notify_all();
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+    m_threads.clear();
+
+    // The clock of the main thread is the latest one
+    int64_t unscheduledEvents = 0;
+    for (auto& lp : m_lps)
+    {
+        pub.currentTs = std::max(pub.currentTs, lp->currentTs);
+        unscheduledEvents += lp->unscheduledEvents;
+    }
+
+    // If the simulator stopped naturally by lack of events, make a
+    // consistency test to check that we didn't lose any events along the way.
+    NS_ASSERT(!IsFinished() || m_stop || unscheduledEvents == 0);
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished() const
+{
+    if (m_stop)
+    {
+        return true;
+    }
+    for (auto& lp : m_lps)
+    {
+        if (!lp->events->IsEmpty() || lp->inboxTs[0] != NO_EVENT || lp->inboxTs[1] != NO_EVENT)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    m_stop = true;
+}
+
+EventId
+MultithreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    return Simulator::Schedule(delay, &Simulator::Stop);
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+MultithreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep() << event);
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+
+    LogicalProcess& lp = CurrentLp();
+    uint64_t ts = lp.currentTs + delay.GetTimeStep();
+    uint32_t uid = Insert(lp, ts, lp.currentContext, event);
+    return EventId(event, ts, lp.currentContext, uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << context << delay.GetTimeStep() << event);
+    NS_ASSERT_MSG(m_parallel || m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::ScheduleWithContext Thread-unsafe invocation!");
+
+    LogicalProcess& from = CurrentLp();
+    LogicalProcess& to = LpOf(context);
+    uint64_t ts = from.currentTs + delay.GetTimeStep();
+    if (&to == &from || !m_parallel)
+    {
+        Insert(to, ts, context, event);
+        return;
+    }
+
+    if (static_cast<uint64_t>(delay.GetTimeStep()) < m_lookahead)
+    {
+        NS_FATAL_ERROR("Event for context " << context << " scheduled " << delay
+                                            << " ahead, less than the lookahead "
+                                            << TimeStep(m_lookahead));
+    }
+    RemoteEvent remote;
+    remote.ts = ts;
+    remote.context = context;
+    remote.source = from.index;
+    remote.sequence = from.sent;
+    remote.event = event;
+    from.sent++;
+    to.inbox[m_inbox].Push(remote);
+
+    std::atomic<uint64_t>& inboxTs = to.inboxTs[m_inbox];
+    uint64_t earliest = inboxTs.load(std::memory_order_relaxed);
+    while (ts < earliest &&
+           !inboxTs.compare_exchange_weak(earliest, ts, std::memory_order_relaxed))
+    {
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return Schedule(Time(0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    NS_ASSERT_MSG(m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::ScheduleDestroy Thread-unsafe invocation!");
+
+    EventId id(Ptr<EventImpl>(event, false), CurrentLp().currentTs, 0xffffffff, 2);
+    m_destroyEvents.push_back(id);
+    return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    return TimeStep(CurrentLp().currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    else
+    {
+        return TimeStep(id.GetTs() - CurrentLp().currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                m_destroyEvents.erase(i);
+                break;
+            }
+        }
+        return;
+    }
+    if (IsExpired(id))
+    {
+        return;
+    }
+    LogicalProcess& lp = LpOf(id.GetContext());
+    Scheduler::Event event;
+    event.impl = id.PeekEventImpl();
+    event.key.m_ts = id.GetTs();
+    event.key.m_context = id.GetContext();
+    event.key.m_uid = id.GetUid();
+    lp.events->Remove(event);
+    event.impl->Cancel();
+    // whenever we remove an event from the event list, we have to unref it.
+    event.impl->Unref();
+
+    lp.unscheduledEvents--;
+}
+
+void
+MultithreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (!IsExpired(id))
+    {
+        id.PeekEventImpl()->Cancel();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+        {
+            return true;
+        }
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    const LogicalProcess& lp = LpOf(id.GetContext());
+    return id.PeekEventImpl() == nullptr || id.GetTs() < lp.currentTs ||
+           (id.GetTs() == lp.currentTs && id.GetUid() <= lp.currentUid) ||
+           id.PeekEventImpl()->IsCancelled();
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext() const
+{
+    return CurrentLp().currentContext;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount() const
+{
+    uint64_t eventCount = 0;
+    for (auto& lp : m_lps)
+    {
+        eventCount += lp->eventCount;
+    }
+    return eventCount;
+}
+
+} // namespace ns3
@@ -0,0 +1,292 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "mpsc-queue.h"
+#include "object-factory.h"
+#include "simulator-impl.h"
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3
+{
+
+// Forward
+class Scheduler;
+
+/**
+ * @ingroup simulator
+ *
+ * @brief A parallel simulator implementation, with one thread per core
+ * in a single address space.
+ *
+ * The contexts, i.e. the node ids, are grouped in logical processes
+ * (LPs) with SetPartition().  Each LP has its own event list, clock and
+ * event uids.  The simulation advances in time windows: a window starts
+ * at the earliest pending event and lasts `Lookahead`, and within a
+ * window the LPs run their events independently, on up to `MaxThreads`
+ * threads.  The LPs ready to run are dealt to the threads, longest
+ * last window first, and a thread which runs out of LPs steals from
+ * the others.
+ *
+ * This is conservative synchronization: an event for another LP is at
+ * least `Lookahead` in the future, thus beyond the current window, so
+ * `Lookahead` must not exceed the smallest delay of the links between
+ * the partitions.  Such events are pushed to the lock free inbound queue
+ * of their LP, which takes them in at the start of its next window, in
+ * an order which does not depend on the threads: the simulation is
+ * deterministic.  Unlike the MPI implementations, packets cross
+ * partitions as pointers, without serialization.
+ *
+ * Events without a context, or with a context which is not in a
+ * partition, belong to a public LP, whose events run alone on the main
+ * thread between the windows.  All the events scheduled before the first
+ * Run() go to their LP when it starts, so SetPartition() may be called
+ * any time before.
+ *
+ * Models must only touch the state of the nodes of their own LP, and
+ * objects shared by several LPs need thread safe reference counts, so
+ * running more than one thread requires ns-3 configured with NS3_MTP.
+ * Otherwise the LPs run on the main thread only.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     *  Register this type.
+     *  @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    MultithreadedSimulatorImpl();
+    /** Destructor. */
+    ~MultithreadedSimulatorImpl() override;
+
+    // Inherited
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    EventId Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+
+    /**
+     * Put a context in a partition, i.e. a logical process.
+     *
+     * Must be called before the first Run().
+     *
+     * @param [in] context The context, usually a node id.
+     * @param [in] partition The partition, from 0.
+     */
+    void SetPartition(uint32_t context, uint32_t partition);
+
+    /**
+     * @returns The number of partitions.
+     */
+    uint32_t GetPartitionCount() const;
+
+    /**
+     * @param [in] context A context.
+     * @returns The partition of the context, or UINT32_MAX if it is in none.
+     */
+    uint32_t GetPartition(uint32_t context) const;
+
+  private:
+    void DoDispose() override;
+
+    /** An event sent by another LP, waiting in the inbound queue. */
+    struct RemoteEvent
+    {
+        uint64_t ts;       //!< The event time stamp.
+        uint32_t context;  //!< The event context.
+        uint32_t source;   //!< The sending LP.
+        uint64_t sequence; //!< The send order within the sending LP.
+        EventImpl* event;  //!< The event implementation.
+    };
+
+    /** A logical process: the events of a set of contexts. */
+    struct alignas(64) LogicalProcess
+    {
+        /** The LP index, 0 for the public LP. */
+        uint32_t index{0};
+        /** The event priority queue. */
+        Ptr<Scheduler> events;
+        /** Inbound queues, the one in use alternates with the windows. */
+        MpscQueue<RemoteEvent> inbox[2];
+        /** Earliest time stamp in each inbound queue. */
+        std::atomic<uint64_t> inboxTs[2];
+        /** The events taken from an inbound queue, kept to reuse the memory. */
+        std::vector<RemoteEvent> received;
+        /** Next event unique id. */
+        uint32_t uid{0};
+        /** Unique id of the current event. */
+        uint32_t currentUid{0};
+        /** Timestamp of the current event. */
+        uint64_t currentTs{0};
+        /** Execution context of the current event. */
+        uint32_t currentContext{0};
+        /** Number of events sent to other LPs. */
+        uint64_t sent{0};
+        /** The event count. */
+        uint64_t eventCount{0};
+        /** Events run in the last window, to deal the LPs to the threads. */
+        uint64_t lastWindowEvents{0};
+        /**
+         * Number of events that have been inserted but not yet scheduled,
+         * this is used for validation
+         */
+        int64_t unscheduledEvents{0};
+    };
+
+    /** The ready LPs dealt to a thread, stolen from the back. */
+    struct alignas(64) WorkQueue
+    {
+        /** Indexes in m_ready, the first in the high 32 bits, the end in the low ones. */
+        std::atomic<uint64_t> range;
+    };
+
+    /** Add a LP to m_lps. */
+    void CreateLp();
+    /**
+     * Set the lookahead.
+     * @param [in] lookahead The lookahead.
+     */
+    void SetLookahead(Time lookahead);
+    /**
+     * @returns The LP of the calling thread.
+     */
+    LogicalProcess& CurrentLp() const;
+    /**
+     * @param [in] context A context.
+     * @returns The LP of the context.
+     */
+    LogicalProcess& LpOf(uint32_t context) const;
+    /**
+     * @param [in] lp A LP.
+     * @returns The time stamp of the next event of the LP, including its
+     *          inbound queue, or UINT64_MAX.
+     */
+    uint64_t NextTs(const LogicalProcess& lp) const;
+    /**
+     * Insert an event in the event list of a LP.
+     * @param [in] lp The LP.
+     * @param [in] ts The time stamp.
+     * @param [in] context The context.
+     * @param [in] event The event.
+     * @returns The event unique id.
+     */
+    uint32_t Insert(LogicalProcess& lp, uint64_t ts, uint32_t context, EventImpl* event);
+    /**
+     * Move the events sent during the previous window to the event list.
+     * @param [in] lp The LP.
+     */
+    void ReceiveEvents(LogicalProcess& lp);
+    /**
+     * Run the next event of a LP.
+     * @param [in] lp The LP.
+     */
+    void ProcessOneEvent(LogicalProcess& lp);
+    /**
+     * Run the events of a LP within the current window.
+     * @param [in] lp The LP.
+     */
+    void ProcessWindow(LogicalProcess& lp);
+    /**
+     * Move the events scheduled before the first run to their LP.
+     */
+    void Partition();
+    /**
+     * Run the window on the current thread, until no LP is left.
+     * @param [in] thread The index of the thread.
+     */
+    void RunWindow(uint32_t thread);
+    /**
+     * Take a LP from the work queue of a thread.
+     * @param [in] thread The index of the thread.
+     * @param [in] steal Take the last LP instead of the first.
+     * @param [out] index The index of the LP in m_ready.
+     * @returns false if the work queue is empty.
+     */
+    bool TakeWork(uint32_t thread, bool steal, uint32_t& index);
+    /**
+     * The loop of the worker threads.
+     * @param [in] thread The index of the thread, from 1.
+     * @param [in] window The value of m_window when the thread was started.
+     */
+    void Worker(uint32_t thread, uint64_t window);
+
+    /** The LPs, the public one first. */
+    std::vector<std::unique_ptr<LogicalProcess>> m_lps;
+    /** The LP index of each context, 0 if not in a partition. */
+    std::vector<uint32_t> m_lpOfContext;
+    /** Whether the events scheduled before the first run went to their LP. */
+    bool m_partitioned;
+    /** The scheduler of the LPs. */
+    ObjectFactory m_schedulerFactory;
+
+    /** Container type for the events to run at Simulator::Destroy() */
+    typedef std::list<EventId> DestroyEvents;
+    /** The container of events to run at Destroy. */
+    DestroyEvents m_destroyEvents;
+    /** Flag calling for the end of the simulation. */
+    std::atomic<bool> m_stop;
+
+    /** The lookahead, in time steps. */
+    uint64_t m_lookahead;
+    /** The maximum number of threads, 0 for one per core. */
+    uint32_t m_maxThreads;
+    /** The worker threads, the main thread is thread 0. */
+    std::vector<std::thread> m_threads;
+    /** The work queues, one per thread. */
+    std::unique_ptr<WorkQueue[]> m_workQueues;
+    /** The LPs to run in the current window. */
+    std::vector<LogicalProcess*> m_ready;
+    /** End of the current window, exclusive. */
+    uint64_t m_windowEnd;
+    /** The inbound queue the events are sent to in the current window. */
+    uint32_t m_inbox;
+    /** Whether the LPs are running in parallel. */
+    bool m_parallel;
+    /** Incremented to start a window, or to quit. */
+    std::atomic<uint64_t> m_window;
+    /** Number of worker threads still running the window. */
+    std::atomic<uint32_t> m_busyThreads;
+    /** Whether the worker threads must exit. */
+    bool m_quit;
+    /** Main execution thread. */
+    std::thread::id m_mainThreadId;
+
+    /** The LP run by each thread. */
+    static thread_local LogicalProcess* g_currentLp;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
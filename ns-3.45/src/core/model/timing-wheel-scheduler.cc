@@ -0,0 +1,319 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "timing-wheel-scheduler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+#include "type-id.h"
+#include "uinteger.h"
+
+#include <algorithm>
+#include <bit>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::TimingWheelScheduler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TimingWheelScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(TimingWheelScheduler);
+
+namespace
+{
+
+/**
+ * Order the far heap as a min-heap.
+ * @param [in] a The first event.
+ * @param [in] b The second event.
+ * @returns \c true if \c a is later than \c b.
+ */
+bool
+FarOrder(const Scheduler::Event& a, const Scheduler::Event& b)
+{
+    return b.key < a.key;
+}
+
+} // unnamed namespace
+
+TypeId
+TimingWheelScheduler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::TimingWheelScheduler")
+            .SetParent<Scheduler>()
+            .SetGroupName("Core")
+            .AddConstructor<TimingWheelScheduler>()
+            .AddAttribute("BucketCount",
+                          "Number of buckets of the wheel, rounded up to a power of two",
+                          TypeId::ATTR_CONSTRUCT,
+                          UintegerValue(1024),
+                          MakeUintegerAccessor(&TimingWheelScheduler::SetBucketCount),
+                          MakeUintegerChecker<uint32_t>(64, 1 << 24))
+            .AddAttribute("BucketWidth",
+                          "Time span of a bucket, rounded up to a power of two time steps",
+                          TypeId::ATTR_CONSTRUCT,
+                          TimeValue(NanoSeconds(64)),
+                          MakeTimeAccessor(&TimingWheelScheduler::SetBucketWidth),
+                          MakeTimeChecker(TimeStep(1)));
+    return tid;
+}
+
+TimingWheelScheduler::TimingWheelScheduler()
+    : m_mask(1023),
+      m_shift(6),
+      m_current(0),
+      m_start(0),
+      m_wheelSize(0)
+{
+    NS_LOG_FUNCTION(this);
+    Init();
+}
+
+TimingWheelScheduler::~TimingWheelScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+TimingWheelScheduler::SetBucketCount(uint32_t count)
+{
+    NS_LOG_FUNCTION(this << count);
+    NS_ASSERT_MSG(IsEmpty(), "The wheel can only be resized while empty");
+    m_mask = std::bit_ceil(std::max<uint32_t>(count, 64)) - 1;
+    Init();
+}
+
+void
+TimingWheelScheduler::SetBucketWidth(Time width)
+{
+    NS_LOG_FUNCTION(this << width);
+    NS_ASSERT_MSG(IsEmpty(), "The wheel can only be resized while empty");
+    auto steps = static_cast<uint64_t>(std::max<int64_t>(width.GetTimeStep(), 1));
+    m_shift = std::bit_width(std::bit_ceil(steps)) - 1;
+    m_start = 0;
+    m_current = 0;
+}
+
+void
+TimingWheelScheduler::Init()
+{
+    NS_LOG_FUNCTION(this);
+    m_buckets.assign(m_mask + 1, Bucket());
+    m_occupied.assign((m_mask + 1) / 64, 0);
+    m_current = Hash(m_start);
+}
+
+uint32_t
+TimingWheelScheduler::Hash(uint64_t ts) const
+{
+    return (ts >> m_shift) & m_mask;
+}
+
+uint64_t
+TimingWheelScheduler::WindowEnd() const
+{
+    return m_start + (static_cast<uint64_t>(m_mask + 1) << m_shift);
+}
+
+uint32_t
+TimingWheelScheduler::FindNext() const
+{
+    NS_ASSERT(m_wheelSize != 0);
+    // Scan from the current bucket to the end of the bitmap, then wrap
+    // around to the buckets before it, which hold the latest events.
+    uint32_t words = m_occupied.size();
+    uint32_t word = m_current / 64;
+    uint64_t bits = m_occupied[word] & (~0ULL << (m_current % 64));
+    for (uint32_t n = 0; n <= words; n++)
+    {
+        if (bits != 0)
+        {
+            return word * 64 + std::countr_zero(bits);
+        }
+        word = (word + 1) % words;
+        bits = m_occupied[word];
+    }
+    NS_FATAL_ERROR("No occupied bucket in a non empty wheel");
+    return 0;
+}
+
+void
+TimingWheelScheduler::InsertInWheel(const Scheduler::Event& ev)
+{
+    uint32_t index = Hash(ev.key.m_ts);
+    Bucket& bucket = m_buckets[index];
+    if (bucket.head == bucket.events.size() || bucket.events.back().key < ev.key)
+    {
+        // Common case, the event is the latest of its bucket
+        bucket.events.push_back(ev);
+    }
+    else
+    {
+        auto it = std::upper_bound(bucket.events.begin() + bucket.head,
+                                   bucket.events.end(),
+                                   ev,
+                                   [](const Event& a, const Event& b) { return a.key < b.key; });
+        bucket.events.insert(it, ev);
+    }
+    m_occupied[index / 64] |= 1ULL << (index % 64);
+    m_wheelSize++;
+}
+
+void
+TimingWheelScheduler::MoveFarEvents()
+{
+    uint64_t end = WindowEnd();
+    while (!m_far.empty() && m_far.front().key.m_ts < end)
+    {
+        std::pop_heap(m_far.begin(), m_far.end(), FarOrder);
+        InsertInWheel(m_far.back());
+        m_far.pop_back();
+    }
+}
+
+void
+TimingWheelScheduler::Rewind(uint64_t ts)
+{
+    NS_LOG_FUNCTION(this << ts);
+    for (auto& bucket : m_buckets)
+    {
+        m_far.insert(m_far.end(), bucket.events.begin() + bucket.head, bucket.events.end());
+        bucket.events.clear();
+        bucket.head = 0;
+    }
+    std::fill(m_occupied.begin(), m_occupied.end(), 0);
+    std::make_heap(m_far.begin(), m_far.end(), FarOrder);
+    m_wheelSize = 0;
+
+    m_start = (ts >> m_shift) << m_shift;
+    m_current = Hash(m_start);
+    MoveFarEvents();
+}
+
+void
+TimingWheelScheduler::Insert(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    if (ev.key.m_ts < m_start)
+    {
+        // The simulator never schedules in the past, but other users might
+        Rewind(ev.key.m_ts);
+    }
+
+    if (ev.key.m_ts >= WindowEnd())
+    {
+        m_far.push_back(ev);
+        std::push_heap(m_far.begin(), m_far.end(), FarOrder);
+    }
+    else
+    {
+        InsertInWheel(ev);
+    }
+}
+
+bool
+TimingWheelScheduler::IsEmpty() const
+{
+    return m_wheelSize == 0 && m_far.empty();
+}
+
+Scheduler::Event
+TimingWheelScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    if (m_wheelSize == 0)
+    {
+        return m_far.front();
+    }
+    const Bucket& bucket = m_buckets[FindNext()];
+    return bucket.events[bucket.head];
+}
+
+Scheduler::Event
+TimingWheelScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+
+    if (m_wheelSize == 0)
+    {
+        // Jump to the earliest far event
+        m_start = (m_far.front().key.m_ts >> m_shift) << m_shift;
+        m_current = Hash(m_start);
+        MoveFarEvents();
+    }
+
+    uint32_t index = FindNext();
+    if (index != m_current)
+    {
+        // Turn the wheel, the window now reaches further
+        m_start += static_cast<uint64_t>((index - m_current) & m_mask) << m_shift;
+        m_current = index;
+        MoveFarEvents();
+    }
+
+    Bucket& bucket = m_buckets[index];
+    Scheduler::Event ev = bucket.events[bucket.head++];
+    if (bucket.head == bucket.events.size())
+    {
+        bucket.events.clear();
+        bucket.head = 0;
+        m_occupied[index / 64] &= ~(1ULL << (index % 64));
+    }
+    m_wheelSize--;
+
+    NS_LOG_DEBUG("remove " << ev.key.m_ts << " " << ev.key.m_uid);
+    return ev;
+}
+
+void
+TimingWheelScheduler::Remove(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    NS_ASSERT(!IsEmpty());
+
+    if (ev.key.m_ts >= m_start && ev.key.m_ts < WindowEnd())
+    {
+        uint32_t index = Hash(ev.key.m_ts);
+        Bucket& bucket = m_buckets[index];
+        for (auto it = bucket.events.begin() + bucket.head; it != bucket.events.end(); ++it)
+        {
+            if (it->key.m_uid == ev.key.m_uid)
+            {
+                NS_ASSERT(ev.impl == it->impl);
+                bucket.events.erase(it);
+                if (bucket.head == bucket.events.size())
+                {
+                    bucket.events.clear();
+                    bucket.head = 0;
+                    m_occupied[index / 64] &= ~(1ULL << (index % 64));
+                }
+                m_wheelSize--;
+                return;
+            }
+        }
+    }
+
+    for (auto it = m_far.begin(); it != m_far.end(); ++it)
+    {
+        if (it->key.m_uid == ev.key.m_uid)
+        {
+            NS_ASSERT(ev.impl == it->impl);
+            m_far.erase(it);
+            std::make_heap(m_far.begin(), m_far.end(), FarOrder);
+            return;
+        }
+    }
+    NS_ASSERT(false);
+}
+
+} // namespace ns3
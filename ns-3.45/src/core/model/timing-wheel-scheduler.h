@@ -0,0 +1,146 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef TIMING_WHEEL_SCHEDULER_H
+#define TIMING_WHEEL_SCHEDULER_H
+
+#include "nstime.h"
+#include "scheduler.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::TimingWheelScheduler declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup scheduler
+ * @brief a two tier timing wheel event scheduler
+ *
+ * This scheduler is aimed at dense event sets, where many events
+ * fall within a short horizon, as in packet level simulations of
+ * fast links.
+ *
+ * The near tier is a wheel of `BucketCount` buckets, each covering
+ * `BucketWidth` of simulation time, so the wheel covers the window
+ * starting at the bucket of the last event removed.  Buckets are
+ * contiguous `std::vector<>` kept sorted in chronological order,
+ * which makes the common case of an event later than everything in
+ * its bucket an append.  A bitmap of the occupied buckets makes the
+ * search for the next event a few word scans.
+ *
+ * Events beyond the window go to the far tier, a binary heap.  As the
+ * wheel turns, far events which enter the window move to their bucket,
+ * like the rungs of a ladder queue.
+ *
+ * The bucket width should be close to the typical spacing of events;
+ * it is rounded up to a power of two time steps, and the bucket count
+ * to a power of two.
+ *
+ * @par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | Ordering within bucket, or heap
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | ~Constant       | Bitmap search
+ * Remove()     | ~Constant       | Search within bucket, or heap
+ * RemoveNext() | ~Constant       | Bitmap search; far events moved in
+ *
+ * @par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | `BucketCount` x 4 x `sizeof (*)` | `std::vector` and read index per bucket
+ * Per Event | 0                                | Events stored in `std::vector` directly
+ */
+class TimingWheelScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    TimingWheelScheduler();
+    /** Destructor. */
+    ~TimingWheelScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /** A bucket of the wheel, events sorted in chronological order. */
+    struct Bucket
+    {
+        std::vector<Scheduler::Event> events; //!< The events.
+        std::size_t head{0};                  //!< Index of the next event.
+    };
+
+    /**
+     * Set the number of buckets of the wheel.
+     * @param [in] count The number of buckets, rounded up to a power of two.
+     */
+    void SetBucketCount(uint32_t count);
+    /**
+     * Set the time span covered by each bucket.
+     * @param [in] width The bucket width, rounded up to a power of two time steps.
+     */
+    void SetBucketWidth(Time width);
+    /** Allocate the wheel for the current bucket count. */
+    void Init();
+
+    /**
+     * Get the wheel index of a time stamp within the window.
+     * @param [in] ts The time stamp.
+     * @returns The bucket index.
+     */
+    inline uint32_t Hash(uint64_t ts) const;
+    /**
+     * @returns The end of the time window covered by the wheel.
+     */
+    inline uint64_t WindowEnd() const;
+    /**
+     * Find the first occupied bucket, in time order.
+     * @returns The bucket index.
+     */
+    uint32_t FindNext() const;
+    /**
+     * Insert an event in the wheel, the event must be in the window.
+     * @param [in] ev The event.
+     */
+    void InsertInWheel(const Scheduler::Event& ev);
+    /** Move the far events which are now in the window to the wheel. */
+    void MoveFarEvents();
+    /**
+     * Move the wheel back to an earlier time, through the far heap.
+     * @param [in] ts The new start of the window.
+     */
+    void Rewind(uint64_t ts);
+
+    std::vector<Bucket> m_buckets;     //!< The wheel.
+    std::vector<uint64_t> m_occupied;  //!< One bit per non-empty bucket.
+    std::vector<Scheduler::Event> m_far; //!< Events beyond the window, as a min-heap.
+    uint32_t m_mask;                   //!< Bucket count - 1.
+    uint32_t m_shift;                  //!< Log2 of the bucket width, in time steps.
+    uint32_t m_current;                //!< Bucket of the start of the window.
+    uint64_t m_start;                  //!< Start of the window, aligned to a bucket.
+    uint32_t m_wheelSize;              //!< Number of events in the wheel.
+};
+
+} // namespace ns3
+
+#endif /* TIMING_WHEEL_SCHEDULER_H */
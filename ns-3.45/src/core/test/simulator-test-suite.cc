@@ -9,9 +9,12 @@
 #include "ns3/heap-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
+#include "ns3/multithreaded-simulator-impl.h"
 #include "ns3/priority-queue-scheduler.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
+#include "ns3/timing-wheel-scheduler.h"
 
 using namespace ns3;
 
@@ -651,6 +654,97 @@ SimulatorTemplateTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that the partitions of MultithreadedSimulatorImpl exchange
+ * events at the right time.
+ */
+class SimulatorMultithreadedTestCase : public TestCase
+{
+  public:
+    SimulatorMultithreadedTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Bounce between the two partitions.
+     * @param hops The number of hops left.
+     */
+    void Bounce(uint32_t hops);
+    /** Record the time of a local event. */
+    void Record();
+
+    /** The time of the events, per context. */
+    std::vector<Time> m_times[2];
+};
+
+SimulatorMultithreadedTestCase::SimulatorMultithreadedTestCase()
+    : TestCase("Check the MultithreadedSimulatorImpl partitions")
+{
+}
+
+void
+SimulatorMultithreadedTestCase::Bounce(uint32_t hops)
+{
+    Record();
+    if (hops > 0)
+    {
+        Simulator::ScheduleWithContext(1 - Simulator::GetContext(),
+                                       MicroSeconds(2),
+                                       &SimulatorMultithreadedTestCase::Bounce,
+                                       this,
+                                       hops - 1);
+    }
+    // Local events run within the windows
+    if (hops % 2 == 0)
+    {
+        Simulator::Schedule(NanoSeconds(300), &SimulatorMultithreadedTestCase::Record, this);
+    }
+}
+
+void
+SimulatorMultithreadedTestCase::Record()
+{
+    m_times[Simulator::GetContext()].push_back(Simulator::Now());
+}
+
+void
+SimulatorMultithreadedTestCase::DoRun()
+{
+    Ptr<MultithreadedSimulatorImpl> impl = CreateObject<MultithreadedSimulatorImpl>();
+    impl->SetAttribute("Lookahead", TimeValue(MicroSeconds(2)));
+    impl->SetAttribute("MaxThreads", UintegerValue(2));
+    impl->SetPartition(0, 0);
+    impl->SetPartition(1, 1);
+    Simulator::SetImplementation(impl);
+    NS_TEST_EXPECT_MSG_EQ(impl->GetPartitionCount(), 2, "Two partitions expected");
+
+    Simulator::ScheduleWithContext(0, MicroSeconds(1), &SimulatorMultithreadedTestCase::Bounce, this, 10);
+    Simulator::ScheduleWithContext(1, MicroSeconds(1), &SimulatorMultithreadedTestCase::Bounce, this, 10);
+    Simulator::Run();
+
+    for (uint32_t context = 0; context < 2; context++)
+    {
+        // 11 bounces per chain, each chain ends on the other context, plus one local event
+        // for every even hop count: 6 per chain
+        NS_TEST_EXPECT_MSG_EQ(m_times[context].size(), 17, "Unexpected number of events");
+        for (uint32_t i = 1; i < m_times[context].size(); i++)
+        {
+            NS_TEST_EXPECT_MSG_EQ((m_times[context][i - 1] <= m_times[context][i]),
+                                  true,
+                                  "Events out of order");
+        }
+        NS_TEST_EXPECT_MSG_EQ(m_times[context].back(),
+                              MicroSeconds(21) + NanoSeconds(300),
+                              "Unexpected last event time");
+    }
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), MicroSeconds(21) + NanoSeconds(300), "Unexpected end time");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetEventCount(), 34, "Unexpected event count");
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup simulator-tests
  *
@@ -674,6 +768,9 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(TimingWheelScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        AddTestCase(new SimulatorMultithreadedTestCase(), TestCase::Duration::QUICK);
     }
 };
 
@@ -1098,7 +1098,15 @@ GlobalRouteManagerImpl::SPFNexthopCalculation(SPFVertex* v,
         }
         else
         {
-            w->SetRootExitDirection(v->GetRootExitDirection());
+            //
+            // The network may be reached through several equal cost paths, as a
+            // network behind a router of a multi-rooted tree, and so may <w>.
+            // Taking the single exit of the network asserted on such a network, or
+            // kept only one of its paths when asserts are disabled.  A network
+            // with one exit still gives <w> that exit, so only the routes across
+            // equal cost transit networks change (see ClosLanTest).
+            //
+            w->InheritAllRootExitDirections(v);
         }
     }
     else
@@ -13,6 +13,8 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -35,30 +37,29 @@ Ipv4EndPointDemux::~Ipv4EndPointDemux()
         delete endPoint;
     }
     m_endPoints.clear();
+    m_portIndex.clear();
+    m_exactIndex.clear();
 }
 
 bool
 Ipv4EndPointDemux::LookupPortLocal(uint16_t port)
 {
     NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        if ((*i)->GetLocalPort() == port)
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_portIndex.find(port) != m_portIndex.end();
 }
 
 bool
 Ipv4EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv4Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto bucket = m_portIndex.find(port);
+    if (bucket == m_portIndex.end())
+    {
+        return false;
+    }
+    for (Ipv4EndPoint* endP : bucket->second)
     {
-        if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
-            (*i)->GetBoundNetDevice() == boundNetDevice)
+        if (endP->GetLocalAddress() == addr && endP->GetBoundNetDevice() == boundNetDevice)
         {
             return true;
         }
@@ -77,7 +78,7 @@ Ipv4EndPointDemux::Allocate()
         return nullptr;
     }
     auto endPoint = new Ipv4EndPoint(Ipv4Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -93,7 +94,7 @@ Ipv4EndPointDemux::Allocate(Ipv4Address address)
         return nullptr;
     }
     auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -116,7 +117,7 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv4Address address,
         return nullptr;
     }
     auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -129,11 +130,11 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << localAddress << localPort << peerAddress << peerPort << boundNetDevice);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    EndPointKey key = {localAddress.Get(), peerAddress.Get(), localPort, peerPort};
+    auto range = m_exactIndex.equal_range(key);
+    for (auto i = range.first; i != range.second; i++)
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        if (i->second->GetBoundNetDevice() == boundNetDevice || !i->second->GetBoundNetDevice())
         {
             NS_LOG_WARN("Duplicated endpoint.");
             return nullptr;
@@ -141,7 +142,7 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
     }
     auto endPoint = new Ipv4EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
 
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
 
@@ -156,6 +157,14 @@ Ipv4EndPointDemux::DeAllocate(Ipv4EndPoint* endPoint)
     {
         if (*i == endPoint)
         {
+            Unindex(endPoint);
+            auto bucket = m_portIndex.find(endPoint->GetLocalPort());
+            auto& endPoints = bucket->second;
+            endPoints.erase(std::find(endPoints.begin(), endPoints.end(), endPoint));
+            if (endPoints.empty())
+            {
+                m_portIndex.erase(bucket);
+            }
             delete endPoint;
             m_endPoints.erase(i);
             break;
@@ -200,10 +209,36 @@ Ipv4EndPointDemux::Lookup(Ipv4Address daddr,
     EndPoints retval4; // Exact match on all 4
 
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr << ":" << dport);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto bucket = m_portIndex.find(dport);
+    if (bucket == m_portIndex.end())
     {
-        Ipv4EndPoint* endP = *i;
+        return retval1;
+    }
+
+    // An exact match on all 4 is the most specific, look it up first
+    auto range = m_exactIndex.equal_range({daddr.Get(), saddr.Get(), dport, sport});
+    for (auto i = range.first; i != range.second; i++)
+    {
+        Ipv4EndPoint* endP = i->second;
+        if (endP->IsRxEnabled() &&
+            (!endP->GetBoundNetDevice() ||
+             endP->GetBoundNetDevice() == incomingInterface->GetDevice()))
+        {
+            NS_LOG_LOGIC("Found an endpoint for case 4, adding " << endP->GetLocalAddress() << ":"
+                                                                 << endP->GetLocalPort());
+            retval4.push_back(endP);
+        }
+    }
+    if (!retval4.empty())
+    {
+        NS_ABORT_MSG_IF(retval4.size() > 1,
+                        "Too many endpoints - perhaps you created too many sockets without "
+                        "binding them to different NetDevices.");
+        return retval4;
+    }
 
+    for (Ipv4EndPoint* endP : bucket->second)
+    {
         NS_LOG_DEBUG("Looking at endpoint dport="
                      << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
                      << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
@@ -365,12 +400,13 @@ Ipv4EndPointDemux::SimpleLookup(Ipv4Address daddr,
     // function.
     uint32_t genericity = 3;
     Ipv4EndPoint* generic = nullptr;
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto bucket = m_portIndex.find(dport);
+    if (bucket == m_portIndex.end())
+    {
+        return nullptr;
+    }
+    for (auto i = bucket->second.begin(); i != bucket->second.end(); i++)
     {
-        if ((*i)->GetLocalPort() != dport)
-        {
-            continue;
-        }
         if ((*i)->GetLocalAddress() == daddr && (*i)->GetPeerPort() == sport &&
             (*i)->GetPeerAddress() == saddr)
         {
@@ -395,6 +431,47 @@ Ipv4EndPointDemux::SimpleLookup(Ipv4Address daddr,
     return generic;
 }
 
+Ipv4EndPointDemux::EndPointKey
+Ipv4EndPointDemux::GetKey(const Ipv4EndPoint* endPoint)
+{
+    return {endPoint->GetLocalAddress().Get(),
+            endPoint->GetPeerAddress().Get(),
+            endPoint->GetLocalPort(),
+            endPoint->GetPeerPort()};
+}
+
+void
+Ipv4EndPointDemux::Insert(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    m_endPoints.push_back(endPoint);
+    m_portIndex[endPoint->GetLocalPort()].push_back(endPoint);
+    endPoint->m_demux = this;
+    Index(endPoint);
+}
+
+void
+Ipv4EndPointDemux::Index(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    m_exactIndex.emplace(GetKey(endPoint), endPoint);
+}
+
+void
+Ipv4EndPointDemux::Unindex(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    auto range = m_exactIndex.equal_range(GetKey(endPoint));
+    for (auto i = range.first; i != range.second; i++)
+    {
+        if (i->second == endPoint)
+        {
+            m_exactIndex.erase(i);
+            return;
+        }
+    }
+}
+
 uint16_t
 Ipv4EndPointDemux::AllocateEphemeralPort()
 {
@@ -15,6 +15,8 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -160,6 +162,75 @@ class Ipv4EndPointDemux
     void DeAllocate(Ipv4EndPoint* endPoint);
 
   private:
+    friend class Ipv4EndPoint;
+
+    /**
+     * @brief Key of the exact index: the addresses and ports of an end point.
+     */
+    struct EndPointKey
+    {
+        uint32_t localAddress; //!< Local address.
+        uint32_t peerAddress;  //!< Peer address.
+        uint16_t localPort;    //!< Local port.
+        uint16_t peerPort;     //!< Peer port.
+
+        /**
+         * @brief Equality operator.
+         * @param other the other key
+         * @returns true if the keys are equal
+         */
+        bool operator==(const EndPointKey& other) const
+        {
+            return localAddress == other.localAddress && peerAddress == other.peerAddress &&
+                   localPort == other.localPort && peerPort == other.peerPort;
+        }
+    };
+
+    /**
+     * @brief Hash function of EndPointKey.
+     */
+    struct EndPointKeyHash
+    {
+        /**
+         * @brief Hash an EndPointKey.
+         * @param key the key
+         * @returns the hash
+         */
+        size_t operator()(const EndPointKey& key) const
+        {
+            uint64_t addresses = (static_cast<uint64_t>(key.localAddress) << 32) | key.peerAddress;
+            uint32_t ports = (static_cast<uint32_t>(key.localPort) << 16) | key.peerPort;
+            return std::hash<uint64_t>()(addresses ^ (static_cast<uint64_t>(ports) * 0x9e3779b97f4a7c15));
+        }
+    };
+
+    /**
+     * @brief Get the key of an end point in the exact index.
+     * @param endPoint the end point
+     * @returns the key
+     */
+    static EndPointKey GetKey(const Ipv4EndPoint* endPoint);
+
+    /**
+     * @brief Add a new end point to the list and to the indices.
+     * @param endPoint the end point
+     */
+    void Insert(Ipv4EndPoint* endPoint);
+
+    /**
+     * @brief Add an end point to the exact index, after a change of its
+     * addresses or ports.
+     * @param endPoint the end point
+     */
+    void Index(Ipv4EndPoint* endPoint);
+
+    /**
+     * @brief Remove an end point from the exact index, before a change of its
+     * addresses or ports.
+     * @param endPoint the end point
+     */
+    void Unindex(Ipv4EndPoint* endPoint);
+
     /**
      * @brief Allocate an ephemeral port.
      * @returns the ephemeral port
@@ -185,6 +256,22 @@ class Ipv4EndPointDemux
      * @brief A list of IPv4 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * @brief The end points by local port, in the order of m_endPoints.
+     *
+     * The local port of an end point never changes, all the lookups are
+     * restricted to the end points of the port.
+     */
+    std::unordered_map<uint16_t, std::vector<Ipv4EndPoint*>> m_portIndex;
+
+    /**
+     * @brief The end points by addresses and ports, for the exact matches.
+     *
+     * The wildcard addresses and ports are indexed as they are, kept up to
+     * date by Ipv4EndPoint::SetLocalAddress and Ipv4EndPoint::SetPeer.
+     */
+    std::unordered_multimap<EndPointKey, Ipv4EndPoint*, EndPointKeyHash> m_exactIndex;
 };
 
 } // namespace ns3
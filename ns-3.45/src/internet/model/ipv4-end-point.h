@@ -23,6 +23,7 @@ namespace ns3
 
 class Header;
 class Packet;
+class Ipv4EndPointDemux;
 
 /**
  * @ingroup ipv4
@@ -180,6 +181,8 @@ class Ipv4EndPoint
     bool IsRxEnabled() const;
 
   private:
+    friend class Ipv4EndPointDemux;
+
     /**
      * @brief The local address.
      */
@@ -224,6 +227,11 @@ class Ipv4EndPoint
      * @brief true if the endpoint can receive packets.
      */
     bool m_rxEnabled;
+
+    /**
+     * @brief The demux indexing the endpoint by its addresses and ports (if any).
+     */
+    Ipv4EndPointDemux* m_demux;
 };
 
 } // namespace ns3
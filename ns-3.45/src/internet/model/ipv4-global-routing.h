@@ -97,6 +97,15 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
     void PrintRoutingTable(Ptr<OutputStreamWrapper> stream,
                            Time::Unit unit = Time::S) const override;
 
+    /**
+     * @brief Get the generation of the routes, changed by every route
+     * added or removed and every interface event.
+     *
+     * @returns the generation, or zero with RandomEcmpRouting since each
+     *          packet may take another route
+     */
+    uint64_t GetRouteGeneration() const override;
+
     /**
      * @brief Add a host route to the global routing table.
      *
@@ -267,6 +276,8 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
     ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
 
     Ptr<Ipv4> m_ipv4; //!< associated IPv4 instance
+
+    uint64_t m_routeGeneration; //!< Generation of the routes, see GetRouteGeneration
 };
 
 } // Namespace ns3
@@ -738,7 +738,8 @@ Ipv4L3Protocol::Send(Ptr<Packet> packet,
     bool mayFragment = true;
 
     // we need a copy of the packet with its tags in case we need to invoke recursion.
-    Ptr<Packet> pktCopyWithTags = packet->Copy();
+    // Lean packets have no tags to remove, the packet itself is not modified.
+    Ptr<Packet> pktCopyWithTags = Packet::IsLean() ? packet : packet->Copy();
 
     uint8_t ttl = m_defaultTtl;
     SocketIpTtlTag ipTtlTag;
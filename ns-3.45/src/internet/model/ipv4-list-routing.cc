@@ -31,7 +31,8 @@ Ipv4ListRouting::GetTypeId()
 }
 
 Ipv4ListRouting::Ipv4ListRouting()
-    : m_ipv4(nullptr)
+    : m_ipv4(nullptr),
+      m_routeGeneration(1)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -242,12 +243,30 @@ Ipv4ListRouting::AddRoutingProtocol(Ptr<Ipv4RoutingProtocol> routingProtocol, in
     NS_LOG_FUNCTION(this << routingProtocol->GetInstanceTypeId() << priority);
     m_routingProtocols.emplace_back(priority, routingProtocol);
     m_routingProtocols.sort(Compare);
+    m_routeGeneration++;
     if (m_ipv4)
     {
         routingProtocol->SetIpv4(m_ipv4);
     }
 }
 
+uint64_t
+Ipv4ListRouting::GetRouteGeneration() const
+{
+    // The sum changes whenever the generation of one protocol does
+    uint64_t generation = m_routeGeneration;
+    for (const auto& protocol : m_routingProtocols)
+    {
+        uint64_t protocolGeneration = protocol.second->GetRouteGeneration();
+        if (protocolGeneration == 0)
+        {
+            return 0;
+        }
+        generation += protocolGeneration;
+    }
+    return generation;
+}
+
 uint32_t
 Ipv4ListRouting::GetNRoutingProtocols() const
 {
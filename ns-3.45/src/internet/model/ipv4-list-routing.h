@@ -89,6 +89,12 @@ class Ipv4ListRouting : public Ipv4RoutingProtocol
     void SetIpv4(Ptr<Ipv4> ipv4) override;
     void PrintRoutingTable(Ptr<OutputStreamWrapper> stream,
                            Time::Unit unit = Time::S) const override;
+    /**
+     * @brief Get the generation of the routes of the list, which changes
+     * with the generation of any protocol in the list.
+     * @returns the generation, or zero if a protocol does not support route caching
+     */
+    uint64_t GetRouteGeneration() const override;
 
   protected:
     void DoDispose() override;
@@ -112,7 +118,8 @@ class Ipv4ListRouting : public Ipv4RoutingProtocol
      * @return true if they are the same, false otherwise
      */
     static bool Compare(const Ipv4RoutingProtocolEntry& a, const Ipv4RoutingProtocolEntry& b);
-    Ptr<Ipv4> m_ipv4; //!< Ipv4 this protocol is associated with.
+    Ptr<Ipv4> m_ipv4;           //!< Ipv4 this protocol is associated with.
+    uint64_t m_routeGeneration; //!< Changed when a protocol is added to the list.
 };
 
 } // namespace ns3
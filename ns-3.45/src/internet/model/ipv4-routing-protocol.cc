@@ -24,4 +24,10 @@ Ipv4RoutingProtocol::GetTypeId()
     return tid;
 }
 
+uint64_t
+Ipv4RoutingProtocol::GetRouteGeneration() const
+{
+    return 0;
+}
+
 } // namespace ns3
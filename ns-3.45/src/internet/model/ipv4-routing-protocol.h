@@ -162,6 +162,20 @@ class Ipv4RoutingProtocol : public Object
      */
     virtual void SetIpv4(Ptr<Ipv4> ipv4) = 0;
 
+    /**
+     * @brief Get the generation of the routes returned by RouteOutput.
+     *
+     * A protocol which supports route caching changes the generation
+     * whenever one of its routes or the state of an interface changes, so
+     * that the callers can reuse a route returned by RouteOutput for the
+     * same destination and output device as long as the generation is the
+     * same.
+     *
+     * @returns the generation, or zero if the routes must not be cached,
+     *          which is the default
+     */
+    virtual uint64_t GetRouteGeneration() const;
+
     /**
      * @brief Print the Routing Table entries
      *
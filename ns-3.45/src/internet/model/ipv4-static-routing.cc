@@ -47,7 +47,8 @@ Ipv4StaticRouting::GetTypeId()
 }
 
 Ipv4StaticRouting::Ipv4StaticRouting()
-    : m_ipv4(nullptr)
+    : m_ipv4(nullptr),
+      m_routeGeneration(1)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -61,6 +62,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
 {
     NS_LOG_FUNCTION(this << network << " " << networkMask << " " << nextHop << " "
                          << interface << " " << metric);
+    m_routeGeneration++;
 
     Ipv4RoutingTableEntry route =
         Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
@@ -79,6 +81,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
                                      uint32_t metric)
 {
     NS_LOG_FUNCTION(this << network << " " << networkMask << " " << interface << " " << metric);
+    m_routeGeneration++;
 
     Ipv4RoutingTableEntry route =
         Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
@@ -122,6 +125,7 @@ Ipv4StaticRouting::AddMulticastRoute(Ipv4Address origin,
 {
     NS_LOG_FUNCTION(this << origin << " " << group << " " << inputInterface << " "
                          << &outputInterfaces);
+    m_routeGeneration++;
     auto route = new Ipv4MulticastRoutingTableEntry();
     *route = Ipv4MulticastRoutingTableEntry::CreateMulticastRoute(origin,
                                                                   group,
@@ -137,6 +141,7 @@ void
 Ipv4StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
 {
     NS_LOG_FUNCTION(this << outputInterface);
+    m_routeGeneration++;
     auto route = new Ipv4RoutingTableEntry();
     Ipv4Address network("224.0.0.0");
     Ipv4Mask networkMask("240.0.0.0");
@@ -179,6 +184,7 @@ Ipv4StaticRouting::RemoveMulticastRoute(Ipv4Address origin,
                                         uint32_t inputInterface)
 {
     NS_LOG_FUNCTION(this << origin << " " << group << " " << inputInterface);
+    m_routeGeneration++;
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end(); i++)
     {
         Ipv4MulticastRoutingTableEntry* route = *i;
@@ -197,6 +203,7 @@ void
 Ipv4StaticRouting::RemoveMulticastRoute(uint32_t index)
 {
     NS_LOG_FUNCTION(this << index);
+    m_routeGeneration++;
     uint32_t tmp = 0;
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end(); i++)
     {
@@ -441,6 +448,7 @@ void
 Ipv4StaticRouting::RemoveRoute(uint32_t index)
 {
     NS_LOG_FUNCTION(this << index);
+    m_routeGeneration++;
     uint32_t tmp = 0;
     for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
     {
@@ -594,6 +602,7 @@ void
 Ipv4StaticRouting::NotifyInterfaceUp(uint32_t i)
 {
     NS_LOG_FUNCTION(this << i);
+    m_routeGeneration++;
     // If interface address and network mask have been set, add a route
     // to the network of the interface (like e.g. ifconfig does on a
     // Linux box)
@@ -615,6 +624,7 @@ void
 Ipv4StaticRouting::NotifyInterfaceDown(uint32_t i)
 {
     NS_LOG_FUNCTION(this << i);
+    m_routeGeneration++;
     // Remove all static routes that are going through this interface
     for (auto it = m_networkRoutes.begin(); it != m_networkRoutes.end();)
     {
@@ -634,6 +644,7 @@ void
 Ipv4StaticRouting::NotifyAddAddress(uint32_t interface, Ipv4InterfaceAddress address)
 {
     NS_LOG_FUNCTION(this << interface << " " << address.GetLocal());
+    m_routeGeneration++;
     if (!m_ipv4->IsUp(interface))
     {
         return;
@@ -651,6 +662,7 @@ void
 Ipv4StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress address)
 {
     NS_LOG_FUNCTION(this << interface << " " << address.GetLocal());
+    m_routeGeneration++;
     if (!m_ipv4->IsUp(interface))
     {
         return;
@@ -694,6 +706,12 @@ Ipv4StaticRouting::SetIpv4(Ptr<Ipv4> ipv4)
     }
 }
 
+uint64_t
+Ipv4StaticRouting::GetRouteGeneration() const
+{
+    return m_routeGeneration;
+}
+
 // Formatted like output of "route -n" command
 void
 Ipv4StaticRouting::PrintRoutingTable(Ptr<OutputStreamWrapper> stream, Time::Unit unit) const
@@ -85,6 +85,12 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
     void SetIpv4(Ptr<Ipv4> ipv4) override;
     void PrintRoutingTable(Ptr<OutputStreamWrapper> stream,
                            Time::Unit unit = Time::S) const override;
+    /**
+     * @brief Get the generation of the routes, changed by every route
+     * added or removed and every interface event.
+     * @returns the generation, never zero
+     */
+    uint64_t GetRouteGeneration() const override;
 
     /**
      * @brief Add a network route to the static routing table.
@@ -409,6 +415,11 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      * @brief Ipv4 reference.
      */
     Ptr<Ipv4> m_ipv4;
+
+    /**
+     * @brief Generation of the routes, see GetRouteGeneration.
+     */
+    uint64_t m_routeGeneration;
 };
 
 } // Namespace ns3
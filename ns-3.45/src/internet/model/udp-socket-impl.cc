@@ -41,6 +41,7 @@ NS_OBJECT_ENSURE_REGISTERED(UdpSocketImpl);
 // 0xffff - (sizeof(IP Header) + sizeof(UDP Header)) = 65535-(20+8) = 65507
 // \todo MAX_IPV4_UDP_DATAGRAM_SIZE is correct only for IPv4
 static const uint32_t MAX_IPV4_UDP_DATAGRAM_SIZE = 65507; //!< Maximum UDP datagram size
+static const uint32_t ROUTE_CACHE_SIZE = 1024; //!< Maximum number of cached routes
 
 // Add attributes generic to all UdpSockets to base class UdpSocket
 TypeId
@@ -77,6 +78,7 @@ UdpSocketImpl::UdpSocketImpl()
       m_shutdownSend(false),
       m_shutdownRecv(false),
       m_connected(false),
+      m_routeCacheGeneration(0),
       m_rxAvailable(0)
 {
     NS_LOG_FUNCTION(this);
@@ -515,6 +517,74 @@ UdpSocketImpl::DoSendTo(Ptr<Packet> p, Ipv4Address dest, uint16_t port, uint8_t
         return -1;
     }
 
+    TagIpv4Packet(p, dest, tos);
+    Ptr<Ipv4> ipv4 = m_node->GetObject<Ipv4>();
+
+    // Note that some systems will only send limited broadcast packets
+    // out of the "default" interface; here we send it out all interfaces
+    if (dest.IsBroadcast())
+    {
+        if (!m_allowBroadcast)
+        {
+            m_errno = ERROR_OPNOTSUPP;
+            return -1;
+        }
+        NS_LOG_LOGIC("Limited broadcast start.");
+        for (uint32_t i = 0; i < ipv4->GetNInterfaces(); i++)
+        {
+            // Get the primary address
+            Ipv4InterfaceAddress iaddr = ipv4->GetAddress(i, 0);
+            Ipv4Address addri = iaddr.GetLocal();
+            if (addri == Ipv4Address("127.0.0.1"))
+            {
+                continue;
+            }
+            // Check if interface-bound socket
+            if (m_boundnetdevice)
+            {
+                if (ipv4->GetNetDevice(i) != m_boundnetdevice)
+                {
+                    continue;
+                }
+            }
+            NS_LOG_LOGIC("Sending one copy from " << addri << " to " << dest);
+            m_udp->Send(p->Copy(), addri, dest, m_endPoint->GetLocalPort(), port);
+            NotifyDataSent(p->GetSize());
+            NotifySend(GetTxAvailable());
+        }
+        NS_LOG_LOGIC("Limited broadcast end.");
+        return p->GetSize();
+    }
+    else if (m_endPoint->GetLocalAddress() != Ipv4Address::GetAny())
+    {
+        m_udp->Send(p->Copy(),
+                    m_endPoint->GetLocalAddress(),
+                    dest,
+                    m_endPoint->GetLocalPort(),
+                    port,
+                    nullptr);
+        NotifyDataSent(p->GetSize());
+        NotifySend(GetTxAvailable());
+        return p->GetSize();
+    }
+    else if (ipv4->GetRoutingProtocol())
+    {
+        return DoSendToRoute(p, ipv4, dest, port, UpdateRouteCache(ipv4->GetRoutingProtocol()));
+    }
+    else
+    {
+        NS_LOG_ERROR("ERROR_NOROUTETOHOST");
+        m_errno = ERROR_NOROUTETOHOST;
+        return -1;
+    }
+
+    return 0;
+}
+
+void
+UdpSocketImpl::TagIpv4Packet(Ptr<Packet> p, Ipv4Address dest, uint8_t tos)
+{
+    NS_LOG_FUNCTION(this << p << dest << (uint16_t)tos);
     uint8_t priority = GetPriority();
     if (tos)
     {
@@ -532,8 +602,6 @@ UdpSocketImpl::DoSendTo(Ptr<Packet> p, Ipv4Address dest, uint16_t port, uint8_t
         p->ReplacePacketTag(priorityTag);
     }
 
-    Ptr<Ipv4> ipv4 = m_node->GetObject<Ipv4>();
-
     // Locally override the IP TTL for this socket
     // We cannot directly modify the TTL at this stage, so we set a Packet tag
     // The destination can be either multicast, unicast/anycast, or
@@ -554,6 +622,8 @@ UdpSocketImpl::DoSendTo(Ptr<Packet> p, Ipv4Address dest, uint16_t port, uint8_t
         tag.SetTtl(GetIpTtl());
         p->AddPacketTag(tag);
     }
+    // The IPv4 layer does not read this tag, lean packets go without
+    if (!Packet::IsLean())
     {
         SocketSetDontFragmentTag tag;
         bool found = p->RemovePacketTag(tag);
@@ -570,109 +640,82 @@ UdpSocketImpl::DoSendTo(Ptr<Packet> p, Ipv4Address dest, uint16_t port, uint8_t
             p->AddPacketTag(tag);
         }
     }
+}
 
-    // Note that some systems will only send limited broadcast packets
-    // out of the "default" interface; here we send it out all interfaces
-    if (dest.IsBroadcast())
+uint64_t
+UdpSocketImpl::UpdateRouteCache(Ptr<Ipv4RoutingProtocol> routingProtocol)
+{
+    NS_LOG_FUNCTION(this << routingProtocol);
+    uint64_t generation = routingProtocol->GetRouteGeneration();
+    if (generation != m_routeCacheGeneration || routingProtocol != m_routeCacheProtocol)
     {
-        if (!m_allowBroadcast)
-        {
-            m_errno = ERROR_OPNOTSUPP;
-            return -1;
-        }
-        NS_LOG_LOGIC("Limited broadcast start.");
-        for (uint32_t i = 0; i < ipv4->GetNInterfaces(); i++)
-        {
-            // Get the primary address
-            Ipv4InterfaceAddress iaddr = ipv4->GetAddress(i, 0);
-            Ipv4Address addri = iaddr.GetLocal();
-            if (addri == Ipv4Address("127.0.0.1"))
-            {
-                continue;
-            }
-            // Check if interface-bound socket
-            if (m_boundnetdevice)
-            {
-                if (ipv4->GetNetDevice(i) != m_boundnetdevice)
-                {
-                    continue;
-                }
-            }
-            NS_LOG_LOGIC("Sending one copy from " << addri << " to " << dest);
-            m_udp->Send(p->Copy(), addri, dest, m_endPoint->GetLocalPort(), port);
-            NotifyDataSent(p->GetSize());
-            NotifySend(GetTxAvailable());
-        }
-        NS_LOG_LOGIC("Limited broadcast end.");
-        return p->GetSize();
+        m_routeCache.clear();
+        m_routeCacheProtocol = routingProtocol;
+        m_routeCacheGeneration = generation;
     }
-    else if (m_endPoint->GetLocalAddress() != Ipv4Address::GetAny())
+    return generation;
+}
+
+int
+UdpSocketImpl::DoSendToRoute(Ptr<Packet> p,
+                             Ptr<Ipv4> ipv4,
+                             Ipv4Address dest,
+                             uint16_t port,
+                             uint64_t generation)
+{
+    NS_LOG_FUNCTION(this << p << dest << port << generation);
+    Ptr<Ipv4Route> route;
+    auto cached = m_routeCache.find(dest);
+    if (cached != m_routeCache.end())
     {
-        m_udp->Send(p->Copy(),
-                    m_endPoint->GetLocalAddress(),
-                    dest,
-                    m_endPoint->GetLocalPort(),
-                    port,
-                    nullptr);
-        NotifyDataSent(p->GetSize());
-        NotifySend(GetTxAvailable());
-        return p->GetSize();
+        NS_LOG_LOGIC("Cached route exists");
+        route = cached->second;
     }
-    else if (ipv4->GetRoutingProtocol())
+    else
     {
         Ipv4Header header;
         header.SetDestination(dest);
         header.SetProtocol(UdpL4Protocol::PROT_NUMBER);
         Socket::SocketErrno errno_;
-        Ptr<Ipv4Route> route;
         Ptr<NetDevice> oif = m_boundnetdevice; // specify non-zero if bound to a specific device
-        // TBD-- we could cache the route and just check its validity
         route = ipv4->GetRoutingProtocol()->RouteOutput(p, header, oif, errno_);
-        if (route)
+        if (!route)
         {
-            NS_LOG_LOGIC("Route exists");
-            if (!m_allowBroadcast)
+            NS_LOG_LOGIC("No route to destination");
+            NS_LOG_ERROR(errno_);
+            m_errno = errno_;
+            return -1;
+        }
+        NS_LOG_LOGIC("Route exists");
+        if (!m_allowBroadcast)
+        {
+            // Here we try to route subnet-directed broadcasts
+            uint32_t outputIfIndex = ipv4->GetInterfaceForDevice(route->GetOutputDevice());
+            uint32_t ifNAddr = ipv4->GetNAddresses(outputIfIndex);
+            for (uint32_t addrI = 0; addrI < ifNAddr; ++addrI)
             {
-                // Here we try to route subnet-directed broadcasts
-                uint32_t outputIfIndex = ipv4->GetInterfaceForDevice(route->GetOutputDevice());
-                uint32_t ifNAddr = ipv4->GetNAddresses(outputIfIndex);
-                for (uint32_t addrI = 0; addrI < ifNAddr; ++addrI)
+                Ipv4InterfaceAddress ifAddr = ipv4->GetAddress(outputIfIndex, addrI);
+                if (dest == ifAddr.GetBroadcast())
                 {
-                    Ipv4InterfaceAddress ifAddr = ipv4->GetAddress(outputIfIndex, addrI);
-                    if (dest == ifAddr.GetBroadcast())
-                    {
-                        m_errno = ERROR_OPNOTSUPP;
-                        return -1;
-                    }
+                    m_errno = ERROR_OPNOTSUPP;
+                    return -1;
                 }
             }
-
-            header.SetSource(route->GetSource());
-            m_udp->Send(p->Copy(),
-                        header.GetSource(),
-                        header.GetDestination(),
-                        m_endPoint->GetLocalPort(),
-                        port,
-                        route);
-            NotifyDataSent(p->GetSize());
-            return p->GetSize();
         }
-        else
+        // Zero means that the routing protocol does not support caching
+        if (generation != 0)
         {
-            NS_LOG_LOGIC("No route to destination");
-            NS_LOG_ERROR(errno_);
-            m_errno = errno_;
-            return -1;
+            if (m_routeCache.size() >= ROUTE_CACHE_SIZE)
+            {
+                m_routeCache.clear();
+            }
+            m_routeCache[dest] = route;
         }
     }
-    else
-    {
-        NS_LOG_ERROR("ERROR_NOROUTETOHOST");
-        m_errno = ERROR_NOROUTETOHOST;
-        return -1;
-    }
 
-    return 0;
+    m_udp->Send(p->Copy(), route->GetSource(), dest, m_endPoint->GetLocalPort(), port, route);
+    NotifyDataSent(p->GetSize());
+    return p->GetSize();
 }
 
 int
@@ -838,6 +881,68 @@ UdpSocketImpl::SendTo(Ptr<Packet> p, uint32_t flags, const Address& address)
     return -1;
 }
 
+int
+UdpSocketImpl::SendToMany(Ptr<Packet> p, uint32_t flags, const std::vector<Address>& toAddresses)
+{
+    NS_LOG_FUNCTION(this << p << flags << toAddresses.size());
+    Ptr<Ipv4> ipv4 = m_node->GetObject<Ipv4>();
+    if (m_endPoint == nullptr)
+    {
+        if (Bind() == -1)
+        {
+            NS_ASSERT(m_endPoint == nullptr);
+            return -1;
+        }
+        NS_ASSERT(m_endPoint != nullptr);
+    }
+    if (!ipv4 || !ipv4->GetRoutingProtocol() || m_endPoint->GetLocalAddress() != Ipv4Address::GetAny())
+    {
+        return Socket::SendToMany(p, flags, toAddresses);
+    }
+    if (m_shutdownSend)
+    {
+        m_errno = ERROR_SHUTDOWN;
+        return -1;
+    }
+    if (p->GetSize() > GetTxAvailable())
+    {
+        m_errno = ERROR_MSGSIZE;
+        return -1;
+    }
+
+    // The checks, the tags and the route cache validation are done once for
+    // the unicast peers, whose copies share the payload and only differ by the
+    // headers added below. Their routes come from the route cache, so the
+    // routing protocol is only asked the first time a peer is seen.
+    // The other peers go through SendTo () one by one.
+    uint64_t generation = UpdateRouteCache(ipv4->GetRoutingProtocol());
+    Ptr<Packet> packet = p->Copy();
+    bool tagged = false;
+    int sent = 0;
+    for (const auto& address : toAddresses)
+    {
+        if (!InetSocketAddress::IsMatchingType(address))
+        {
+            sent += (SendTo(p->Copy(), flags, address) >= 0) ? 1 : 0;
+            continue;
+        }
+        InetSocketAddress transport = InetSocketAddress::ConvertFrom(address);
+        Ipv4Address dest = transport.GetIpv4();
+        if (dest.IsBroadcast() || dest.IsMulticast())
+        {
+            sent += (SendTo(p->Copy(), flags, address) >= 0) ? 1 : 0;
+            continue;
+        }
+        if (!tagged)
+        {
+            TagIpv4Packet(packet, dest, GetIpTos());
+            tagged = true;
+        }
+        sent += (DoSendToRoute(packet, ipv4, dest, transport.GetPort(), generation) >= 0) ? 1 : 0;
+    }
+    return (sent > 0 || toAddresses.empty()) ? sent : -1;
+}
+
 uint32_t
 UdpSocketImpl::GetRxAvailable() const
 {
@@ -968,6 +1073,7 @@ UdpSocketImpl::BindToNetDevice(Ptr<NetDevice> netdevice)
     Ptr<NetDevice> oldBoundNetDevice = m_boundnetdevice;
 
     Socket::BindToNetDevice(netdevice); // Includes sanity check
+    m_routeCache.clear();
     if (m_endPoint != nullptr)
     {
         m_endPoint->BindToNetDevice(netdevice);
@@ -1228,6 +1334,7 @@ bool
 UdpSocketImpl::SetAllowBroadcast(bool allowBroadcast)
 {
     m_allowBroadcast = allowBroadcast;
+    m_routeCache.clear();
     return true;
 }
 
@@ -20,11 +20,15 @@
 
 #include <queue>
 #include <stdint.h>
+#include <unordered_map>
 
 namespace ns3
 {
 
+class Ipv4;
 class Ipv4EndPoint;
+class Ipv4Route;
+class Ipv4RoutingProtocol;
 class Ipv6EndPoint;
 class Node;
 class Packet;
@@ -96,6 +100,7 @@ class UdpSocketImpl : public UdpSocket
     uint32_t GetTxAvailable() const override;
     int Send(Ptr<Packet> p, uint32_t flags) override;
     int SendTo(Ptr<Packet> p, uint32_t flags, const Address& address) override;
+    int SendToMany(Ptr<Packet> p, uint32_t flags, const std::vector<Address>& toAddresses) override;
     uint32_t GetRxAvailable() const override;
     Ptr<Packet> Recv(uint32_t maxSize, uint32_t flags) override;
     Ptr<Packet> RecvFrom(uint32_t maxSize, uint32_t flags, Address& fromAddress) override;
@@ -198,6 +203,37 @@ class UdpSocketImpl : public UdpSocket
      * @returns 0 on success, -1 on failure
      */
     int DoSendTo(Ptr<Packet> p, Ipv4Address daddr, uint16_t dport, uint8_t tos);
+    /**
+     * @brief Add the socket tags (ToS, priority, TTL, DF) of an IPv4 packet
+     * @param p packet
+     * @param daddr destination address
+     * @param tos ToS
+     */
+    void TagIpv4Packet(Ptr<Packet> p, Ipv4Address daddr, uint8_t tos);
+    /**
+     * @brief Clear the route cache if the routes of the routing protocol changed
+     * @param routingProtocol the routing protocol of the node
+     * @returns the generation of the routing protocol, zero if its routes can not be cached
+     */
+    uint64_t UpdateRouteCache(Ptr<Ipv4RoutingProtocol> routingProtocol);
+    /**
+     * @brief Send a tagged packet to an IPv4 unicast destination through the routing protocol
+     *
+     * The route is looked up once per destination, then taken from the route
+     * cache until the generation of the routing protocol changes.
+     *
+     * @param p packet, copied
+     * @param ipv4 the IPv4 stack of the node
+     * @param daddr destination address
+     * @param dport destination port
+     * @param generation the generation returned by UpdateRouteCache
+     * @returns the size of the packet on success, -1 on failure
+     */
+    int DoSendToRoute(Ptr<Packet> p,
+                      Ptr<Ipv4> ipv4,
+                      Ipv4Address daddr,
+                      uint16_t dport,
+                      uint64_t generation);
     /**
      * @brief Send a packet to a specific destination and port (IPv6)
      * @param p packet
@@ -257,6 +293,11 @@ class UdpSocketImpl : public UdpSocket
     bool m_connected;            //!< Connection established
     bool m_allowBroadcast;       //!< Allow send broadcast packets
 
+    /// Routes of the IPv4 destinations, valid for one generation of the routing protocol
+    std::unordered_map<Ipv4Address, Ptr<Ipv4Route>, Ipv4AddressHash> m_routeCache;
+    Ptr<Ipv4RoutingProtocol> m_routeCacheProtocol; //!< Routing protocol of the cached routes
+    uint64_t m_routeCacheGeneration;               //!< Routing generation of the cached routes
+
     std::queue<std::pair<Ptr<Packet>, Address>> m_deliveryQueue; //!< Queue for incoming packets
     uint32_t m_rxAvailable; //!< Number of available bytes to be received
 
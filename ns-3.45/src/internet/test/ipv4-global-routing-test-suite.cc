@@ -30,6 +30,7 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <sstream>
 #include <vector>
 
 using namespace ns3;
@@ -489,6 +490,87 @@ TwoLanTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv4 GlobalRouting across a two tier Clos of broadcast links
+ *
+ * Two leaves, each with a host, are both connected to two spines, so the
+ * network of a remote host is reached through two equal cost paths.
+ */
+class ClosLanTest : public TestCase
+{
+  public:
+    void DoSetup() override;
+    void DoRun() override;
+    ClosLanTest();
+
+  private:
+    NodeContainer m_nodes; //!< Nodes used in the test: host, leaf, spine, spine, leaf, host.
+};
+
+ClosLanTest::ClosLanTest()
+    : TestCase("Global routing across equal cost paths (broadcast links)")
+{
+}
+
+void
+ClosLanTest::DoSetup()
+{
+    m_nodes.Create(6);
+
+    InternetStackHelper internet;
+    // By default, InternetStackHelper adds a static and global routing
+    // implementation.  We just want the global for this test.
+    Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+    internet.SetRoutingHelper(ipv4RoutingHelper);
+    internet.Install(m_nodes);
+
+    // host 0 - leaf 1, leaf 1 - spines 2 and 3, spines 2 and 3 - leaf 4, leaf 4 - host 5
+    const uint32_t links[][2] = {{0, 1}, {1, 2}, {1, 3}, {2, 4}, {3, 4}, {4, 5}};
+    SimpleNetDeviceHelper simpleHelper;
+    Ipv4AddressHelper ipv4;
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+        NetDeviceContainer net = simpleHelper.Install(m_nodes.Get(links[i][0]), channel);
+        net.Add(simpleHelper.Install(m_nodes.Get(links[i][1]), channel));
+        std::ostringstream subnet;
+        subnet << "10.1." << i << ".0";
+        ipv4.SetBase(subnet.str().c_str(), "255.255.255.0");
+        ipv4.Assign(net);
+    }
+}
+
+void
+ClosLanTest::DoRun()
+{
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    Ptr<Ipv4L3Protocol> ip1 = m_nodes.Get(1)->GetObject<Ipv4L3Protocol>();
+    NS_TEST_ASSERT_MSG_NE(ip1, nullptr, "Error-- no Ipv4 object");
+    Ptr<Ipv4GlobalRouting> globalRouting1 =
+        ip1->GetRoutingProtocol()->GetObject<Ipv4GlobalRouting>();
+    NS_TEST_ASSERT_MSG_NE(globalRouting1, nullptr, "Error-- no Ipv4GlobalRouting object");
+
+    // The leaf reaches the network of the remote host through both spines
+    std::vector<Ipv4Address> gateways;
+    for (uint32_t i = 0; i < globalRouting1->GetNRoutes(); i++)
+    {
+        Ipv4RoutingTableEntry* route = globalRouting1->GetRoute(i);
+        NS_LOG_DEBUG("ClosLanTest entry dest " << route->GetDest() << " gw " << route->GetGateway());
+        if (route->GetDest() == Ipv4Address("10.1.5.0"))
+        {
+            gateways.push_back(route->GetGateway());
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(gateways.size(), 2, "Error-- not two equal cost entries");
+    NS_TEST_EXPECT_MSG_EQ(gateways[0], Ipv4Address("10.1.1.2"), "Error-- wrong gateway");
+    NS_TEST_EXPECT_MSG_EQ(gateways[1], Ipv4Address("10.1.2.2"), "Error-- wrong gateway");
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup internet-test
  *
@@ -1294,6 +1376,7 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite()
     AddTestCase(new LanTest, TestCase::Duration::QUICK);
     AddTestCase(new TwoLinkTest, TestCase::Duration::QUICK);
     AddTestCase(new TwoLanTest, TestCase::Duration::QUICK);
+    AddTestCase(new ClosLanTest, TestCase::Duration::QUICK);
     AddTestCase(new BridgeTest, TestCase::Duration::QUICK);
     AddTestCase(new TwoBridgeTest, TestCase::Duration::QUICK);
     AddTestCase(new Ipv4DynamicGlobalRoutingTestCase, TestCase::Duration::QUICK);
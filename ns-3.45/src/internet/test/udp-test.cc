@@ -41,6 +41,7 @@
 
 #include <limits>
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -101,6 +102,89 @@ UdpSocketLoopbackTest::DoRun()
                           "second interface's address");
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief UDP Socket batched receive Test
+ */
+class UdpSocketRecvBatchTest : public TestCase
+{
+  public:
+    UdpSocketRecvBatchTest();
+    void DoRun() override;
+
+    /**
+     * @brief Receive a batch of packets.
+     * @param socket The receiving socket.
+     * @param batch The packets read from the socket.
+     */
+    void ReceiveBatch(Ptr<Socket> socket, std::span<const Socket::RecvItem> batch);
+    /**
+     * @brief Receive a packet, after the batch.
+     * @param socket The receiving socket.
+     */
+    void ReceivePkt(Ptr<Socket> socket);
+    std::vector<uint32_t> m_receivedSizes; //!< Sizes of the packets received in batches
+    uint32_t m_recvCalls;                  //!< Calls of the receive callback
+    uint32_t m_leftAfterBatch;             //!< Bytes left in the socket after a batch
+};
+
+UdpSocketRecvBatchTest::UdpSocketRecvBatchTest()
+    : TestCase("UDP batched receive test"),
+      m_recvCalls(0),
+      m_leftAfterBatch(0)
+{
+}
+
+void
+UdpSocketRecvBatchTest::ReceiveBatch(Ptr<Socket> socket, std::span<const Socket::RecvItem> batch)
+{
+    for (const auto& item : batch)
+    {
+        m_receivedSizes.push_back(item.packet->GetSize());
+        NS_TEST_EXPECT_MSG_EQ(InetSocketAddress::ConvertFrom(item.from).GetPort(),
+                              1234,
+                              "The sender address is not the one of the sending socket");
+    }
+}
+
+void
+UdpSocketRecvBatchTest::ReceivePkt(Ptr<Socket> socket)
+{
+    m_recvCalls++;
+    m_leftAfterBatch += socket->GetRxAvailable();
+}
+
+void
+UdpSocketRecvBatchTest::DoRun()
+{
+    Ptr<Node> rxNode = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.Install(rxNode);
+
+    Ptr<SocketFactory> rxSocketFactory = rxNode->GetObject<UdpSocketFactory>();
+    Ptr<Socket> rxSocket = rxSocketFactory->CreateSocket();
+    rxSocket->Bind(InetSocketAddress(Ipv4Address::GetAny(), 80));
+    rxSocket->SetRecvBatchCallback(MakeCallback(&UdpSocketRecvBatchTest::ReceiveBatch, this));
+    rxSocket->SetRecvCallback(MakeCallback(&UdpSocketRecvBatchTest::ReceivePkt, this));
+
+    Ptr<Socket> txSocket = rxSocketFactory->CreateSocket();
+    txSocket->Bind(InetSocketAddress(Ipv4Address::GetAny(), 1234));
+    for (uint32_t size : {100, 200, 300})
+    {
+        txSocket->SendTo(Create<Packet>(size), 0, InetSocketAddress("127.0.0.1", 80));
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(m_receivedSizes.size(), 3, "Not all the packets were received");
+    NS_TEST_EXPECT_MSG_EQ(m_receivedSizes[0], 100, "The packets were not received in order");
+    NS_TEST_EXPECT_MSG_EQ(m_receivedSizes[1], 200, "The packets were not received in order");
+    NS_TEST_EXPECT_MSG_EQ(m_receivedSizes[2], 300, "The packets were not received in order");
+    NS_TEST_EXPECT_MSG_EQ(m_recvCalls, 3, "The receive callback was not called after the batches");
+    NS_TEST_EXPECT_MSG_EQ(m_leftAfterBatch, 0, "The batches did not drain the socket");
+}
+
 /**
  * @ingroup internet-test
  *
@@ -192,6 +276,24 @@ class UdpSocketImplTest : public TestCase
      * @param to The destination address.
      */
     void SendDataTo(Ptr<Socket> socket, std::string to);
+    /**
+     * @brief Send data to a destination without route, which fails.
+     * @param socket The sending socket.
+     * @param to The destination address.
+     */
+    void DoSendDataToNoRoute(Ptr<Socket> socket, std::string to);
+    /**
+     * @brief Send data to several destinations at once.
+     * @param socket The sending socket.
+     * @param to The destination addresses.
+     */
+    void DoSendDataToMany(Ptr<Socket> socket, std::vector<std::string> to);
+    /**
+     * @brief Send data to several destinations at once.
+     * @param socket The sending socket.
+     * @param to The destination addresses.
+     */
+    void SendDataToMany(Ptr<Socket> socket, std::vector<std::string> to);
     /**
      * @brief Send data.
      * @param socket The sending socket.
@@ -298,6 +400,43 @@ UdpSocketImplTest::SendDataTo(Ptr<Socket> socket, std::string to)
     Simulator::Run();
 }
 
+void
+UdpSocketImplTest::DoSendDataToNoRoute(Ptr<Socket> socket, std::string to)
+{
+    Address realTo = InetSocketAddress(Ipv4Address(to.c_str()), 1234);
+    NS_TEST_EXPECT_MSG_EQ(socket->SendTo(Create<Packet>(123), 0, realTo), -1, "no route");
+    NS_TEST_EXPECT_MSG_EQ(socket->GetErrno(), Socket::ERROR_NOROUTETOHOST, "no route");
+}
+
+void
+UdpSocketImplTest::DoSendDataToMany(Ptr<Socket> socket, std::vector<std::string> to)
+{
+    std::vector<Address> realTo;
+    for (const auto& address : to)
+    {
+        realTo.emplace_back(InetSocketAddress(Ipv4Address(address.c_str()), 1234));
+    }
+    Ptr<Packet> packet = Create<Packet>(123);
+    NS_TEST_EXPECT_MSG_EQ(socket->SendToMany(packet, 0, realTo),
+                          static_cast<int>(to.size()),
+                          "all peers");
+    NS_TEST_EXPECT_MSG_EQ(packet->GetSize(), 123, "the packet is not modified");
+}
+
+void
+UdpSocketImplTest::SendDataToMany(Ptr<Socket> socket, std::vector<std::string> to)
+{
+    m_receivedPacket = Create<Packet>();
+    m_receivedPacket2 = Create<Packet>();
+    Simulator::ScheduleWithContext(socket->GetNode()->GetId(),
+                                   Seconds(0),
+                                   &UdpSocketImplTest::DoSendDataToMany,
+                                   this,
+                                   socket,
+                                   to);
+    Simulator::Run();
+}
+
 void
 UdpSocketImplTest::DoSendData(Ptr<Socket> socket)
 {
@@ -400,6 +539,31 @@ UdpSocketImplTest::DoRun()
     m_receivedPacket->RemoveAllByteTags();
     m_receivedPacket2->RemoveAllByteTags();
 
+    // Unicast to both interfaces at once
+    SendDataToMany(txSocket, {"10.0.0.1", "10.0.1.1"});
+    NS_TEST_EXPECT_MSG_EQ(m_receivedPacket->GetSize(), 123, "recv: 10.0.0.1");
+    NS_TEST_EXPECT_MSG_EQ(m_receivedPacket2->GetSize(), 123, "recv2: 10.0.1.1");
+
+    m_receivedPacket->RemoveAllByteTags();
+    m_receivedPacket2->RemoveAllByteTags();
+
+    // The route to 10.0.0.1 cached by the socket is dropped with the interface
+    Ptr<Ipv4> txIpv4 = txNode->GetObject<Ipv4>();
+    txIpv4->SetDown(1);
+    Simulator::ScheduleWithContext(txNode->GetId(),
+                                   Seconds(0),
+                                   &UdpSocketImplTest::DoSendDataToNoRoute,
+                                   this,
+                                   txSocket,
+                                   "10.0.0.1");
+    Simulator::Run();
+    txIpv4->SetUp(1);
+    SendDataTo(txSocket, "10.0.0.1");
+    NS_TEST_EXPECT_MSG_EQ(m_receivedPacket->GetSize(), 123, "route after the interface is up");
+
+    m_receivedPacket->RemoveAllByteTags();
+    m_receivedPacket2->RemoveAllByteTags();
+
     // Simple broadcast test
 
     SendDataTo(txSocket, "255.255.255.255");
@@ -762,6 +926,7 @@ class UdpTestSuite : public TestSuite
     {
         AddTestCase(new UdpSocketImplTest, TestCase::Duration::QUICK);
         AddTestCase(new UdpSocketLoopbackTest, TestCase::Duration::QUICK);
+        AddTestCase(new UdpSocketRecvBatchTest, TestCase::Duration::QUICK);
         AddTestCase(new Udp6SocketImplTest, TestCase::Duration::QUICK);
         AddTestCase(new Udp6SocketLoopbackTest, TestCase::Duration::QUICK);
     }
@@ -43,8 +43,14 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Buffer");
 
+#ifdef NS3_MTP
+thread_local uint32_t Buffer::g_recommendedStart = 0;
+#else
 uint32_t Buffer::g_recommendedStart = 0;
-#ifdef BUFFER_FREE_LIST
+#endif
+constexpr uint32_t ALLOC_OVER_PROVISION = 100; //!< Additional bytes to over-provision.
+constexpr uint32_t FREE_LIST_MIN_SIZE = 128;   //!< Storage size of the first size class.
+
 /* The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
  *  - uninitialized means that no one has created a buffer yet
@@ -61,6 +67,8 @@ uint32_t Buffer::g_recommendedStart = 0;
  * which the compiler assigns to zero-memory which is initialized to _zero_
  * before the constructors run so this ensures perfect handling of crazy
  * constructor orderings.
+ * The free lists are per thread: a storage released by another thread than
+ * the one which created it simply joins the free lists of the releasing thread.
  */
 #define MAGIC_DESTROYED (~(long)0)
 #define IS_UNINITIALIZED(x) (x == (Buffer::FreeList*)0)
@@ -68,40 +76,74 @@ uint32_t Buffer::g_recommendedStart = 0;
 #define IS_INITIALIZED(x) (!IS_UNINITIALIZED(x) && !IS_DESTROYED(x))
 #define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
 #define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList* Buffer::g_freeList = nullptr;
-Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
+thread_local Buffer::FreeList* Buffer::g_freeList = nullptr;
+thread_local Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
+
+constexpr uint32_t FREE_LIST_MAX_LENGTH = 1000;            //!< Maximum storages per class.
+constexpr uint64_t FREE_LIST_MAX_BYTES = 16 * 1024 * 1024; //!< Maximum bytes per thread.
 
 Buffer::LocalStaticDestructor::~LocalStaticDestructor()
 {
     NS_LOG_FUNCTION(this);
     if (IS_INITIALIZED(g_freeList))
     {
-        for (auto i = g_freeList->begin(); i != g_freeList->end(); i++)
+        for (auto& list : g_freeList->data)
         {
-            Buffer::Deallocate(*i);
+            for (auto i = list.begin(); i != list.end(); i++)
+            {
+                Buffer::Deallocate(*i);
+            }
         }
         delete g_freeList;
         g_freeList = DESTROYED;
     }
 }
 
+uint32_t
+Buffer::GetSizeClass(uint32_t size)
+{
+    uint32_t sizeClass = 0;
+    uint32_t classSize = FREE_LIST_MIN_SIZE;
+    while (classSize < size && sizeClass < FREE_LIST_CLASSES)
+    {
+        classSize <<= 1;
+        sizeClass++;
+    }
+    return sizeClass;
+}
+
 void
 Buffer::Recycle(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
-    NS_ASSERT(!IS_UNINITIALIZED(g_freeList));
-    g_maxSize = std::max(g_maxSize, data->m_size);
-    /* feed into free list */
-    if (data->m_size < g_maxSize || IS_DESTROYED(g_freeList) || g_freeList->size() > 1000)
+    if (IS_UNINITIALIZED(g_freeList))
     {
+        // First buffer released by a thread which did not create one
+        g_freeList = new Buffer::FreeList();
+        (void)&g_localStaticDestructor;
+    }
+
+    /* feed into the free list of its size class */
+    uint32_t sizeClass = GetSizeClass(data->m_size);
+    if (IS_DESTROYED(g_freeList) || sizeClass == FREE_LIST_CLASSES ||
+        data->m_size != (FREE_LIST_MIN_SIZE << sizeClass) ||
+        g_freeList->data[sizeClass].size() >= FREE_LIST_MAX_LENGTH ||
+        g_freeList->stats.bytesRetained + data->m_size > FREE_LIST_MAX_BYTES)
+    {
+        if (IS_INITIALIZED(g_freeList))
+        {
+            g_freeList->stats.released++;
+        }
         Buffer::Deallocate(data);
     }
     else
     {
-        NS_ASSERT(IS_INITIALIZED(g_freeList));
-        g_freeList->push_back(data);
+        FreeListStats& stats = g_freeList->stats;
+        g_freeList->data[sizeClass].push_back(data);
+        stats.recycled++;
+        stats.bytesRetained += data->m_size;
+        stats.peakBytesRetained = std::max(stats.peakBytesRetained, stats.bytesRetained);
     }
 }
 
@@ -109,47 +151,49 @@ Buffer::Data*
 Buffer::Create(uint32_t dataSize)
 {
     NS_LOG_FUNCTION(dataSize);
-    /* try to find a buffer correctly sized. */
     if (IS_UNINITIALIZED(g_freeList))
     {
         g_freeList = new Buffer::FreeList();
+        // Register the destructor of the free lists of this thread
+        (void)&g_localStaticDestructor;
     }
-    else if (IS_INITIALIZED(g_freeList))
+    /* take a storage of the size class, all of them are large enough. */
+    uint32_t sizeClass = GetSizeClass(std::max<uint32_t>(dataSize, 1) + ALLOC_OVER_PROVISION);
+    if (IS_INITIALIZED(g_freeList))
     {
-        while (!g_freeList->empty())
+        g_freeList->stats.creates++;
+        if (sizeClass < FREE_LIST_CLASSES && !g_freeList->data[sizeClass].empty())
         {
-            Buffer::Data* data = g_freeList->back();
-            g_freeList->pop_back();
-            if (data->m_size >= dataSize)
-            {
-                data->m_count = 1;
-                return data;
-            }
-            Buffer::Deallocate(data);
+            Buffer::Data* data = g_freeList->data[sizeClass].back();
+            g_freeList->data[sizeClass].pop_back();
+            g_freeList->stats.hits++;
+            g_freeList->stats.bytesRetained -= data->m_size;
+            data->m_count = 1;
+            return data;
         }
     }
     Buffer::Data* data = Buffer::Allocate(dataSize);
     NS_ASSERT(data->m_count == 1);
     return data;
 }
-#else  /* BUFFER_FREE_LIST */
-void
-Buffer::Recycle(Buffer::Data* data)
+
+Buffer::FreeListStats
+Buffer::GetFreeListStats()
 {
-    NS_LOG_FUNCTION(data);
-    NS_ASSERT(data->m_count == 0);
-    Deallocate(data);
+    return IS_INITIALIZED(g_freeList) ? g_freeList->stats : FreeListStats();
 }
 
-Buffer::Data*
-Buffer::Create(uint32_t size)
+void
+Buffer::ResetFreeListStats()
 {
-    NS_LOG_FUNCTION(size);
-    return Allocate(size);
+    if (IS_INITIALIZED(g_freeList))
+    {
+        uint64_t bytesRetained = g_freeList->stats.bytesRetained;
+        g_freeList->stats = FreeListStats();
+        g_freeList->stats.bytesRetained = bytesRetained;
+        g_freeList->stats.peakBytesRetained = bytesRetained;
+    }
 }
-#endif /* BUFFER_FREE_LIST */
-
-constexpr uint32_t ALLOC_OVER_PROVISION = 100; //!< Additional bytes to over-provision.
 
 Buffer::Data*
 Buffer::Allocate(uint32_t reqSize)
@@ -161,6 +205,12 @@ Buffer::Allocate(uint32_t reqSize)
     }
     NS_ASSERT(reqSize >= 1);
     reqSize += ALLOC_OVER_PROVISION;
+    // Round up to the size class, so that the storage can be reused by any request of the class
+    uint32_t sizeClass = GetSizeClass(reqSize);
+    if (sizeClass < FREE_LIST_CLASSES)
+    {
+        reqSize = FREE_LIST_MIN_SIZE << sizeClass;
+    }
     uint32_t size = reqSize - 1 + sizeof(Buffer::Data);
     auto b = new uint8_t[size];
     auto data = reinterpret_cast<Buffer::Data*>(b);
@@ -321,7 +371,10 @@ Buffer::AddAtStart(uint32_t start)
     {
         uint32_t newSize = GetInternalSize() + start;
         Buffer::Data* newData = Buffer::Create(newSize);
-        memcpy(newData->m_data + start, m_data->m_data + m_start, GetInternalSize());
+        // Keep room in front for the headers of the lower layers, the copies
+        // of a shared buffer would otherwise be reallocated for each of them
+        uint32_t headroom = std::min(newData->m_size - newSize, g_recommendedStart);
+        memcpy(newData->m_data + headroom + start, m_data->m_data + m_start, GetInternalSize());
         m_data->m_count--;
         if (m_data->m_count == 0)
         {
@@ -329,7 +382,7 @@ Buffer::AddAtStart(uint32_t start)
         }
         m_data = newData;
 
-        int32_t delta = start - m_start;
+        int32_t delta = headroom + start - m_start;
         m_start += delta;
         m_zeroAreaStart += delta;
         m_zeroAreaEnd += delta;
@@ -14,8 +14,6 @@
 #include <stdint.h>
 #include <vector>
 
-#define BUFFER_FREE_LIST 1
-
 namespace ns3
 {
 
@@ -633,6 +631,38 @@ class Buffer
     Buffer(uint32_t dataSize, bool initialize);
     ~Buffer();
 
+    /**
+     * @brief Statistics of the buffer data free lists of a thread.
+     */
+    struct FreeListStats
+    {
+        uint64_t creates{0};           //!< Data storages requested.
+        uint64_t hits{0};              //!< Requests served from a free list.
+        uint64_t recycled{0};          //!< Released storages kept in a free list.
+        uint64_t released{0};          //!< Released storages given back to the heap.
+        uint64_t bytesRetained{0};     //!< Bytes held by the free lists.
+        uint64_t peakBytesRetained{0}; //!< Maximum of bytesRetained.
+
+        /**
+         * @returns the fraction of the requests served from a free list.
+         */
+        double GetHitRate() const
+        {
+            return creates > 0 ? static_cast<double>(hits) / creates : 0.0;
+        }
+    };
+
+    /**
+     * @brief Get the free list statistics of the calling thread.
+     * @returns the statistics since the start of the thread or the last reset.
+     */
+    static FreeListStats GetFreeListStats();
+    /**
+     * @brief Reset the free list statistics of the calling thread, but
+     * bytesRetained which is the current state.
+     */
+    static void ResetFreeListStats();
+
   private:
     /**
      * This data structure is variable-sized through its last member whose size
@@ -756,9 +786,13 @@ class Buffer
     /**
      * location in a newly-allocated buffer where you should start
      * writing data. i.e., m_start should be initialized to this
-     * value.
+     * value. Per thread with NS3_MTP.
      */
+#ifdef NS3_MTP
+    static thread_local uint32_t g_recommendedStart;
+#else
     static uint32_t g_recommendedStart;
+#endif
 
     /**
      * offset to the start of the virtual zero area from the start
@@ -781,20 +815,32 @@ class Buffer
      */
     uint32_t m_end;
 
-#ifdef BUFFER_FREE_LIST
-    /// Container for buffer data
-    typedef std::vector<Buffer::Data*> FreeList;
+    /// Number of size classes of the free lists, from 128 to 16384 bytes.
+    static constexpr uint32_t FREE_LIST_CLASSES = 8;
 
-    /// Local static destructor structure
+    /// The free lists of a thread, one per size class.
+    struct FreeList
+    {
+        std::vector<Buffer::Data*> data[FREE_LIST_CLASSES]; //!< Free data storages per class
+        FreeListStats stats;                                //!< Statistics
+    };
+
+    /// Local static destructor structure, deletes the free lists of its thread
     struct LocalStaticDestructor
     {
         ~LocalStaticDestructor();
     };
 
-    static uint32_t g_maxSize;                            //!< Max observed data size
-    static FreeList* g_freeList;                          //!< Buffer data container
-    static LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
-#endif
+    /**
+     * @brief Get the size class of a data storage size.
+     * @param size the storage size
+     * @returns the class index, FREE_LIST_CLASSES if too large for a free list
+     */
+    static uint32_t GetSizeClass(uint32_t size);
+
+    static thread_local FreeList* g_freeList; //!< Free lists of the thread
+    static thread_local LocalStaticDestructor
+        g_localStaticDestructor; //!< Local static destructor of the thread
 };
 
 } // namespace ns3
@@ -13,7 +13,10 @@
 #include <limits>
 #include <vector>
 
+// The free list can not be shared by the threads of MultithreadedSimulatorImpl
+#ifndef NS3_MTP
 #define USE_FREE_LIST 1
+#endif
 #define FREE_LIST_SIZE 1000
 #define OFFSET_MAX (std::numeric_limits<int32_t>::max())
 
@@ -181,6 +184,24 @@ ByteTagList::operator=(const ByteTagList& o)
     return *this;
 }
 
+ByteTagList
+ByteTagList::CreateFullCopy() const
+{
+    NS_LOG_FUNCTION(this);
+    ByteTagList copy;
+    copy.m_minStart = m_minStart;
+    copy.m_maxEnd = m_maxEnd;
+    copy.m_adjustment = m_adjustment;
+    if (m_data != nullptr)
+    {
+        copy.m_data = copy.Allocate(m_used);
+        std::memcpy(&copy.m_data->data, &m_data->data, m_used);
+        copy.m_data->dirty = m_used;
+        copy.m_used = m_used;
+    }
+    return copy;
+}
+
 ByteTagList::~ByteTagList()
 {
     NS_LOG_FUNCTION(this);
@@ -165,6 +165,12 @@ class ByteTagList
     ByteTagList& operator=(const ByteTagList& o);
     ~ByteTagList();
 
+    /**
+     * @returns a copy of this ByteTagList which does not share the
+     *          tag data with it.
+     */
+    ByteTagList CreateFullCopy() const;
+
     /**
      * @param tid the typeid of the tag added
      * @param bufferSize the size of the tag when its serialization will
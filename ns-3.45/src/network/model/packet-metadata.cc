@@ -15,6 +15,7 @@
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 
+#include <cstring>
 #include <list>
 #include <utility>
 
@@ -54,6 +55,12 @@ PacketMetadata::Enable()
     m_enable = true;
 }
 
+bool
+PacketMetadata::IsEnabled()
+{
+    return m_enable;
+}
+
 void
 PacketMetadata::EnableChecking()
 {
@@ -556,6 +563,10 @@ PacketMetadata::Data*
 PacketMetadata::Create(uint32_t size)
 {
     NS_LOG_FUNCTION(size);
+#ifdef NS3_MTP
+    // The free list can not be shared by the threads of MultithreadedSimulatorImpl
+    return PacketMetadata::Allocate(size);
+#else
     NS_LOG_LOGIC("create size=" << size << ", max=" << m_maxSize);
     if (size > m_maxSize)
     {
@@ -576,12 +587,17 @@ PacketMetadata::Create(uint32_t size)
     }
     NS_LOG_LOGIC("create alloc size=" << m_maxSize);
     return PacketMetadata::Allocate(m_maxSize);
+#endif
 }
 
 void
 PacketMetadata::Recycle(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
+#ifdef NS3_MTP
+    // The free list can not be shared by the threads of MultithreadedSimulatorImpl
+    PacketMetadata::Deallocate(data);
+#else
     if (!m_enable)
     {
         PacketMetadata::Deallocate(data);
@@ -597,6 +613,7 @@ PacketMetadata::Recycle(PacketMetadata::Data* data)
     {
         m_freeList.push_back(data);
     }
+#endif
 }
 
 PacketMetadata::Data*
@@ -625,6 +642,18 @@ PacketMetadata::Deallocate(PacketMetadata::Data* data)
     delete[] buf;
 }
 
+PacketMetadata
+PacketMetadata::CreateFullCopy() const
+{
+    NS_LOG_FUNCTION(this);
+    PacketMetadata copy = *this;
+    copy.m_data->m_count--;
+    copy.m_data = PacketMetadata::Create(m_used);
+    std::memcpy(copy.m_data->m_data, m_data->m_data, m_used);
+    copy.m_data->m_dirtyEnd = m_used;
+    return copy;
+}
+
 PacketMetadata
 PacketMetadata::CreateFragment(uint32_t start, uint32_t end) const
 {
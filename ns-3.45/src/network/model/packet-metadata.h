@@ -158,6 +158,11 @@ class PacketMetadata
      * @brief Enable the packet metadata checking
      */
     static void EnableChecking();
+    /**
+     * @brief Check if the packet metadata is enabled
+     * @returns true if Enable or EnableChecking has been called
+     */
+    static bool IsEnabled();
 
     /**
      * @brief Constructor
@@ -165,6 +170,15 @@ class PacketMetadata
      * @param size size of the header
      */
     inline PacketMetadata(uint64_t uid, uint32_t size);
+    /**
+     * @brief Constructor of a metadata which only keeps the packet uid.
+     *
+     * It is used by the packets in lean mode, see Packet::EnableLean,
+     * and supports only the copy, the assignment and GetUid.
+     *
+     * @param uid packet uid
+     */
+    inline explicit PacketMetadata(uint64_t uid);
     /**
      * @brief Copy constructor
      * @param o the object to copy
@@ -181,6 +195,12 @@ class PacketMetadata
     // Delete default constructor to avoid misuse
     PacketMetadata() = delete;
 
+    /**
+     * @brief Full copy, which does not share the metadata buffer
+     * @return a copied object
+     */
+    PacketMetadata CreateFullCopy() const;
+
     /**
      * @brief Add an header
      * @param header header to add
@@ -709,6 +729,15 @@ PacketMetadata::PacketMetadata(uint64_t uid, uint32_t size)
     }
 }
 
+PacketMetadata::PacketMetadata(uint64_t uid)
+    : m_data(nullptr),
+      m_head(0xffff),
+      m_tail(0xffff),
+      m_used(0),
+      m_packetUid(uid)
+{
+}
+
 PacketMetadata::PacketMetadata(const PacketMetadata& o)
     : m_data(o.m_data),
       m_head(o.m_head),
@@ -716,7 +745,10 @@ PacketMetadata::PacketMetadata(const PacketMetadata& o)
       m_used(o.m_used),
       m_packetUid(o.m_packetUid)
 {
-    NS_ASSERT(m_data != nullptr);
+    if (m_data == nullptr)
+    {
+        return;
+    }
     NS_ASSERT(m_data->m_count < std::numeric_limits<uint32_t>::max());
     m_data->m_count++;
 }
@@ -726,16 +758,20 @@ PacketMetadata::operator=(const PacketMetadata& o)
 {
     if (m_data != o.m_data)
     {
-        // not self assignment
-        NS_ASSERT(m_data != nullptr);
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        // not self assignment, the data is null in lean mode
+        if (m_data != nullptr)
         {
-            PacketMetadata::Recycle(m_data);
+            m_data->m_count--;
+            if (m_data->m_count == 0)
+            {
+                PacketMetadata::Recycle(m_data);
+            }
         }
         m_data = o.m_data;
-        NS_ASSERT(m_data != nullptr);
-        m_data->m_count++;
+        if (m_data != nullptr)
+        {
+            m_data->m_count++;
+        }
     }
     m_head = o.m_head;
     m_tail = o.m_tail;
@@ -746,7 +782,10 @@ PacketMetadata::operator=(const PacketMetadata& o)
 
 PacketMetadata::~PacketMetadata()
 {
-    NS_ASSERT(m_data != nullptr);
+    if (m_data == nullptr)
+    {
+        return;
+    }
     m_data->m_count--;
     if (m_data->m_count == 0)
     {
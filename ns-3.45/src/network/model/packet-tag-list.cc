@@ -41,6 +41,25 @@ PacketTagList::CreateTagData(size_t dataSize)
     return tag;
 }
 
+PacketTagList
+PacketTagList::CreateFullCopy() const
+{
+    NS_LOG_FUNCTION(this);
+    PacketTagList copy;
+    TagData** prevNext = &copy.m_next;
+    for (const TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    {
+        TagData* tag = CreateTagData(cur->size);
+        tag->next = nullptr;
+        tag->count = 1;
+        tag->tid = cur->tid;
+        std::memcpy(tag->data, cur->data, cur->size);
+        *prevNext = tag;
+        prevNext = &tag->next;
+    }
+    return copy;
+}
+
 bool
 PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
 {
@@ -167,6 +167,14 @@ class PacketTagList
      */
     inline ~PacketTagList();
 
+    /**
+     * Full copy
+     *
+     * @returns a copy of this list which does not share any
+     * \ref TagData with it.
+     */
+    PacketTagList CreateFullCopy() const;
+
     /**
      * Add a tag to the head of this branch.
      *
@@ -19,7 +19,12 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Packet");
 
+#ifdef NS3_MTP
+std::atomic<uint32_t> Packet::m_globalUid = 0;
+#else
 uint32_t Packet::m_globalUid = 0;
+#endif
+bool Packet::m_lean = false;
 
 TypeId
 ByteTagIterator::Item::GetTypeId() const
@@ -125,20 +130,46 @@ Packet::Copy() const
     return Ptr<Packet>(new Packet(*this), false);
 }
 
+Ptr<Packet>
+Packet::CreateFullCopy() const
+{
+    NS_LOG_FUNCTION(this);
+    // Buffer::CreateFullCopy() may still share the data, copy the bytes
+    Buffer buffer;
+    buffer.AddAtStart(m_buffer.GetSize());
+    buffer.Begin().Write(m_buffer.Begin(), m_buffer.End());
+    Ptr<Packet> p = Ptr<Packet>(new Packet(buffer,
+                                           m_byteTagList.CreateFullCopy(),
+                                           m_packetTagList.CreateFullCopy(),
+                                           m_lean ? m_metadata : m_metadata.CreateFullCopy()),
+                                false);
+    if (m_nixVector)
+    {
+        p->m_nixVector = m_nixVector->Copy();
+    }
+    return p;
+}
+
+PacketMetadata
+Packet::CreateMetadata(uint32_t size)
+{
+    /* The upper 32 bits of the packet id in
+     * metadata is for the system id. For non-
+     * distributed simulations, this is simply
+     * zero.  The lower 32 bits are for the
+     * global UID
+     */
+    uint64_t uid = static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++;
+    return m_lean ? PacketMetadata(uid) : PacketMetadata(uid, size);
+}
+
 Packet::Packet()
     : m_buffer(),
       m_byteTagList(),
       m_packetTagList(),
-      /* The upper 32 bits of the packet id in
-       * metadata is for the system id. For non-
-       * distributed simulations, this is simply
-       * zero.  The lower 32 bits are for the
-       * global UID
-       */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, 0),
+      m_metadata(CreateMetadata(0)),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const Packet& o)
@@ -169,23 +200,16 @@ Packet::Packet(uint32_t size)
     : m_buffer(size),
       m_byteTagList(),
       m_packetTagList(),
-      /* The upper 32 bits of the packet id in
-       * metadata is for the system id. For non-
-       * distributed simulations, this is simply
-       * zero.  The lower 32 bits are for the
-       * global UID
-       */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(CreateMetadata(size)),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const uint8_t* buffer, uint32_t size, bool magic)
     : m_buffer(0, false),
       m_byteTagList(),
       m_packetTagList(),
-      m_metadata(0, 0),
+      m_metadata(m_lean ? PacketMetadata(0) : PacketMetadata(0, 0)),
       m_nixVector(nullptr)
 {
     NS_ASSERT(magic);
@@ -196,16 +220,9 @@ Packet::Packet(const uint8_t* buffer, uint32_t size)
     : m_buffer(),
       m_byteTagList(),
       m_packetTagList(),
-      /* The upper 32 bits of the packet id in
-       * metadata is for the system id. For non-
-       * distributed simulations, this is simply
-       * zero.  The lower 32 bits are for the
-       * global UID
-       */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(CreateMetadata(size)),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
     m_buffer.AddAtStart(size);
     Buffer::Iterator i = m_buffer.Begin();
     i.Write(buffer, size);
@@ -228,9 +245,13 @@ Packet::CreateFragment(uint32_t start, uint32_t length) const
 {
     NS_LOG_FUNCTION(this << start << length);
     Buffer buffer = m_buffer.CreateFragment(start, length);
+    NS_ASSERT(m_buffer.GetSize() >= start + length);
+    if (m_lean)
+    {
+        return Ptr<Packet>(new Packet(buffer, m_byteTagList, m_packetTagList, m_metadata), false);
+    }
     ByteTagList byteTagList = m_byteTagList;
     byteTagList.Adjust(-start);
-    NS_ASSERT(m_buffer.GetSize() >= start + length);
     uint32_t end = m_buffer.GetSize() - (start + length);
     PacketMetadata metadata = m_metadata.CreateFragment(start, end);
     // again, call the constructor directly rather than
@@ -259,10 +280,13 @@ Packet::AddHeader(const Header& header)
     uint32_t size = header.GetSerializedSize();
     NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << size);
     m_buffer.AddAtStart(size);
-    m_byteTagList.Adjust(size);
-    m_byteTagList.AddAtStart(size);
     header.Serialize(m_buffer.Begin());
-    m_metadata.AddHeader(header, size);
+    if (!m_lean)
+    {
+        m_byteTagList.Adjust(size);
+        m_byteTagList.AddAtStart(size);
+        m_metadata.AddHeader(header, size);
+    }
 }
 
 uint32_t
@@ -274,8 +298,11 @@ Packet::RemoveHeader(Header& header, uint32_t size)
     uint32_t deserialized = header.Deserialize(m_buffer.Begin(), end);
     NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized);
     m_buffer.RemoveAtStart(deserialized);
-    m_byteTagList.Adjust(-deserialized);
-    m_metadata.RemoveHeader(header, deserialized);
+    if (!m_lean)
+    {
+        m_byteTagList.Adjust(-deserialized);
+        m_metadata.RemoveHeader(header, deserialized);
+    }
     return deserialized;
 }
 
@@ -285,8 +312,11 @@ Packet::RemoveHeader(Header& header)
     uint32_t deserialized = header.Deserialize(m_buffer.Begin());
     NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized);
     m_buffer.RemoveAtStart(deserialized);
-    m_byteTagList.Adjust(-deserialized);
-    m_metadata.RemoveHeader(header, deserialized);
+    if (!m_lean)
+    {
+        m_byteTagList.Adjust(-deserialized);
+        m_metadata.RemoveHeader(header, deserialized);
+    }
     return deserialized;
 }
 
@@ -314,11 +344,17 @@ Packet::AddTrailer(const Trailer& trailer)
 {
     uint32_t size = trailer.GetSerializedSize();
     NS_LOG_FUNCTION(this << trailer.GetInstanceTypeId().GetName() << size);
-    m_byteTagList.AddAtEnd(GetSize());
+    if (!m_lean)
+    {
+        m_byteTagList.AddAtEnd(GetSize());
+    }
     m_buffer.AddAtEnd(size);
     Buffer::Iterator end = m_buffer.End();
     trailer.Serialize(end);
-    m_metadata.AddTrailer(trailer, size);
+    if (!m_lean)
+    {
+        m_metadata.AddTrailer(trailer, size);
+    }
 }
 
 uint32_t
@@ -327,7 +363,10 @@ Packet::RemoveTrailer(Trailer& trailer)
     uint32_t deserialized = trailer.Deserialize(m_buffer.End());
     NS_LOG_FUNCTION(this << trailer.GetInstanceTypeId().GetName() << deserialized);
     m_buffer.RemoveAtEnd(deserialized);
-    m_metadata.RemoveTrailer(trailer, deserialized);
+    if (!m_lean)
+    {
+        m_metadata.RemoveTrailer(trailer, deserialized);
+    }
     return deserialized;
 }
 
@@ -343,6 +382,11 @@ void
 Packet::AddAtEnd(Ptr<const Packet> packet)
 {
     NS_LOG_FUNCTION(this << packet << packet->GetSize());
+    if (m_lean)
+    {
+        m_buffer.AddAtEnd(packet->m_buffer);
+        return;
+    }
     m_byteTagList.AddAtEnd(GetSize());
     ByteTagList copy = packet->m_byteTagList;
     copy.AddAtStart(0);
@@ -356,6 +400,11 @@ void
 Packet::AddPaddingAtEnd(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
+    if (m_lean)
+    {
+        m_buffer.AddAtEnd(size);
+        return;
+    }
     m_byteTagList.AddAtEnd(GetSize());
     m_buffer.AddAtEnd(size);
     m_metadata.AddPaddingAtEnd(size);
@@ -366,7 +415,10 @@ Packet::RemoveAtEnd(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
     m_buffer.RemoveAtEnd(size);
-    m_metadata.RemoveAtEnd(size);
+    if (!m_lean)
+    {
+        m_metadata.RemoveAtEnd(size);
+    }
 }
 
 void
@@ -374,8 +426,11 @@ Packet::RemoveAtStart(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
     m_buffer.RemoveAtStart(size);
-    m_byteTagList.Adjust(-size);
-    m_metadata.RemoveAtStart(size);
+    if (!m_lean)
+    {
+        m_byteTagList.Adjust(-size);
+        m_metadata.RemoveAtStart(size);
+    }
 }
 
 void
@@ -444,6 +499,12 @@ Packet::ToString() const
 void
 Packet::Print(std::ostream& os) const
 {
+    if (m_lean)
+    {
+        // There is no metadata to describe the headers
+        os << "Payload (size=" << GetSize() << ")";
+        return;
+    }
     PacketMetadata::ItemIterator i = m_metadata.BeginItem(m_buffer);
     while (i.HasNext())
     {
@@ -578,6 +639,7 @@ Packet::Print(std::ostream& os) const
 PacketMetadata::ItemIterator
 Packet::BeginItem() const
 {
+    NS_ABORT_MSG_IF(m_lean, "Packet::BeginItem needs packet metadata, not kept in lean mode");
     return m_metadata.BeginItem(m_buffer);
 }
 
@@ -585,6 +647,7 @@ void
 Packet::EnablePrinting()
 {
     NS_LOG_FUNCTION_NOARGS();
+    NS_ABORT_MSG_IF(m_lean, "Packet printing needs packet metadata, not kept in lean mode");
     PacketMetadata::Enable();
 }
 
@@ -592,12 +655,28 @@ void
 Packet::EnableChecking()
 {
     NS_LOG_FUNCTION_NOARGS();
+    NS_ABORT_MSG_IF(m_lean, "Packet checking needs packet metadata, not kept in lean mode");
     PacketMetadata::EnableChecking();
 }
 
+void
+Packet::EnableLean()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    NS_ABORT_MSG_IF(PacketMetadata::IsEnabled(), "Packet metadata is enabled, can not use lean mode");
+    m_lean = true;
+}
+
+bool
+Packet::IsLean()
+{
+    return m_lean;
+}
+
 uint32_t
 Packet::GetSerializedSize() const
 {
+    NS_ABORT_MSG_IF(m_lean, "Packet serialization is not supported in lean mode");
     uint32_t size = 0;
 
     if (m_nixVector)
@@ -651,6 +730,7 @@ Packet::GetSerializedSize() const
 uint32_t
 Packet::Serialize(uint8_t* buffer, uint32_t maxSize) const
 {
+    NS_ABORT_MSG_IF(m_lean, "Packet serialization is not supported in lean mode");
     auto p = reinterpret_cast<uint32_t*>(buffer);
     uint32_t size = 0;
 
@@ -794,6 +874,7 @@ uint32_t
 Packet::Deserialize(const uint8_t* buffer, uint32_t size)
 {
     NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(m_lean, "Packet serialization is not supported in lean mode");
 
     auto p = reinterpret_cast<const uint32_t*>(buffer);
 
@@ -904,6 +985,7 @@ void
 Packet::AddByteTag(const Tag& tag) const
 {
     NS_LOG_FUNCTION(this << tag.GetInstanceTypeId().GetName() << tag.GetSerializedSize());
+    NS_ABORT_MSG_IF(m_lean, "Byte tag " << tag.GetInstanceTypeId().GetName() << " added in lean mode");
     auto list = const_cast<ByteTagList*>(&m_byteTagList);
     TagBuffer buffer = list->Add(tag.GetInstanceTypeId(), tag.GetSerializedSize(), 0, GetSize());
     tag.Serialize(buffer);
@@ -913,6 +995,7 @@ void
 Packet::AddByteTag(const Tag& tag, uint32_t start, uint32_t end) const
 {
     NS_LOG_FUNCTION(this << tag.GetInstanceTypeId().GetName() << tag.GetSerializedSize());
+    NS_ABORT_MSG_IF(m_lean, "Byte tag " << tag.GetInstanceTypeId().GetName() << " added in lean mode");
     NS_ABORT_MSG_IF(end < start, "Invalid byte range");
     auto list = const_cast<ByteTagList*>(&m_byteTagList);
     TagBuffer buffer = list->Add(tag.GetInstanceTypeId(),
@@ -949,6 +1032,7 @@ void
 Packet::AddPacketTag(const Tag& tag) const
 {
     NS_LOG_FUNCTION(this << tag.GetInstanceTypeId().GetName() << tag.GetSerializedSize());
+    NS_ABORT_MSG_IF(m_lean, "Packet tag " << tag.GetInstanceTypeId().GetName() << " added in lean mode");
     m_packetTagList.Add(tag);
 }
 
@@ -964,6 +1048,7 @@ bool
 Packet::ReplacePacketTag(Tag& tag)
 {
     NS_LOG_FUNCTION(this << tag.GetInstanceTypeId().GetName() << tag.GetSerializedSize());
+    NS_ABORT_MSG_IF(m_lean, "Packet tag " << tag.GetInstanceTypeId().GetName() << " added in lean mode");
     bool found = m_packetTagList.Replace(tag);
     return found;
 }
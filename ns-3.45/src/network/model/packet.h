@@ -23,6 +23,9 @@
 #include "ns3/ptr.h"
 
 #include <stdint.h>
+#ifdef NS3_MTP
+#include <atomic>
+#endif
 
 namespace ns3
 {
@@ -448,6 +451,18 @@ class Packet : public SimpleRefCount<Packet>
      */
     Ptr<Packet> Copy() const;
 
+    /**
+     * @brief performs a full copy of the packet.
+     *
+     * @returns a copy of the packet which shares nothing with
+     * the original one.
+     *
+     * This is what a packet handed off to another thread of
+     * MultithreadedSimulatorImpl needs: the internal datasets of
+     * a COW copy are shared, and updated in place by either copy.
+     */
+    Ptr<Packet> CreateFullCopy() const;
+
     /**
      * @brief Returns the packet's Uid.
      *
@@ -525,6 +540,25 @@ class Packet : public SimpleRefCount<Packet>
      * errors will be detected and will abort the program.
      */
     static void EnableChecking();
+    /**
+     * @brief Enable lean packets.
+     *
+     * Lean packets keep neither metadata nor tags, which saves their
+     * bookkeeping on every header added or removed, every copy and
+     * every fragment, for the simulations which send many small packets
+     * and never print or tag them. Adding a byte tag or a packet tag to
+     * a lean packet aborts the program; the lookups of tags find
+     * nothing. Printing, checking and serialization are not supported.
+     *
+     * You need to invoke this method during the simulation setup,
+     * before any packet is created.
+     */
+    static void EnableLean();
+    /**
+     * @brief Check if the packets are lean, see EnableLean.
+     * @returns true if the packets keep neither metadata nor tags.
+     */
+    static bool IsLean();
 
     /**
      * @brief Returns number of bytes required for packet
@@ -776,6 +810,13 @@ class Packet : public SimpleRefCount<Packet>
      */
     uint32_t Deserialize(const uint8_t* buffer, uint32_t size);
 
+    /**
+     * @brief Create the metadata of a new packet, with a new uid.
+     * @param size the size of the initial payload
+     * @returns the metadata, which only keeps the uid in lean mode
+     */
+    static PacketMetadata CreateMetadata(uint32_t size);
+
     Buffer m_buffer;               //!< the packet buffer (it's actual contents)
     ByteTagList m_byteTagList;     //!< the ByteTag list
     PacketTagList m_packetTagList; //!< the packet's Tag list
@@ -784,7 +825,12 @@ class Packet : public SimpleRefCount<Packet>
     /* Please see comments above about nix-vector */
     mutable Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
+#ifdef NS3_MTP
+    static std::atomic<uint32_t> m_globalUid; //!< Global counter of packets Uid
+#else
     static uint32_t m_globalUid; //!< Global counter of packets Uid
+#endif
+    static bool m_lean; //!< Packets keep neither metadata nor tags
 };
 
 /**
@@ -120,6 +120,13 @@ Socket::SetRecvCallback(Callback<void, Ptr<Socket>> receivedData)
     m_receivedData = receivedData;
 }
 
+void
+Socket::SetRecvBatchCallback(Callback<void, Ptr<Socket>, std::span<const RecvItem>> receivedBatch)
+{
+    NS_LOG_FUNCTION(this << &receivedBatch);
+    m_receivedBatch = receivedBatch;
+}
+
 int
 Socket::Send(Ptr<Packet> p)
 {
@@ -159,6 +166,21 @@ Socket::SendTo(const uint8_t* buf, uint32_t size, uint32_t flags, const Address&
     return SendTo(p, flags, toAddress);
 }
 
+int
+Socket::SendToMany(Ptr<Packet> p, uint32_t flags, const std::vector<Address>& toAddresses)
+{
+    NS_LOG_FUNCTION(this << p << flags << toAddresses.size());
+    int sent = 0;
+    for (const auto& address : toAddresses)
+    {
+        if (SendTo(p->Copy(), flags, address) >= 0)
+        {
+            sent++;
+        }
+    }
+    return (sent > 0 || toAddresses.empty()) ? sent : -1;
+}
+
 Ptr<Packet>
 Socket::Recv()
 {
@@ -291,6 +313,27 @@ void
 Socket::NotifyDataRecv()
 {
     NS_LOG_FUNCTION(this);
+    if (!m_receivedBatch.IsNull())
+    {
+        // The callback may send, and so receive, on this socket: the batch
+        // is moved out of the member while it is in use.
+        std::vector<RecvItem> batch;
+        batch.swap(m_recvBatch);
+        Address from;
+        while (Ptr<Packet> packet = RecvFrom(from))
+        {
+            batch.push_back({packet, from});
+        }
+        if (!batch.empty())
+        {
+            m_receivedBatch(this, std::span<const RecvItem>(batch));
+        }
+        batch.clear();
+        if (batch.capacity() > m_recvBatch.capacity())
+        {
+            batch.swap(m_recvBatch);
+        }
+    }
     if (!m_receivedData.IsNull())
     {
         m_receivedData(this);
@@ -310,6 +353,8 @@ Socket::DoDispose()
     m_dataSent = MakeNullCallback<void, Ptr<Socket>, uint32_t>();
     m_sendCb = MakeNullCallback<void, Ptr<Socket>, uint32_t>();
     m_receivedData = MakeNullCallback<void, Ptr<Socket>>();
+    m_receivedBatch = MakeNullCallback<void, Ptr<Socket>, std::span<const RecvItem>>();
+    m_recvBatch.clear();
 }
 
 void
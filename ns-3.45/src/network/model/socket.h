@@ -21,7 +21,9 @@
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 
+#include <span>
 #include <stdint.h>
+#include <vector>
 
 namespace ns3
 {
@@ -245,6 +247,29 @@ class Socket : public Object
      *        is passed a pointer to the socket.
      */
     void SetRecvCallback(Callback<void, Ptr<Socket>> receivedData);
+
+    /**
+     * @brief A packet read from the socket, with the address of its sender.
+     */
+    struct RecvItem
+    {
+        Ptr<Packet> packet; //!< the packet read
+        Address from;       //!< the address of the sender
+    };
+
+    /**
+     * @brief Deliver the received data to the application in batches.
+     *
+     *        When new data is available, the socket reads all the packets
+     *        queued in its receive buffer with RecvFrom () and passes them
+     *        to this callback at once, in their arrival order, before
+     *        calling the callback set with SetRecvCallback (), if any.
+     *        The span is only valid during the call.
+     * @param receivedBatch Callback for the event that data is received
+     *        from the underlying transport protocol.  This callback is
+     *        passed a pointer to the socket and the packets read.
+     */
+    void SetRecvBatchCallback(Callback<void, Ptr<Socket>, std::span<const RecvItem>> receivedBatch);
     /**
      * @brief Allocate a local endpoint for this socket.
      * @param address the address to try to allocate
@@ -380,6 +405,22 @@ class Socket : public Object
      */
     virtual int SendTo(Ptr<Packet> p, uint32_t flags, const Address& toAddress) = 0;
 
+    /**
+     * @brief Send the same data to several peers.
+     *
+     * The default implementation calls SendTo () once per peer.  Subclasses
+     * may check the socket state and tag the packet once for all the peers,
+     * the copies sharing the payload.  Unlike SendTo (), the packet is not
+     * modified, so that it can be sent again.
+     *
+     * @param p packet to send
+     * @param flags Socket control flags
+     * @param toAddresses IP Addresses of the remote hosts
+     * @returns -1 if the packet could not be sent to any peer, otherwise the
+     *          number of peers it was accepted for transmission to.
+     */
+    virtual int SendToMany(Ptr<Packet> p, uint32_t flags, const std::vector<Address>& toAddresses);
+
     /**
      * Return number of bytes which can be returned from one or
      * multiple calls to Recv.
@@ -1084,6 +1125,9 @@ class Socket : public Object
     Callback<void, Ptr<Socket>, uint32_t> m_dataSent; //!< data sent callback
     Callback<void, Ptr<Socket>, uint32_t> m_sendCb;   //!< packet sent callback
     Callback<void, Ptr<Socket>> m_receivedData;       //!< data received callback
+    Callback<void, Ptr<Socket>, std::span<const RecvItem>>
+        m_receivedBatch;                 //!< data received in batches callback
+    std::vector<RecvItem> m_recvBatch; //!< storage of the batches, reused between them
 
     uint8_t m_priority; //!< the socket priority
 
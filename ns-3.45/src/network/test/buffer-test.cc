@@ -384,6 +384,55 @@ BufferTest::DoRun()
     NS_TEST_ASSERT_MSG_EQ(val1, val2, "Bad ReadNtohU16()");
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Buffer::Data free list tests.
+ */
+class BufferFreeListTest : public TestCase
+{
+  public:
+    void DoRun() override;
+    BufferFreeListTest();
+};
+
+BufferFreeListTest::BufferFreeListTest()
+    : TestCase("Buffer free lists")
+{
+}
+
+void
+BufferFreeListTest::DoRun()
+{
+    Buffer::ResetFreeListStats();
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        Buffer buffer;
+        buffer.AddAtStart(64);
+        buffer.Begin().WriteU8(0, 64);
+    }
+    Buffer::FreeListStats stats = Buffer::GetFreeListStats();
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(stats.creates, 100, "Each buffer needs a storage");
+    NS_TEST_ASSERT_MSG_GT(stats.GetHitRate(), 0.9, "Small storages are not reused");
+    NS_TEST_ASSERT_MSG_GT(stats.bytesRetained, 0, "Small storages are not kept");
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(stats.bytesRetained,
+                                stats.peakBytesRetained,
+                                "Bad peak of the retained bytes");
+
+    // Storages above the largest size class go back to the heap
+    uint64_t bytesRetained = stats.bytesRetained;
+    {
+        Buffer buffer;
+        buffer.AddAtStart(100000);
+    }
+    stats = Buffer::GetFreeListStats();
+    NS_TEST_ASSERT_MSG_GT(stats.released, 0, "Large storage kept in a free list");
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(stats.bytesRetained,
+                                bytesRetained + 128,
+                                "Large storage kept in a free list");
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -400,6 +449,7 @@ BufferTestSuite::BufferTestSuite()
     : TestSuite("buffer", Type::UNIT)
 {
     AddTestCase(new BufferTest, TestCase::Duration::QUICK);
+    AddTestCase(new BufferFreeListTest, TestCase::Duration::QUICK);
 }
 
 static BufferTestSuite g_bufferTestSuite; //!< Static variable for test initialization
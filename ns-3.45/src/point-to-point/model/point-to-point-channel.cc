@@ -9,6 +9,9 @@
 #include "point-to-point-net-device.h"
 
 #include "ns3/log.h"
+#ifdef NS3_MTP
+#include "ns3/multithreaded-simulator-impl.h"
+#endif
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
@@ -85,11 +88,43 @@ PointToPointChannel::TransmitStart(Ptr<const Packet> p, Ptr<PointToPointNetDevic
 
     uint32_t wire = src == m_link[0].m_src ? 0 : 1;
 
-    Simulator::ScheduleWithContext(m_link[wire].m_dst->GetNode()->GetId(),
-                                   txTime + m_delay,
-                                   &PointToPointNetDevice::Receive,
-                                   m_link[wire].m_dst,
-                                   p->Copy());
+#ifdef NS3_MTP
+    // A receiver in another partition of MultithreadedSimulatorImpl may run on
+    // another thread: hand it a packet which shares no data with the copies of
+    // this node. The partitions are set before the run, so this is known at the
+    // first transmission.
+    if (m_link[wire].m_crossPartition < 0)
+    {
+        Ptr<MultithreadedSimulatorImpl> impl =
+            DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation());
+        m_link[wire].m_crossPartition =
+            impl && impl->GetPartition(src->GetNode()->GetId()) !=
+                        impl->GetPartition(m_link[wire].m_dst->GetNode()->GetId());
+    }
+    Ptr<Packet> packet = m_link[wire].m_crossPartition ? p->CreateFullCopy() : p->Copy();
+#else
+    Ptr<Packet> packet = p->Copy();
+#endif
+    Ptr<PointToPointNetDevice> dst = m_link[wire].m_dst;
+    Time rxTime = dst->GetReceiveTime(p->GetSize(), txTime);
+    if (rxTime < txTime)
+    {
+        // Cut-through: the receiver does not wait for the end of the packet
+        Simulator::ScheduleWithContext(dst->GetNode()->GetId(),
+                                       rxTime + m_delay,
+                                       &PointToPointNetDevice::ReceiveCutThrough,
+                                       dst,
+                                       packet,
+                                       txTime - rxTime);
+    }
+    else
+    {
+        Simulator::ScheduleWithContext(dst->GetNode()->GetId(),
+                                       txTime + m_delay,
+                                       &PointToPointNetDevice::Receive,
+                                       dst,
+                                       packet);
+    }
 
     // Call the tx anim callback on the net device
     m_txrxPointToPoint(p, src, m_link[wire].m_dst, txTime, txTime + m_delay);
@@ -193,6 +193,10 @@ class PointToPointChannel : public Channel
         WireState m_state{INITIALIZING};  //!< State of the link
         Ptr<PointToPointNetDevice> m_src; //!< First NetDevice
         Ptr<PointToPointNetDevice> m_dst; //!< Second NetDevice
+#ifdef NS3_MTP
+        /** Whether m_dst runs in another partition than m_src, -1 until the first transmission */
+        int8_t m_crossPartition{-1};
+#endif
     };
 
     Link m_link[N_DEVICES]; //!< Link model
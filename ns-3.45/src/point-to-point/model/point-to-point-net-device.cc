@@ -9,6 +9,7 @@
 #include "point-to-point-channel.h"
 #include "ppp-header.h"
 
+#include "ns3/boolean.h"
 #include "ns3/error-model.h"
 #include "ns3/llc-snap-header.h"
 #include "ns3/log.h"
@@ -60,6 +61,23 @@ PointToPointNetDevice::GetTypeId()
                           TimeValue(Seconds(0)),
                           MakeTimeAccessor(&PointToPointNetDevice::m_tInterframeGap),
                           MakeTimeChecker())
+            .AddAttribute("CutThroughBytes",
+                          "Hand a received packet up once its first bytes have arrived, "
+                          "as a cut-through switch port does. 0 to wait for the whole "
+                          "packet (store-and-forward). Not applied on remote channels.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&PointToPointNetDevice::m_cutThroughBytes),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("AnalyticalTx",
+                          "Do not schedule the end of a transmission which leaves the "
+                          "transmit queue empty, only the reception of the packet. The "
+                          "end is scheduled as soon as another packet is queued before "
+                          "it. The PhyTxEnd trace of such a packet is fired when its "
+                          "transmission starts, and a packet sent on an idle link does "
+                          "not go through the transmit queue.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PointToPointNetDevice::m_analyticalTx),
+                          MakeBooleanChecker())
 
             //
             // Transmit queueing discipline for the device which includes its own set
@@ -165,6 +183,10 @@ PointToPointNetDevice::GetTypeId()
 
 PointToPointNetDevice::PointToPointNetDevice()
     : m_txMachineState(READY),
+      m_cutThroughBytes(0),
+      m_rxEnd(0),
+      m_analyticalTx(false),
+      m_backgroundFlows(0),
       m_channel(nullptr),
       m_linkUp(false),
       m_currentPkt(nullptr)
@@ -238,11 +260,38 @@ PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
     m_currentPkt = p;
     m_phyTxBeginTrace(m_currentPkt);
 
+    //
+    // The wait behind the background frames is sent as part of the transmission,
+    // the link carries these frames meanwhile.
+    //
     Time txTime = m_bps.CalculateBytesTxTime(p->GetSize());
+    if (m_backgroundFlows != 0)
+    {
+        Ptr<Packet> payload = p->Copy();
+        PppHeader ppp;
+        payload->RemoveHeader(ppp);
+        txTime = GetBackgroundDelay(payload) +
+                 GetAvailableRate(payload).CalculateBytesTxTime(p->GetSize());
+    }
     Time txCompleteTime = txTime + m_tInterframeGap;
 
-    NS_LOG_LOGIC("Schedule TransmitCompleteEvent in " << txCompleteTime.As(Time::S));
-    Simulator::Schedule(txCompleteTime, &PointToPointNetDevice::TransmitComplete, this);
+    if (m_analyticalTx && m_queue->IsEmpty())
+    {
+        //
+        // Nothing to send after this packet: the end of the transmission is only
+        // scheduled if a packet is queued before it, see Send ().
+        //
+        NS_LOG_LOGIC("Transmission ends in " << txCompleteTime.As(Time::S));
+        m_txCompleteTime = Simulator::Now() + txCompleteTime;
+        m_phyTxEndTrace(m_currentPkt);
+        m_currentPkt = nullptr;
+    }
+    else
+    {
+        NS_LOG_LOGIC("Schedule TransmitCompleteEvent in " << txCompleteTime.As(Time::S));
+        m_txCompleteEvent =
+            Simulator::Schedule(txCompleteTime, &PointToPointNetDevice::TransmitComplete, this);
+    }
 
     bool result = m_channel->TransmitStart(p, this, txTime);
     if (!result)
@@ -266,10 +315,15 @@ PointToPointNetDevice::TransmitComplete()
     NS_ASSERT_MSG(m_txMachineState == BUSY, "Must be BUSY if transmitting");
     m_txMachineState = READY;
 
-    NS_ASSERT_MSG(m_currentPkt, "PointToPointNetDevice::TransmitComplete(): m_currentPkt zero");
-
-    m_phyTxEndTrace(m_currentPkt);
-    m_currentPkt = nullptr;
+    //
+    // The packets of the analytical mode have been traced at the start of their
+    // transmission.
+    //
+    if (m_currentPkt)
+    {
+        m_phyTxEndTrace(m_currentPkt);
+        m_currentPkt = nullptr;
+    }
 
     Ptr<Packet> p = m_queue->Dequeue();
     if (!p)
@@ -373,6 +427,92 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
     }
 }
 
+void
+PointToPointNetDevice::ReceiveCutThrough(Ptr<Packet> packet, Time remaining)
+{
+    NS_LOG_FUNCTION(this << packet << remaining);
+    m_rxEnd = Simulator::Now() + remaining;
+    Receive(packet);
+    m_rxEnd = Time(0);
+}
+
+Time
+PointToPointNetDevice::GetReceiveTime(uint32_t size, Time txTime) const
+{
+    if (m_cutThroughBytes == 0 || size <= m_cutThroughBytes)
+    {
+        return txTime;
+    }
+    return txTime * m_cutThroughBytes / size;
+}
+
+Time
+PointToPointNetDevice::GetReceiveEnd() const
+{
+    return std::max(m_rxEnd, Simulator::Now());
+}
+
+void
+PointToPointNetDevice::SetBackgroundRate(DataRate rate, uint32_t flows)
+{
+    NS_LOG_FUNCTION(this << rate << flows);
+    m_backgroundRate = rate;
+    m_backgroundFlows = flows;
+}
+
+void
+PointToPointNetDevice::SetBackgroundBypassCallback(BackgroundBypassCallback cb)
+{
+    NS_LOG_FUNCTION(this);
+    m_backgroundBypassCallback = cb;
+}
+
+bool
+PointToPointNetDevice::BypassesBackground(Ptr<const Packet> p) const
+{
+    return !m_backgroundBypassCallback.IsNull() && m_backgroundBypassCallback(p);
+}
+
+DataRate
+PointToPointNetDevice::GetRateLeftByBackground() const
+{
+    if (m_backgroundFlows == 0)
+    {
+        return m_bps;
+    }
+    uint64_t bps = m_bps.GetBitRate();
+    uint64_t background = m_backgroundRate.GetBitRate();
+    uint64_t left = background < bps ? bps - background : 0;
+    return DataRate(std::max<uint64_t>(left, bps / (m_backgroundFlows + 1)));
+}
+
+DataRate
+PointToPointNetDevice::GetAvailableRate(Ptr<const Packet> p) const
+{
+    return BypassesBackground(p) ? m_bps : GetRateLeftByBackground();
+}
+
+Time
+PointToPointNetDevice::GetBackgroundDelay(Ptr<const Packet> p) const
+{
+    if (m_backgroundFlows == 0)
+    {
+        return Time(0);
+    }
+
+    //
+    // At the utilization u = 1 - left / bps, an M/D/1 queue of frames of service
+    // time S waits u S / (2 (1 - u)) = S (bps - left) / (2 left) on average, and
+    // the frame being sent has u S / 2 = S (bps - left) / (2 bps) left to send.
+    //
+    int64_t frameNs =
+        m_bps.CalculateBytesTxTime(m_mtu + PppHeader().GetSerializedSize()).GetNanoSeconds();
+    uint64_t bps = m_bps.GetBitRate();
+    uint64_t left = GetRateLeftByBackground().GetBitRate();
+    uint64_t queue = BypassesBackground(p) ? bps : left;
+    return NanoSeconds(frameNs * static_cast<int64_t>(bps - left) / static_cast<int64_t>(2 * queue));
+}
+
 Ptr<Queue<Packet>>
 PointToPointNetDevice::GetQueue() const
 {
@@ -523,11 +663,40 @@ PointToPointNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t pr
 
     m_macTxTrace(packet);
 
+    //
+    // A transmission of the analytical mode has no end event: it is over, or
+    // the packet has to wait for it and the end becomes an event again.
+    //
+    if (m_txMachineState == BUSY && !m_txCompleteEvent.IsPending() &&
+        Simulator::Now() >= m_txCompleteTime)
+    {
+        m_txMachineState = READY;
+    }
+
+    //
+    // The analytical mode sends right away on an idle link, without the enqueue
+    // and dequeue whose only effect would be the queue traces and the wake up
+    // event of the NetDeviceQueue.
+    //
+    if (m_analyticalTx && m_txMachineState == READY && m_queue->IsEmpty())
+    {
+        m_snifferTrace(packet);
+        m_promiscSnifferTrace(packet);
+        return TransmitStart(packet);
+    }
+
     //
     // We should enqueue and dequeue the packet to hit the tracing hooks.
     //
     if (m_queue->Enqueue(packet))
     {
+        if (m_txMachineState == BUSY && !m_txCompleteEvent.IsPending())
+        {
+            m_txCompleteEvent = Simulator::Schedule(m_txCompleteTime - Simulator::Now(),
+                                                    &PointToPointNetDevice::TransmitComplete,
+                                                    this);
+        }
+
         //
         // If the channel is ready for transition we send the packet right now
         //
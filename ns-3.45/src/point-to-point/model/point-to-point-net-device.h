@@ -10,6 +10,7 @@
 #include "ns3/address.h"
 #include "ns3/callback.h"
 #include "ns3/data-rate.h"
+#include "ns3/event-id.h"
 #include "ns3/mac48-address.h"
 #include "ns3/net-device.h"
 #include "ns3/node.h"
@@ -143,6 +144,97 @@ class PointToPointNetDevice : public NetDevice
      */
     void Receive(Ptr<Packet> p);
 
+    /**
+     * Receive a packet of which only the first bytes have arrived.
+     *
+     * This is the method used by the channel in cut-through mode, see
+     * GetReceiveTime ().  The packet is handed up at once, GetReceiveEnd ()
+     * tells the receive callbacks when its last bit arrives.
+     *
+     * @param p Ptr to the received packet.
+     * @param remaining the time until the last bit of the packet arrives.
+     */
+    void ReceiveCutThrough(Ptr<Packet> p, Time remaining);
+
+    /**
+     * Get the time, from the start of a transmission, at which this device
+     * hands the packet up.
+     *
+     * This is the transmission time of the whole packet, or of its first
+     * CutThroughBytes bytes in cut-through mode.
+     *
+     * @param size the size of the packet, in bytes.
+     * @param txTime the transmission time of the whole packet.
+     * @returns the time at which the packet is handed up.
+     */
+    Time GetReceiveTime(uint32_t size, Time txTime) const;
+
+    /**
+     * Get the time at which the last bit of the packet being received arrives.
+     *
+     * In the receive callbacks of a cut-through device, this can be later
+     * than now, a switch must not finish sending the packet before.
+     *
+     * @returns the end of the reception of the packet, now outside of the
+     *          receive callbacks.
+     */
+    Time GetReceiveEnd() const;
+
+    /**
+     * Set the background traffic carried by the device, as fluid rates.
+     *
+     * The fluid flows are not simulated packet by packet, only their share of
+     * the link and their queue are: the packets are sent at the rate they
+     * leave, as in a fair queue the packets get at least the share of one
+     * more flow, after the wait of a packet queued behind full-sized
+     * background frames.  The longer transmissions delay the packets queued
+     * behind them.
+     *
+     * @param rate the sum of the rates of the background flows.
+     * @param flows the number of background flows, 0 for none.
+     */
+    void SetBackgroundRate(DataRate rate, uint32_t flows);
+
+    /**
+     * Callback selecting the packets served ahead of the background flows,
+     * called with the packet as given to Send ()
+     */
+    typedef Callback<bool, Ptr<const Packet>> BackgroundBypassCallback;
+
+    /**
+     * Serve some packets ahead of the background flows, as a strict priority
+     * queue disc does when the background is in a lower band.  These packets
+     * are sent at the data rate, after the rest of the background frame being
+     * sent.
+     *
+     * The queue discs remove the SocketPriorityTag before they hand a packet
+     * to a single queue device, the callback finds the class of the packet
+     * from its headers.
+     *
+     * @param cb the callback, null for none.
+     */
+    void SetBackgroundBypassCallback(BackgroundBypassCallback cb);
+
+    /**
+     * Get the rate at which a packet is sent, the data rate less the share of
+     * the background flows unless the packet bypasses them.
+     *
+     * @param p the packet, without the PPP header.
+     * @returns the rate available to the packet.
+     */
+    DataRate GetAvailableRate(Ptr<const Packet> p) const;
+
+    /**
+     * Get the time a packet waits behind the background flows before its
+     * transmission: the mean wait of an M/D/1 queue of full-sized frames at
+     * the background utilization, or the mean rest of the frame being sent if
+     * the packet bypasses the background.
+     *
+     * @param p the packet, without the PPP header.
+     * @returns the wait of the packet, zero without background flows.
+     */
+    Time GetBackgroundDelay(Ptr<const Packet> p) const;
+
     // The remaining methods are documented in ns3::NetDevice*
 
     void SetIfIndex(const uint32_t index) override;
@@ -283,6 +375,64 @@ class PointToPointNetDevice : public NetDevice
      */
     Time m_tInterframeGap;
 
+    /**
+     * The number of bytes of a packet after which it is handed up, 0 for
+     * the whole packet
+     */
+    uint32_t m_cutThroughBytes;
+
+    /**
+     * The time at which the last bit of the packet handed up in cut-through
+     * mode arrives
+     */
+    Time m_rxEnd;
+
+    /**
+     * Do not schedule the end of the transmissions which leave the queue empty
+     */
+    bool m_analyticalTx;
+
+    /**
+     * The end of the current transmission, if it is not scheduled
+     */
+    Time m_txCompleteTime;
+
+    /**
+     * The event of the end of the current transmission
+     */
+    EventId m_txCompleteEvent;
+
+    /**
+     * The sum of the rates of the background flows
+     */
+    DataRate m_backgroundRate;
+
+    /**
+     * The number of background flows
+     */
+    uint32_t m_backgroundFlows;
+
+    /**
+     * Selects the packets served ahead of the background flows
+     */
+    BackgroundBypassCallback m_backgroundBypassCallback;
+
+    /**
+     * Whether a packet is served ahead of the background flows
+     *
+     * @param p the packet, without the PPP header.
+     * @returns true if m_backgroundBypassCallback selects it.
+     */
+    bool BypassesBackground(Ptr<const Packet> p) const;
+
+    /**
+     * Get the rate left to the packets by the background flows, at least the
+     * share of one more flow
+     *
+     * @returns the data rate less the rate of the background flows.
+     */
+    DataRate GetRateLeftByBackground() const;
+
     /**
      * The PointToPointChannel to which this PointToPointNetDevice has been
      * attached.
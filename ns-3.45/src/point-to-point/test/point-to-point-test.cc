@@ -6,14 +6,18 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 
+#include "ns3/boolean.h"
 #include "ns3/drop-tail-queue.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/point-to-point-channel.h"
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/simulator.h"
+#include "ns3/socket.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
 
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -128,6 +132,327 @@ PointToPointTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @brief Base class of the tests of a link between two PointToPointNetDevice
+ *
+ * The sender sends one byte per microsecond over a channel of 5 us, and the
+ * receiver records when it hands the packets up.
+ */
+class PointToPointLinkTestCase : public TestCase
+{
+  protected:
+    /**
+     * @brief Create the test
+     *
+     * @param name The name of the test.
+     */
+    PointToPointLinkTestCase(std::string name);
+
+    /**
+     * @brief Create the nodes, their devices and the channel
+     */
+    void CreateLink();
+    /**
+     * @brief Send a packet of 1000 bytes, 1002 with the PPP header
+     *
+     * @param when The time to send the packet.
+     * @param p The packet, a new one if null.
+     */
+    void SendPacket(Time when, Ptr<Packet> p = nullptr);
+    /**
+     * @brief Callback function which records the reception time
+     *
+     * @param dev The receiving device.
+     * @param pkt The received packet.
+     * @param mode The protocol mode used.
+     * @param sender The sender address.
+     *
+     * @return A boolean indicating packet handled properly.
+     */
+    virtual bool RxPacket(Ptr<NetDevice> dev,
+                          Ptr<const Packet> pkt,
+                          uint16_t mode,
+                          const Address& sender);
+
+    Ptr<PointToPointNetDevice> m_sender;   //!< the sending device
+    Ptr<PointToPointNetDevice> m_receiver; //!< the receiving device
+    std::vector<Time> m_rxTimes;           //!< times at which the packets were received
+};
+
+PointToPointLinkTestCase::PointToPointLinkTestCase(std::string name)
+    : TestCase(name)
+{
+}
+
+void
+PointToPointLinkTestCase::CreateLink()
+{
+    Ptr<Node> a = CreateObject<Node>();
+    Ptr<Node> b = CreateObject<Node>();
+    m_sender = CreateObject<PointToPointNetDevice>();
+    m_receiver = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel>();
+    channel->SetAttribute("Delay", TimeValue(MicroSeconds(5)));
+
+    m_sender->SetDataRate(DataRate("8Mbps"));
+    m_sender->Attach(channel);
+    m_sender->SetAddress(Mac48Address::Allocate());
+    m_sender->SetQueue(CreateObject<DropTailQueue<Packet>>());
+    m_receiver->Attach(channel);
+    m_receiver->SetAddress(Mac48Address::Allocate());
+    m_receiver->SetQueue(CreateObject<DropTailQueue<Packet>>());
+
+    a->AddDevice(m_sender);
+    b->AddDevice(m_receiver);
+
+    m_receiver->SetReceiveCallback(MakeCallback(&PointToPointLinkTestCase::RxPacket, this));
+    m_rxTimes.clear();
+}
+
+void
+PointToPointLinkTestCase::SendPacket(Time when, Ptr<Packet> p)
+{
+    Simulator::Schedule(when,
+                        &PointToPointNetDevice::Send,
+                        m_sender,
+                        p ? p : Create<Packet>(1000),
+                        m_sender->GetBroadcast(),
+                        0x800);
+}
+
+bool
+PointToPointLinkTestCase::RxPacket(Ptr<NetDevice> dev,
+                                   Ptr<const Packet> pkt,
+                                   uint16_t mode,
+                                   const Address& sender)
+{
+    m_rxTimes.push_back(Simulator::Now());
+    return true;
+}
+
+/**
+ * @brief Test class for the cut-through mode of the PointToPoint model
+ *
+ * It sends one packet over a PointToPointChannel to a device which hands
+ * packets up after their first bytes, and checks the reception times.
+ */
+class PointToPointCutThroughTest : public PointToPointLinkTestCase
+{
+  public:
+    /**
+     * @brief Create the test
+     */
+    PointToPointCutThroughTest();
+
+    /**
+     * @brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    Time m_rxEnd; //!< end of the reception, as told by the device
+
+    bool RxPacket(Ptr<NetDevice> dev,
+                  Ptr<const Packet> pkt,
+                  uint16_t mode,
+                  const Address& sender) override;
+};
+
+PointToPointCutThroughTest::PointToPointCutThroughTest()
+    : PointToPointLinkTestCase("PointToPoint cut-through")
+{
+}
+
+bool
+PointToPointCutThroughTest::RxPacket(Ptr<NetDevice> dev,
+                                     Ptr<const Packet> pkt,
+                                     uint16_t mode,
+                                     const Address& sender)
+{
+    m_rxEnd = DynamicCast<PointToPointNetDevice>(dev)->GetReceiveEnd();
+    return PointToPointLinkTestCase::RxPacket(dev, pkt, mode, sender);
+}
+
+void
+PointToPointCutThroughTest::DoRun()
+{
+    CreateLink();
+    m_receiver->SetAttribute("CutThroughBytes", UintegerValue(22));
+    SendPacket(Seconds(1));
+
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_rxTimes.size(), 1, "The packet was not received");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[0],
+                          Seconds(1) + MicroSeconds(5 + 22),
+                          "The packet is not handed up after its first bytes");
+    NS_TEST_EXPECT_MSG_EQ(m_rxEnd,
+                          Seconds(1) + MicroSeconds(5 + 1002),
+                          "The end of the reception is not the one of a whole packet");
+    NS_TEST_EXPECT_MSG_EQ(m_receiver->GetReceiveEnd(),
+                          Simulator::Now(),
+                          "The end of the reception is kept after the receive callback");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Test class for the analytical transmit mode of the PointToPoint model
+ *
+ * It sends two packets back to back then a third one on an idle link, and
+ * checks that they are received at the same times as without the analytical
+ * mode, with fewer events.
+ */
+class PointToPointAnalyticalTxTest : public PointToPointLinkTestCase
+{
+  public:
+    /**
+     * @brief Create the test
+     */
+    PointToPointAnalyticalTxTest();
+
+    /**
+     * @brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    /**
+     * @brief Send the packets over a link and record their reception times
+     *
+     * @param analyticalTx Value of the AnalyticalTx attribute of the sender.
+     * @return The number of events of the simulation.
+     */
+    uint64_t SendPackets(bool analyticalTx);
+};
+
+PointToPointAnalyticalTxTest::PointToPointAnalyticalTxTest()
+    : PointToPointLinkTestCase("PointToPoint analytical transmit")
+{
+}
+
+uint64_t
+PointToPointAnalyticalTxTest::SendPackets(bool analyticalTx)
+{
+    CreateLink();
+    m_sender->SetAttribute("AnalyticalTx", BooleanValue(analyticalTx));
+    for (Time sendTime : {Seconds(1), Seconds(1), Seconds(1) + MilliSeconds(5)})
+    {
+        SendPacket(sendTime);
+    }
+
+    Simulator::Run();
+    uint64_t events = Simulator::GetEventCount();
+    Simulator::Destroy();
+    return events;
+}
+
+void
+PointToPointAnalyticalTxTest::DoRun()
+{
+    uint64_t events = SendPackets(false);
+    std::vector<Time> rxTimes = m_rxTimes;
+    uint64_t analyticalEvents = SendPackets(true);
+
+    NS_TEST_ASSERT_MSG_EQ(m_rxTimes.size(), 3, "Not all the packets were received");
+    for (uint32_t i = 0; i < rxTimes.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_rxTimes[i], rxTimes[i], "The reception times differ");
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[1],
+                          Seconds(1) + MicroSeconds(2 * 1002 + 5),
+                          "The second packet did not wait for the first one");
+    // Only the end of the first transmission, which has a packet behind, is an event
+    NS_TEST_EXPECT_MSG_EQ(analyticalEvents + 2, events, "The idle transmissions have events");
+}
+
+/**
+ * @brief Test class for the background rate of the PointToPoint model
+ *
+ * It sends one packet without background flows, one with background flows
+ * leaving most of the link, one with background flows above the data rate,
+ * and a high priority one with the same flows, and checks that each waits
+ * behind the background frames and is sent at the rate left to it.
+ */
+class PointToPointBackgroundRateTest : public PointToPointLinkTestCase
+{
+  public:
+    /**
+     * @brief Create the test
+     */
+    PointToPointBackgroundRateTest();
+
+    /**
+     * @brief Run the test
+     */
+    void DoRun() override;
+};
+
+PointToPointBackgroundRateTest::PointToPointBackgroundRateTest()
+    : PointToPointLinkTestCase("PointToPoint background rate")
+{
+}
+
+void
+PointToPointBackgroundRateTest::DoRun()
+{
+    CreateLink();
+    // 6Mbps left by one flow, then 2Mbps, the share of one more flow among three
+    // which ask for more than the link
+    Simulator::Schedule(Seconds(2),
+                        &PointToPointNetDevice::SetBackgroundRate,
+                        m_sender,
+                        DataRate("2Mbps"),
+                        1);
+    Simulator::Schedule(Seconds(3),
+                        &PointToPointNetDevice::SetBackgroundRate,
+                        m_sender,
+                        DataRate("12Mbps"),
+                        3);
+    // The last packet is of the priority served ahead of the background
+    m_sender->SetBackgroundBypassCallback(
+        PointToPointNetDevice::BackgroundBypassCallback([](Ptr<const Packet> p) {
+            SocketPriorityTag priorityTag;
+            return p->PeekPacketTag(priorityTag) &&
+                   priorityTag.GetPriority() >= Socket::NS3_PRIO_INTERACTIVE;
+        }));
+    SocketPriorityTag priorityTag;
+    priorityTag.SetPriority(Socket::NS3_PRIO_INTERACTIVE);
+    Ptr<Packet> priorityPacket = Create<Packet>(1000);
+    priorityPacket->AddPacketTag(priorityTag);
+    for (uint32_t i = 1; i <= 4; i++)
+    {
+        SendPacket(Seconds(i) + MicroSeconds(1), i < 4 ? nullptr : priorityPacket);
+    }
+
+    Simulator::Run();
+
+    // The background frames of 1502 bytes take 1502us at the data rate. The wait
+    // behind them is 1502us * (8 - 6) / (2 * 6) and 1502us * (8 - 2) / (2 * 2),
+    // and 1502us * (8 - 2) / (2 * 8) for the rest of the frame being sent.
+    NS_TEST_ASSERT_MSG_EQ(m_rxTimes.size(), 4, "Not all the packets were received");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[0],
+                          Seconds(1) + MicroSeconds(1 + 1002 + 5),
+                          "The packet without background flows is not sent at the data rate");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[1],
+                          Seconds(2) + MicroSeconds(1 + 1336 + 5) + NanoSeconds(250333),
+                          "The packet is not sent at the rate left by the background flows");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[2],
+                          Seconds(3) + MicroSeconds(1 + 4008 + 5) + NanoSeconds(2253000),
+                          "The packet is not sent at the share of one more flow");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[3],
+                          Seconds(4) + MicroSeconds(1 + 1002 + 5) + NanoSeconds(563250),
+                          "The high priority packet is not sent ahead of the background flows");
+    NS_TEST_EXPECT_MSG_EQ(m_sender->GetAvailableRate(Create<Packet>(1000)),
+                          DataRate("2Mbps"),
+                          "Wrong available rate");
+    NS_TEST_EXPECT_MSG_EQ(m_sender->GetAvailableRate(priorityPacket),
+                          DataRate("8Mbps"),
+                          "Wrong available rate of the high priority packets");
+
+    Simulator::Destroy();
+}
+
 /**
  * @brief TestSuite for PointToPoint module
  */
@@ -144,6 +469,9 @@ PointToPointTestSuite::PointToPointTestSuite()
     : TestSuite("devices-point-to-point", Type::UNIT)
 {
     AddTestCase(new PointToPointTest, TestCase::Duration::QUICK);
+    AddTestCase(new PointToPointCutThroughTest, TestCase::Duration::QUICK);
+    AddTestCase(new PointToPointAnalyticalTxTest, TestCase::Duration::QUICK);
+    AddTestCase(new PointToPointBackgroundRateTest, TestCase::Duration::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
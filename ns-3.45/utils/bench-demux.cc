@@ -0,0 +1,101 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program benchmarks the demultiplexing of received IPv4 datagrams
+// to the bound end points, as UdpL4Protocol::Receive does, with many
+// sockets on a node: one end point per local port, a fraction of them
+// connected to a peer as TCP connections and connected UDP sockets are.
+// Sample usage:  ./ns3 run 'bench-demux --endpoints=10000 --n=1000000'
+
+#include "ns3/command-line.h"
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t endpoints = 10000;
+    uint64_t n = 1000000;
+    double connected = 0.5;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark Ipv4EndPointDemux::Lookup with many bound end points.\n"
+              "\n"
+              "Binds --endpoints end points on ephemeral ports, connects a\n"
+              "fraction of them to a peer, then looks up --n datagrams sent\n"
+              "to random bound ports, from the peer for the connected ones.");
+    cmd.AddValue("endpoints", "number of bound end points, up to 16383", endpoints);
+    cmd.AddValue("n", "number of datagrams to demultiplex", n);
+    cmd.AddValue("connected", "fraction of the end points connected to a peer", connected);
+    cmd.Parse(argc, argv);
+
+    Ipv4Address local("10.0.0.1");
+    Ipv4Address peer("10.0.1.1");
+    Ipv4EndPointDemux demux;
+    std::vector<Ipv4EndPoint*> bound;
+
+    SystemWallClockMs clock;
+    clock.Start();
+    for (uint32_t i = 0; i < endpoints; i++)
+    {
+        Ipv4EndPoint* endPoint = demux.Allocate();
+        if (endPoint == nullptr)
+        {
+            std::cerr << "Out of ephemeral ports after " << i << " end points" << std::endl;
+            return 1;
+        }
+        if (i < endpoints * connected)
+        {
+            endPoint->SetLocalAddress(local);
+            endPoint->SetPeer(peer, 1000 + i);
+        }
+        bound.push_back(endPoint);
+    }
+    int64_t bindMs = clock.End();
+
+    // The datagrams, generated before the measurement
+    std::mt19937 random(1);
+    std::uniform_int_distribution<uint32_t> pick(0, bound.size() - 1);
+    std::vector<uint32_t> targets(n);
+    for (auto& target : targets)
+    {
+        target = pick(random);
+    }
+
+    Ptr<Ipv4Interface> incomingInterface = CreateObject<Ipv4Interface>();
+    uint64_t found = 0;
+    clock.Start();
+    for (uint32_t target : targets)
+    {
+        Ipv4EndPoint* endPoint = bound[target];
+        bool isConnected = endPoint->GetPeerPort() != 0;
+        Ipv4EndPointDemux::EndPoints matches =
+            demux.Lookup(local,
+                         endPoint->GetLocalPort(),
+                         isConnected ? peer : Ipv4Address("10.0.2.1"),
+                         isConnected ? endPoint->GetPeerPort() : 5000,
+                         incomingInterface);
+        found += matches.size();
+    }
+    int64_t lookupMs = clock.End();
+
+    std::cout << std::left << std::setw(12) << "endpoints" << std::setw(12) << "datagrams"
+              << std::setw(12) << "found" << std::setw(12) << "bind (ms)" << std::setw(12)
+              << "demux (ms)"
+              << "datagrams/s" << std::endl;
+    std::cout << std::setw(12) << endpoints << std::setw(12) << n << std::setw(12) << found
+              << std::setw(12) << bindMs << std::setw(12) << lookupMs
+              << (lookupMs > 0 ? n * 1000 / lookupMs : 0) << std::endl;
+
+    return found == n ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program benchmarks the injection of events into a running
+// simulation from other threads, with Simulator::ScheduleWithContext(),
+// as when traces are fed in by reader threads.
+// Sample usage:  ./ns3 run 'bench-inject --producers=8 --n=1000000'
+
+#include "ns3/command-line.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace ns3;
+
+namespace
+{
+
+/** Number of injected events run by the simulator, main thread only. */
+uint64_t g_received = 0;
+
+/** Number of events to wait for. */
+uint64_t g_expected = 0;
+
+/** Set to start the producers together. */
+std::atomic<bool> g_go{false};
+
+/** An injected event. */
+void
+Injected()
+{
+    g_received++;
+}
+
+/**
+ * Keep the simulation running until all the injected events are in.
+ * Injected events are taken in after every event, so this is also the
+ * polling loop of the main thread.
+ */
+void
+Poll()
+{
+    if (g_received < g_expected)
+    {
+        Simulator::Schedule(NanoSeconds(1), &Poll);
+    }
+}
+
+/**
+ * Inject events from a producer thread.
+ * @param [in] context The context of the events.
+ * @param [in] n The number of events.
+ */
+void
+Produce(uint32_t context, uint64_t n)
+{
+    while (!g_go.load(std::memory_order_acquire))
+    {
+        std::this_thread::yield();
+    }
+    for (uint64_t i = 0; i < n; i++)
+    {
+        Simulator::ScheduleWithContext(context, NanoSeconds(i % 1000), &Injected);
+    }
+}
+
+/**
+ * Run one measurement.
+ * @param [in] producers The number of producer threads.
+ * @param [in] n The number of events per producer.
+ * @returns The elapsed wall clock time, in ms.
+ */
+int64_t
+Bench(uint32_t producers, uint64_t n)
+{
+    g_received = 0;
+    g_expected = producers * n;
+    g_go = false;
+    Simulator::Schedule(NanoSeconds(1), &Poll);
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < producers; i++)
+    {
+        threads.emplace_back(&Produce, i, n);
+    }
+
+    SystemWallClockMs clock;
+    clock.Start();
+    g_go = true;
+    Simulator::Run();
+    int64_t elapsed = clock.End();
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    Simulator::Destroy();
+    return elapsed;
+}
+
+} // unnamed namespace
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t producers = 4;
+    uint64_t n = 1000000;
+    uint32_t runs = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the injection of events from other threads.\n"
+              "\n"
+              "Runs with 1, 2, 4... up to --producers threads, each scheduling\n"
+              "--n events with Simulator::ScheduleWithContext() while the\n"
+              "main thread runs the simulation.");
+    cmd.AddValue("producers", "maximum number of producer threads", producers);
+    cmd.AddValue("n", "number of events per producer", n);
+    cmd.AddValue("runs", "number of runs per producer count", runs);
+    cmd.Parse(argc, argv);
+
+    std::cout << std::left << std::setw(12) << "producers" << std::setw(12) << "events"
+              << std::setw(12) << "time (ms)"
+              << "events/s" << std::endl;
+    uint32_t p = 1;
+    while (true)
+    {
+        for (uint32_t run = 0; run < runs; run++)
+        {
+            int64_t elapsed = Bench(p, n);
+            uint64_t events = p * n;
+            std::cout << std::setw(12) << p << std::setw(12) << events << std::setw(12) << elapsed
+                      << (elapsed > 0 ? events * 1000 / elapsed : 0) << std::endl;
+        }
+        if (p >= producers)
+        {
+            break;
+        }
+        p = std::min(2 * p, producers);
+    }
+    return 0;
+}
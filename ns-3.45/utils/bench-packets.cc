@@ -8,6 +8,7 @@
 
 // This program can be used to benchmark packet serialization/deserialization
 // operations using Headers and Tags, for various numbers of packets 'n'
+// The Buffer::Data free list statistics are printed after each benchmark.
 // Sample usage:  ./ns3 run 'bench-packets --n=10000'
 
 #include "ns3/command-line.h"
@@ -292,6 +293,24 @@ benchC(uint32_t n)
     }
 }
 
+static void
+benchSmall(uint32_t n)
+{
+    BenchHeader<25> ipv4;
+    BenchHeader<8> udp;
+
+    // Small payloads, like the consensus messages of sync-paxos
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(64);
+        p->AddHeader(udp);
+        p->AddHeader(ipv4);
+        Ptr<Packet> o = p->Copy();
+        o->RemoveHeader(ipv4);
+        o->RemoveHeader(udp);
+    }
+}
+
 static void
 benchFragment(uint32_t n)
 {
@@ -353,6 +372,7 @@ static void
 runBench(void (*bench)(uint32_t), uint32_t n, uint32_t minIterations, const char* name)
 {
     uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    Buffer::ResetFreeListStats();
     for (uint32_t i = 0; i < minIterations; i++)
     {
         uint64_t delay = runBenchOneIteration(bench, n);
@@ -361,8 +381,12 @@ runBench(void (*bench)(uint32_t), uint32_t n, uint32_t minIterations, const char
     double ps = n;
     ps *= 1000;
     ps /= minDelay;
+    Buffer::FreeListStats stats = Buffer::GetFreeListStats();
     std::cout << ps << " packets/s"
               << " (" << minDelay << " ms elapsed)\t" << name << std::endl;
+    std::cout << "\tBuffer::Data: " << stats.creates << " created, " << stats.hits
+              << " from the free list (" << stats.GetHitRate() * 100 << "%), "
+              << stats.peakBytesRetained << " bytes retained at most" << std::endl;
 }
 
 int
@@ -394,6 +418,7 @@ main(int argc, char* argv[])
     runBench(&benchB, n, minIterations, "Just add headers");
     runBench(&benchC, n, minIterations, "Remove by func call");
     runBench(&benchD, n, minIterations, "Intermixed add/remove headers and tags");
+    runBench(&benchSmall, n, minIterations, "Small packets, copy, remove headers");
     runBench(&benchFragment, n, minIterations, "Fragmentation and concatenation");
     runBench(&benchByteTags, n, minIterations, "Benchmark byte tags");
 
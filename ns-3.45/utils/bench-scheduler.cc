@@ -7,6 +7,7 @@
  */
 
 #include "ns3/core-module.h"
+#include "ns3/event-trace.h"
 
 #include <cmath> // sqrt
 #include <fstream>
@@ -270,6 +271,7 @@ BenchSuite::BenchSuite(ObjectFactory& factory,
     {
         m_scheduler += " (default)";
     }
+    m_scheduler += std::string(", events ") + (EventImpl::IsPoolingEnabled() ? "pooled" : "not pooled");
 
     Bench bench(pop, total);
     bench.SetRandomStream(eventStream);
@@ -373,6 +375,135 @@ BenchSuite::Log() const
     LOG("");
 }
 
+/**
+ *  Replay of a recorded event trace against a single scheduler type.
+ *
+ *  The trace is the exact sequence of event queue operations of a real
+ *  simulation, recorded with the DefaultSimulatorImpl TraceFile attribute.
+ */
+class ReplaySuite
+{
+  public:
+    /**
+     * Perform the runs for a single scheduler type.
+     *
+     * @param [in] factory Factory pre-configured to create the desired Scheduler.
+     * @param [in] records The recorded operations.
+     * @param [in] runs The number of replications.
+     */
+    ReplaySuite(ObjectFactory& factory,
+                const std::vector<EventTraceRecord>& records,
+                uint64_t runs);
+
+    /** Write the average to \c LOG() */
+    void Log() const;
+
+  private:
+    /**
+     * Replay the trace once.
+     *
+     * @param [in] scheduler The scheduler to drive.
+     * @returns The run time (s).
+     */
+    double Run(Ptr<Scheduler> scheduler);
+
+    const std::vector<EventTraceRecord>& m_records; /**< The recorded operations. */
+    std::string m_scheduler;                        /**< Descriptive string for the scheduler. */
+    std::vector<double> m_times;                    /**< Run time (s) of each run. */
+    uint64_t m_mismatches;                          /**< Events run out of the recorded order. */
+
+}; // ReplaySuite
+
+ReplaySuite::ReplaySuite(ObjectFactory& factory,
+                         const std::vector<EventTraceRecord>& records,
+                         uint64_t runs)
+    : m_records(records),
+      m_mismatches(0)
+{
+    m_scheduler = factory.GetTypeId().GetName() + ": replay";
+
+    LOG("");
+    LOG(m_scheduler);
+    LOG(std::left << std::setw(g_fwidth) << "Run #" << std::setw(g_fwidth) << "Time (s)"
+                  << std::setw(g_fwidth) << "Rate (op/s)"
+                  << "Per (s/op)");
+
+    // Prime, then the actual runs
+    for (uint64_t i = 0; i <= runs; i++)
+    {
+        double time = Run(factory.Create<Scheduler>());
+        double ops = m_records.size();
+        if (i == 0)
+        {
+            LOG(std::left << std::setw(g_fwidth) << "prime" << std::setw(g_fwidth) << time
+                          << std::setw(g_fwidth) << ops / time << time / ops);
+            continue;
+        }
+        m_times.push_back(time);
+        LOG(std::left << std::setw(g_fwidth) << i - 1 << std::setw(g_fwidth) << time
+                      << std::setw(g_fwidth) << ops / time << time / ops);
+    }
+}
+
+double
+ReplaySuite::Run(Ptr<Scheduler> scheduler)
+{
+    SystemWallClockMs timer;
+    Scheduler::Event ev;
+    ev.impl = nullptr;
+    ev.key.m_context = 0;
+
+    timer.Start();
+    for (const auto& record : m_records)
+    {
+        ev.key.m_ts = record.ts;
+        ev.key.m_uid = record.uid;
+        switch (record.op)
+        {
+        case EventTraceRecord::INSERT:
+            scheduler->Insert(ev);
+            break;
+        case EventTraceRecord::REMOVE_NEXT:
+            if (scheduler->RemoveNext().key.m_uid != record.uid)
+            {
+                m_mismatches++;
+            }
+            break;
+        case EventTraceRecord::REMOVE:
+            scheduler->Remove(ev);
+            break;
+        case EventTraceRecord::CANCEL:
+            // Cancelled events stay in the queue
+            break;
+        }
+    }
+    return timer.End() / 1000.0;
+}
+
+void
+ReplaySuite::Log() const
+{
+    if (m_mismatches > 0)
+    {
+        LOGME(" warning: " << m_mismatches << " events replayed out of the recorded order");
+    }
+    if (m_times.size() < 2)
+    {
+        LOG("");
+        return;
+    }
+
+    double average = 0;
+    for (auto time : m_times)
+    {
+        average += time / m_times.size();
+    }
+    double ops = m_records.size();
+    LOG(std::left << std::setw(g_fwidth) << "average" << std::setw(g_fwidth) << average
+                  << std::setw(g_fwidth) << ops / average << average / ops);
+    LOG("");
+}
+
 /**
  *  Create a RandomVariableStream to generate next event delays.
  *
@@ -446,12 +577,16 @@ main(int argc, char* argv[])
     bool schedList = false;
     bool schedMap = false; // default scheduler
     bool schedPQ = false;
+    bool schedWheel = false;
 
     uint64_t pop = 100000;
     uint64_t total = 1000000;
     uint64_t runs = 1;
     std::string filename = "";
     bool calRev = false;
+    bool noPool = false;
+    bool poolCmp = false;
+    std::string replay = "";
 
     CommandLine cmd(__FILE__);
     cmd.Usage("Benchmark the simulator scheduler.\n"
@@ -463,6 +598,10 @@ main(int argc, char* argv[])
               "In the case of either --file form, the input is expected\n"
               "to be ascii, giving the relative event times in ns.\n"
               "\n"
+              "Alternatively --replay=\"<filename>\" replays an event trace,\n"
+              "recorded by running a simulation with\n"
+              "--ns3::DefaultSimulatorImpl::TraceFile=\"<filename>\".\n"
+              "\n"
               "If no scheduler is specified the MapScheduler will be run.");
     cmd.AddValue("all", "use all schedulers", allSched);
     cmd.AddValue("cal", "use CalendarScheduler", schedCal);
@@ -471,12 +610,16 @@ main(int argc, char* argv[])
     cmd.AddValue("list", "use ListScheduler", schedList);
     cmd.AddValue("map", "use MapScheduler (default)", schedMap);
     cmd.AddValue("pri", "use PriorityQueue", schedPQ);
+    cmd.AddValue("wheel", "use TimingWheelScheduler", schedWheel);
     cmd.AddValue("debug", "enable debugging output", g_debug);
     cmd.AddValue("pop", "event population size", pop);
     cmd.AddValue("total", "total number of events to run", total);
     cmd.AddValue("runs", "number of runs", runs);
     cmd.AddValue("file", "file of relative event times", filename);
     cmd.AddValue("prec", "printed output precision", g_fwidth);
+    cmd.AddValue("nopool", "allocate events without the EventImpl pools", noPool);
+    cmd.AddValue("poolcmp", "run each scheduler with and without event pooling", poolCmp);
+    cmd.AddValue("replay", "event trace to replay instead of random events", replay);
     cmd.Parse(argc, argv);
 
     g_me = cmd.GetName() + ": ";
@@ -487,36 +630,70 @@ main(int argc, char* argv[])
     LOG("  Event population size:        " << pop);
     LOG("  Total events per run:         " << total);
     LOG("  Number of runs per scheduler: " << runs);
+    LOG("  Event pooling:                "
+        << (poolCmp ? "compare" : (noPool ? "disabled" : "enabled")));
     DEB("debugging is ON");
 
     if (allSched)
     {
-        schedCal = schedHeap = schedList = schedMap = schedPQ = true;
+        schedCal = schedHeap = schedList = schedMap = schedPQ = schedWheel = true;
     }
     // Set the default case if nothing else is set
-    if (!(schedCal || schedHeap || schedList || schedMap || schedPQ))
+    if (!(schedCal || schedHeap || schedList || schedMap || schedPQ || schedWheel))
     {
         schedMap = true;
     }
 
-    auto eventStream = GetRandomStream(filename);
+    Ptr<RandomVariableStream> eventStream;
+    std::vector<EventTraceRecord> records;
+    if (replay.empty())
+    {
+        eventStream = GetRandomStream(filename);
+    }
+    else
+    {
+        LOG("  Event trace:                  from " << replay);
+        if (!EventTraceReader::Read(replay, records))
+        {
+            LOGME(" can not read event trace " << replay);
+            return 1;
+        }
+        LOG("    Found " << records.size() << " operations");
+    }
+
+    // Run a suite, once per pooling setting when comparing
+    auto runSuite = [&](ObjectFactory& f, uint64_t t, bool rev) {
+        if (!replay.empty())
+        {
+            ReplaySuite(f, records, runs).Log();
+            return;
+        }
+        EventImpl::SetPoolingEnabled(!noPool);
+        BenchSuite(f, pop, t, runs, eventStream, rev).Log();
+        if (poolCmp)
+        {
+            EventImpl::SetPoolingEnabled(noPool);
+            BenchSuite(f, pop, t, runs, eventStream, rev).Log();
+            EventImpl::SetPoolingEnabled(!noPool);
+        }
+    };
 
     ObjectFactory factory("ns3::MapScheduler");
     if (schedCal)
     {
         factory.SetTypeId("ns3::CalendarScheduler");
         factory.Set("Reverse", BooleanValue(calRev));
-        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        runSuite(factory, total, calRev);
         if (allSched)
         {
             factory.Set("Reverse", BooleanValue(!calRev));
-            BenchSuite(factory, pop, total, runs, eventStream, !calRev).Log();
+            runSuite(factory, total, !calRev);
         }
     }
     if (schedHeap)
     {
         factory.SetTypeId("ns3::HeapScheduler");
-        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        runSuite(factory, total, calRev);
     }
     if (schedList)
     {
@@ -527,17 +704,22 @@ main(int argc, char* argv[])
             LOG("Running List scheduler with 1/10 total events");
             listTotal /= 10;
         }
-        BenchSuite(factory, pop, listTotal, runs, eventStream, calRev).Log();
+        runSuite(factory, listTotal, calRev);
     }
     if (schedMap)
     {
         factory.SetTypeId("ns3::MapScheduler");
-        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        runSuite(factory, total, calRev);
     }
     if (schedPQ)
     {
         factory.SetTypeId("ns3::PriorityQueueScheduler");
-        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        runSuite(factory, total, calRev);
+    }
+    if (schedWheel)
+    {
+        factory.SetTypeId("ns3::TimingWheelScheduler");
+        runSuite(factory, total, calRev);
     }
 
     return 0;
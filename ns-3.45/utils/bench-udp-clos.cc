@@ -0,0 +1,167 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program benchmarks the forwarding of small UDP datagrams across a
+// two-tier Clos fabric of point-to-point links: every host sends to a host
+// of the next leaf, so each datagram goes UDP, IPv4, then four hops over
+// host-leaf-spine-leaf-host, then IPv4 and UDP again. It reports the
+// datagrams delivered per wall clock second, with or without lean packets
+// and the analytical transmit mode of the point-to-point devices.
+// Sample usage:  ./ns3 run 'bench-udp-clos --n=1000000 --lean=1 --analytical=1'
+
+#include "ns3/boolean.h"
+#include "ns3/command-line.h"
+#include "ns3/config.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-global-routing-helper.h"
+#include "ns3/packet.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/udp-socket-factory.h"
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+static uint64_t g_received = 0; //!< Datagrams delivered to the hosts
+
+static void
+Receive(Ptr<Socket> socket)
+{
+    while (socket->Recv())
+    {
+        g_received++;
+    }
+}
+
+static void
+Send(Ptr<Socket> socket, Address to, uint32_t size, uint32_t remaining, Time interval)
+{
+    socket->SendTo(Create<Packet>(size), 0, to);
+    if (remaining > 1)
+    {
+        Simulator::Schedule(interval, &Send, socket, to, size, remaining - 1, interval);
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t spines = 2;
+    uint32_t leaves = 4;
+    uint32_t hostsPerLeaf = 4;
+    uint32_t n = 100000;
+    uint32_t size = 64;
+    std::string interval = "10us";
+    bool lean = false;
+    bool analytical = false;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the forwarding of small UDP datagrams across a Clos fabric.\n"
+              "\n"
+              "Every host sends --n / hosts datagrams of --size bytes to a host of\n"
+              "the next leaf, one per --interval, over 1Gbps point-to-point links.");
+    cmd.AddValue("spines", "number of spine switches", spines);
+    cmd.AddValue("leaves", "number of leaf switches, at least 2", leaves);
+    cmd.AddValue("hostsPerLeaf", "number of hosts per leaf switch", hostsPerLeaf);
+    cmd.AddValue("n", "number of datagrams to send", n);
+    cmd.AddValue("size", "payload size of the datagrams, in bytes", size);
+    cmd.AddValue("interval", "time between two datagrams of a host", interval);
+    cmd.AddValue("lean", "use lean packets, without metadata nor tags", lean);
+    cmd.AddValue("analytical", "no transmit end events on the idle links", analytical);
+    cmd.Parse(argc, argv);
+
+    if (spines == 0 || leaves < 2 || hostsPerLeaf == 0)
+    {
+        std::cerr << "The fabric needs at least one spine, two leaves and one host per leaf"
+                  << std::endl;
+        return 1;
+    }
+    if (lean)
+    {
+        Packet::EnableLean();
+    }
+    if (analytical)
+    {
+        Config::SetDefault("ns3::PointToPointNetDevice::AnalyticalTx", BooleanValue(true));
+    }
+
+    SystemWallClockMs clock;
+    clock.Start();
+    NodeContainer spineNodes(spines);
+    NodeContainer leafNodes(leaves);
+    NodeContainer hostNodes(leaves * hostsPerLeaf);
+    InternetStackHelper internet;
+    internet.Install(spineNodes);
+    internet.Install(leafNodes);
+    internet.Install(hostNodes);
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("1us"));
+    for (uint32_t i = 0; i < spines; i++)
+    {
+        for (uint32_t j = 0; j < leaves; j++)
+        {
+            std::ostringstream subnet;
+            subnet << "10." << i << "." << j << ".0";
+            Ipv4AddressHelper ipv4(subnet.str().c_str(), "255.255.255.0");
+            ipv4.Assign(p2p.Install(spineNodes.Get(i), leafNodes.Get(j)));
+        }
+    }
+    std::vector<Ipv4Address> hostAddresses;
+    for (uint32_t i = 0; i < leaves; i++)
+    {
+        for (uint32_t j = 0; j < hostsPerLeaf; j++)
+        {
+            std::ostringstream subnet;
+            subnet << "20." << i << "." << j << ".0";
+            Ipv4AddressHelper ipv4(subnet.str().c_str(), "255.255.255.0");
+            Ipv4InterfaceContainer interfaces =
+                ipv4.Assign(p2p.Install(leafNodes.Get(i), hostNodes.Get(i * hostsPerLeaf + j)));
+            hostAddresses.push_back(interfaces.GetAddress(1));
+        }
+    }
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    uint32_t hosts = hostNodes.GetN();
+    uint32_t perHost = (n + hosts - 1) / hosts;
+    for (uint32_t i = 0; i < hosts; i++)
+    {
+        Ptr<Socket> socket = Socket::CreateSocket(hostNodes.Get(i), UdpSocketFactory::GetTypeId());
+        socket->Bind(InetSocketAddress(Ipv4Address::GetAny(), 9));
+        socket->SetRecvCallback(MakeCallback(&Receive));
+        Address to = InetSocketAddress(hostAddresses[(i + hostsPerLeaf) % hosts], 9);
+        // Spread the first datagrams so that the hosts do not send in lockstep
+        Time start = MilliSeconds(1) + Time(interval) * i / hosts;
+        Simulator::Schedule(start, &Send, socket, to, size, perHost, Time(interval));
+    }
+    int64_t setupMs = clock.End();
+
+    clock.Start();
+    Simulator::Run();
+    int64_t runMs = clock.End();
+    uint64_t events = Simulator::GetEventCount();
+    Simulator::Destroy();
+
+    std::cout << std::left << std::setw(12) << "hosts" << std::setw(12) << "datagrams"
+              << std::setw(12) << "received" << std::setw(12) << "events" << std::setw(12)
+              << "setup (ms)" << std::setw(12) << "run (ms)"
+              << "datagrams/s" << (lean ? " (lean)" : "") << (analytical ? " (analytical)" : "")
+              << std::endl;
+    std::cout << std::setw(12) << hosts << std::setw(12) << perHost * hosts << std::setw(12)
+              << g_received << std::setw(12) << events << std::setw(12) << setupMs
+              << std::setw(12) << runMs << (runMs > 0 ? g_received * 1000 / runMs : 0)
+              << std::endl;
+
+    return g_received == perHost * hosts ? 0 : 1;
+}
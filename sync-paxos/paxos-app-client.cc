@@ -3,11 +3,15 @@
 NS_LOG_COMPONENT_DEFINE("PaxosAppClient");
 
 PaxosAppClient::PaxosAppClient()
+    : m_useSequencer(false), m_sequencerPort(0), m_conflictRate(0),
+      m_readRatio(0), m_readFromLeader(false), m_readLeaderId(0), m_ipTos(0)
 {
     NS_LOG_FUNCTION(this);
 }
 
 PaxosAppClient::PaxosAppClient(NodeInfoList nodes)
+    : m_useSequencer(false), m_sequencerPort(0), m_conflictRate(0),
+      m_readRatio(0), m_readFromLeader(false), m_readLeaderId(0), m_ipTos(0)
 {
     NS_LOG_FUNCTION(this);
     m_servers = nodes;
@@ -42,6 +46,12 @@ PaxosAppClient::StartApplication(void)
         NS_FATAL_ERROR("Failed to create UDP socket");
     }
 
+    // Mark the requests so that the fabric can prioritize them
+    if (m_ipTos != 0)
+    {
+        m_socket->SetIpTos(m_ipTos);
+    }
+
     // Connect to each server
     for (auto server : m_servers)
     {
@@ -58,6 +68,9 @@ PaxosAppClient::StartApplication(void)
     m_valueRandom->SetAttribute("Min", ns3::DoubleValue(1));
     m_valueRandom->SetAttribute("Max", ns3::DoubleValue(1000000000)); // Random value between 1 and 100
 
+    m_conflictRandom = ns3::CreateObject<ns3::UniformRandomVariable>();
+    m_readRandom = ns3::CreateObject<ns3::UniformRandomVariable>();
+
     SendRequest();
 
 }
@@ -92,23 +105,50 @@ PaxosAppClient::SendRequest()
     std::shared_ptr<RequestFrame> request = std::make_shared<RequestFrame>();
     request->SetTimestamp(ns3::Simulator::Now());
     request->SetValue(m_valueRandom->GetInteger()); // Random value between 1 and 100
+    if (m_conflictRate > 0 && m_conflictRandom->GetValue() < m_conflictRate)
+    {
+        // Hot key: a non-zero multiple of PAXOS_NUM_KEYS
+        request->SetValue(PAXOS_NUM_KEYS * m_conflictRandom->GetInteger(1, 1000000000 / PAXOS_NUM_KEYS));
+    }
+
+    bool isRead = m_readRatio > 0 && m_readRandom->GetValue() < m_readRatio;
+    if (isRead)
+    {
+        request->SetOperation(RequestFrame::READ);
+    }
 
     // Create Packet
     NS_LOG_INFO("Request Frame created with Timestamp " << request->GetTimestamp() << ", Value " << request->GetValue()); 
     ns3::Ptr<ns3::Packet> packet = ns3::Create<ns3::Packet>();
     packet->AddHeader(*request);
 
-    // Round Robin
-    uint32_t curServerId = (m_lastServerId + 1) % m_servers.size();
-    m_lastServerId = curServerId;
-    NS_LOG_INFO("Sending Request to server " << curServerId << " at " << ns3::Simulator::Now() << " seconds");
+    ns3::Ipv4Address address;
+    uint16_t port;
+    if (m_useSequencer)
+    {
+        address = m_sequencerAddress;
+        port = m_sequencerPort;
+    }
+    else if (isRead && m_readFromLeader)
+    {
+        address = m_servers[m_readLeaderId].address;
+        port = m_servers[m_readLeaderId].serverPort;
+    }
+    else
+    {
+        // Round Robin
+        uint32_t curServerId = (m_lastServerId + 1) % m_servers.size();
+        m_lastServerId = curServerId;
+        NS_LOG_INFO("Sending Request to server " << curServerId << " at " << ns3::Simulator::Now() << " seconds");
 
-    ns3::Ipv4Address address = m_servers[curServerId].address;
-    uint16_t port = m_servers[curServerId].serverPort;
+        address = m_servers[curServerId].address;
+        port = m_servers[curServerId].serverPort;
+    }
 
     NS_LOG_INFO("Sending Request to " << address << ":" << port << "");
     ns3::InetSocketAddress to(address, port);
     m_socket->SendTo(packet, 0, to);
+    PaxosTracer::Record(PAXOS_TRACE_REQUEST_SENT, GetNode()->GetId(), request->GetTimestamp().GetNanoSeconds(), request->GetTimestamp());
 
     // Generate a random number between 1 and 10
     uint32_t interval = m_sendRandom->GetInteger();
@@ -123,4 +163,41 @@ PaxosAppClient::SetSendInterval(ns3::Time interval)
 {
     NS_LOG_FUNCTION(this);
     m_sendInterval = interval;
-}
\ No newline at end of file
+}
+void
+PaxosAppClient::SetSequencer(ns3::Ipv4Address address, uint16_t port)
+{
+    NS_LOG_FUNCTION(this);
+    m_useSequencer = true;
+    m_sequencerAddress = address;
+    m_sequencerPort = port;
+}
+
+void
+PaxosAppClient::SetConflictRate(double conflictRate)
+{
+    NS_LOG_FUNCTION(this);
+    m_conflictRate = conflictRate;
+}
+
+void
+PaxosAppClient::SetReadRatio(double readRatio)
+{
+    NS_LOG_FUNCTION(this);
+    m_readRatio = readRatio;
+}
+
+void
+PaxosAppClient::SetReadLeader(uint32_t leaderId)
+{
+    NS_LOG_FUNCTION(this);
+    m_readFromLeader = true;
+    m_readLeaderId = leaderId;
+}
+
+void
+PaxosAppClient::SetIpTos(uint8_t ipTos)
+{
+    NS_LOG_FUNCTION(this << static_cast<uint32_t>(ipTos));
+    m_ipTos = ipTos;
+}
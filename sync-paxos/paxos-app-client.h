@@ -10,6 +10,7 @@
 
 #include "paxos-common.h"
 #include "paxos-frame.h"
+#include "paxos-trace.h"
 
 // The PaxosAppClient class implements a client application that sends
 // requests to the PaxosApp server.
@@ -29,15 +30,35 @@ public:
     void StopApplication(void) override;
 
     void SetSendInterval(ns3::Time interval);
+    // Send all requests to the sequencer instead of round robin over the servers
+    void SetSequencer(ns3::Ipv4Address address, uint16_t port);
+    // Fraction of requests on the hot key (key 0), see PAXOS_NUM_KEYS
+    void SetConflictRate(double conflictRate);
+    // Fraction of requests that are reads
+    void SetReadRatio(double readRatio);
+    // Send reads to the leader only, the leader holds the read lease in async mode
+    void SetReadLeader(uint32_t leaderId);
+    // IP TOS of the requests, 0 leaves them unmarked
+    void SetIpTos(uint8_t ipTos);
 
 private:
     void SendRequest();
     uint32_t m_lastServerId; // ID of the last server that the client sent a request to 
     NodeInfoList m_servers; // List of all servers in the network
     ns3::Time m_sendInterval; // Interval between sending requests  
+    bool m_useSequencer; // Whether requests go to the sequencer
+    ns3::Ipv4Address m_sequencerAddress; // Address of the sequencer
+    uint16_t m_sequencerPort; // Port of the sequencer
     ns3::Ptr<ns3::Socket> m_socket;
     ns3::Ptr<ns3::RandomVariableStream> m_sendRandom; // Random variable for request intervals
     ns3::Ptr<ns3::RandomVariableStream> m_valueRandom; // Random variable for request values
+    double m_conflictRate; // Fraction of requests on the hot key
+    ns3::Ptr<ns3::UniformRandomVariable> m_conflictRandom; // Random variable for picking the hot key
+    double m_readRatio; // Fraction of requests that are reads
+    bool m_readFromLeader; // Whether reads go to the leader only
+    uint32_t m_readLeaderId; // ID of the leader serving reads
+    ns3::Ptr<ns3::UniformRandomVariable> m_readRandom; // Random variable for picking reads
+    uint8_t m_ipTos; // IP TOS of the requests, 0 means unmarked
 };
 
 #endif // _PAXOS_APP_CLIENT_H_
@@ -0,0 +1,426 @@
+#include "paxos-app-server.h"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("PaxosAppServerLeaderless");
+
+// Leaderless mode (EPaxos style)
+// Every replica is the command leader of the requests it receives. The leader
+// sends PreAccept with the conflicting instances it knows (deps) and a seq
+// number. Each replica adds its own conflicts and answers. If a fast quorum
+// agrees with the leader's attributes, the instance commits after one round
+// trip. Otherwise the leader merges the answers and runs an Accept round with
+// a majority (slow path). Committed instances are executed in dependency
+// order: strongly connected components in seq order.
+// Recovery of a failed command leader is not modeled.
+
+// Replies (without the leader) needed for the fast quorum F + floor((F + 1) / 2)
+static uint32_t FastQuorumReplies(uint32_t numNodes)
+{
+    uint32_t f = (numNodes - 1) / 2;
+    uint32_t fastQuorum = f + (f + 1) / 2;
+    return fastQuorum > 0 ? fastQuorum - 1 : 0;
+}
+
+// Replies (without the leader) needed for a majority
+static uint32_t SlowQuorumReplies(uint32_t numNodes)
+{
+    return numNodes / 2;
+}
+
+void PaxosAppServer::ReceiveLeaderlessMessage(ns3::Ptr<ns3::Socket>,
+                                              std::span<const ns3::Socket::RecvItem> batch)
+{
+    for (const auto &item : batch)
+    {
+        LeaderlessFrame frame;
+        item.packet->RemoveHeader(frame);
+
+        NS_LOG_INFO("PaxosAppServer " << m_nodeId << " received leaderless message " << frame.GetMessageType()
+                                      << " for instance " << frame.GetReplicaId() << "." << frame.GetInstance());
+
+        switch (frame.GetMessageType())
+        {
+        case LeaderlessFrame::PRE_ACCEPT:
+            DoReceivedPreAccept(frame);
+            break;
+        case LeaderlessFrame::PRE_ACCEPT_OK:
+            DoReceivedPreAcceptOk(frame);
+            break;
+        case LeaderlessFrame::ACCEPT:
+            DoReceivedLeaderlessAccept(frame);
+            break;
+        case LeaderlessFrame::ACCEPT_OK:
+            DoReceivedLeaderlessAcceptOk(frame);
+            break;
+        case LeaderlessFrame::COMMIT:
+            DoReceivedCommit(frame);
+            break;
+        default:
+            NS_FATAL_ERROR("Unknown packet type");
+            return;
+        }
+    }
+}
+
+void PaxosAppServer::DoLeaderlessPropose()
+{
+    // If App is all ready stopped, do not propose
+    if (ns3::Simulator::Now() >= m_stopTime || m_waitingProposals.empty())
+    {
+        return;
+    }
+
+    std::shared_ptr<Proposal> proposal = m_waitingProposals.front();
+    m_waitingProposals.pop();
+
+    LeaderlessInstanceId id(m_serverId, m_nextInstance++);
+    uint64_t seq = 1;
+    std::vector<uint64_t> deps(m_numNodes, 0);
+    UpdateLeaderlessAttributes(id, proposal->getValue(), seq, deps);
+
+    LeaderlessFrame frame;
+    frame.SetValue(proposal->getValue());
+    frame.SetSeq(seq);
+    frame.SetDeps(deps);
+    frame.SetProposeTime(proposal->getCreateTime());
+    RecordLeaderlessInstance(id, frame, LeaderlessInstance::PRE_ACCEPTED);
+
+    NS_LOG_INFO("PaxosAppServer " << m_serverId << " pre-accepting instance " << id.first << "." << id.second
+                                  << " seq " << seq);
+    PaxosTracer::Record(PAXOS_TRACE_PRE_ACCEPT, m_nodeId, id.second, proposal->getCreateTime());
+
+    if (FastQuorumReplies(m_numNodes) == 0)
+    {
+        m_numFastCommits++;
+        CommitLeaderlessInstance(id);
+        return;
+    }
+
+    for (auto node : m_nodes)
+    {
+        if (node.serverId != m_serverId)
+        {
+            SendLeaderlessMessage(id, LeaderlessFrame::PRE_ACCEPT, node.serverId);
+        }
+    }
+}
+
+void PaxosAppServer::DoReceivedPreAccept(LeaderlessFrame frame)
+{
+    LeaderlessInstanceId id(frame.GetReplicaId(), frame.GetInstance());
+
+    // Add the conflicts known by this replica
+    uint64_t seq = frame.GetSeq();
+    std::vector<uint64_t> deps = frame.GetDeps();
+    deps.resize(m_numNodes, 0);
+    UpdateLeaderlessAttributes(id, frame.GetValue(), seq, deps);
+    frame.SetSeq(seq);
+    frame.SetDeps(deps);
+    RecordLeaderlessInstance(id, frame, LeaderlessInstance::PRE_ACCEPTED);
+
+    SendLeaderlessMessage(id, LeaderlessFrame::PRE_ACCEPT_OK, id.first);
+}
+
+void PaxosAppServer::DoReceivedPreAcceptOk(LeaderlessFrame frame)
+{
+    LeaderlessInstanceId id(frame.GetReplicaId(), frame.GetInstance());
+    auto it = m_instances.find(id);
+    if (it == m_instances.end() || it->second.status != LeaderlessInstance::PRE_ACCEPTED)
+    {
+        // Late reply, the instance already moved on
+        return;
+    }
+
+    LeaderlessInstance &instance = it->second;
+    instance.numReplies++;
+
+    std::vector<uint64_t> deps = frame.GetDeps();
+    deps.resize(m_numNodes, 0);
+    if (frame.GetSeq() != instance.seq || deps != instance.deps)
+    {
+        // Merge the attributes for the slow path
+        instance.fastPath = false;
+        instance.seq = std::max(instance.seq, frame.GetSeq());
+        for (uint32_t r = 0; r < m_numNodes; r++)
+        {
+            instance.deps[r] = std::max(instance.deps[r], deps[r]);
+        }
+    }
+
+    if (instance.numReplies < FastQuorumReplies(m_numNodes))
+    {
+        return;
+    }
+
+    if (instance.fastPath)
+    {
+        NS_LOG_INFO("PaxosAppServer " << m_serverId << " instance " << id.first << "." << id.second << " fast path");
+        PaxosTracer::Record(PAXOS_TRACE_FAST_COMMIT, m_nodeId, id.second, instance.createTime);
+        m_numFastCommits++;
+        CommitLeaderlessInstance(id);
+        return;
+    }
+
+    NS_LOG_INFO("PaxosAppServer " << m_serverId << " instance " << id.first << "." << id.second << " slow path");
+    PaxosTracer::Record(PAXOS_TRACE_SLOW_COMMIT, m_nodeId, id.second, instance.createTime);
+    instance.status = LeaderlessInstance::ACCEPTED;
+    instance.numReplies = 0;
+    for (auto node : m_nodes)
+    {
+        if (node.serverId != m_serverId)
+        {
+            SendLeaderlessMessage(id, LeaderlessFrame::ACCEPT, node.serverId);
+        }
+    }
+}
+
+void PaxosAppServer::DoReceivedLeaderlessAccept(LeaderlessFrame frame)
+{
+    LeaderlessInstanceId id(frame.GetReplicaId(), frame.GetInstance());
+    RecordLeaderlessInstance(id, frame, LeaderlessInstance::ACCEPTED);
+    SendLeaderlessMessage(id, LeaderlessFrame::ACCEPT_OK, id.first);
+}
+
+void PaxosAppServer::DoReceivedLeaderlessAcceptOk(LeaderlessFrame frame)
+{
+    LeaderlessInstanceId id(frame.GetReplicaId(), frame.GetInstance());
+    auto it = m_instances.find(id);
+    if (it == m_instances.end() || it->second.status != LeaderlessInstance::ACCEPTED)
+    {
+        return;
+    }
+
+    it->second.numReplies++;
+    if (it->second.numReplies == SlowQuorumReplies(m_numNodes))
+    {
+        m_numSlowCommits++;
+        CommitLeaderlessInstance(id);
+    }
+}
+
+void PaxosAppServer::DoReceivedCommit(LeaderlessFrame frame)
+{
+    LeaderlessInstanceId id(frame.GetReplicaId(), frame.GetInstance());
+    RecordLeaderlessInstance(id, frame, LeaderlessInstance::COMMITTED);
+    ExecuteLeaderlessInstances(id);
+}
+
+void PaxosAppServer::CommitLeaderlessInstance(LeaderlessInstanceId id)
+{
+    LeaderlessInstance &instance = m_instances[id];
+    instance.status = LeaderlessInstance::COMMITTED;
+    instance.commitTime = ns3::Simulator::Now();
+    m_pendingExecution.insert(id);
+
+    for (auto node : m_nodes)
+    {
+        if (node.serverId != m_serverId)
+        {
+            SendLeaderlessMessage(id, LeaderlessFrame::COMMIT, node.serverId);
+        }
+    }
+
+    ExecuteLeaderlessInstances(id);
+}
+
+void PaxosAppServer::UpdateLeaderlessAttributes(LeaderlessInstanceId id, uint32_t value, uint64_t &seq, std::vector<uint64_t> &deps)
+{
+    std::vector<uint64_t> &conflicts = m_keyConflicts[value % PAXOS_NUM_KEYS];
+    conflicts.resize(m_numNodes, 0);
+
+    for (uint32_t r = 0; r < m_numNodes; r++)
+    {
+        uint64_t conflict = conflicts[r];
+        if (r == id.first && conflict >= id.second)
+        {
+            // Never depend on itself or on a later instance of the same leader
+            continue;
+        }
+        deps[r] = std::max(deps[r], conflict);
+    }
+
+    for (uint32_t r = 0; r < m_numNodes; r++)
+    {
+        auto it = m_instances.find(LeaderlessInstanceId(r, deps[r]));
+        if (deps[r] != 0 && it != m_instances.end())
+        {
+            seq = std::max(seq, it->second.seq + 1);
+        }
+    }
+}
+
+void PaxosAppServer::RecordLeaderlessInstance(LeaderlessInstanceId id, const LeaderlessFrame &frame, LeaderlessInstance::Status status)
+{
+    auto it = m_instances.find(id);
+    if (it != m_instances.end() &&
+        (it->second.status > status || it->second.status >= LeaderlessInstance::COMMITTED))
+    {
+        // Do not go back, e.g. a PreAccept arriving after the Accept, or a duplicate Commit
+        return;
+    }
+
+    LeaderlessInstance &instance = m_instances[id];
+    instance.status = status;
+    instance.value = frame.GetValue();
+    instance.seq = frame.GetSeq();
+    instance.deps = frame.GetDeps();
+    instance.deps.resize(m_numNodes, 0);
+    instance.createTime = frame.GetProposeTime();
+    if (status == LeaderlessInstance::COMMITTED)
+    {
+        instance.commitTime = ns3::Simulator::Now();
+        m_pendingExecution.insert(id);
+    }
+
+    std::vector<uint64_t> &conflicts = m_keyConflicts[instance.value % PAXOS_NUM_KEYS];
+    conflicts.resize(m_numNodes, 0);
+    conflicts[id.first] = std::max(conflicts[id.first], id.second);
+}
+
+void PaxosAppServer::SendLeaderlessMessage(LeaderlessInstanceId id, uint32_t messageType, uint32_t toId)
+{
+    const LeaderlessInstance &instance = m_instances[id];
+
+    LeaderlessFrame frame;
+    frame.SetMessageType(messageType);
+    frame.SetReplicaId(id.first);
+    frame.SetInstance(id.second);
+    frame.SetSenderId(m_serverId);
+    frame.SetValue(instance.value);
+    frame.SetSeq(instance.seq);
+    frame.SetProposeTime(instance.createTime);
+    frame.SetDeps(instance.deps);
+
+    ns3::Ptr<ns3::Packet> packet = ns3::Create<ns3::Packet>();
+    packet->AddHeader(frame);
+
+    ns3::InetSocketAddress to(m_nodes[toId].address, m_nodes[toId].paxosPort);
+    m_sendSocket->SendTo(packet, 0, to);
+}
+
+void PaxosAppServer::ExecuteLeaderlessInstances(LeaderlessInstanceId id)
+{
+    // The commit can only unblock the instances that wait for it
+    std::vector<LeaderlessInstanceId> ready{id};
+    auto it = m_blockedExecution.find(id);
+    if (it != m_blockedExecution.end())
+    {
+        ready.insert(ready.end(), it->second.begin(), it->second.end());
+        m_blockedExecution.erase(it);
+    }
+
+    for (auto r : ready)
+    {
+        if (m_instances[r].status == LeaderlessInstance::COMMITTED)
+        {
+            ExecuteLeaderlessInstance(r);
+        }
+    }
+}
+
+bool PaxosAppServer::ExecuteLeaderlessInstance(LeaderlessInstanceId id)
+{
+    // Tarjan's strongly connected components over the committed dependency graph,
+    // with an explicit stack of (instance, next dependency) for long chains
+    std::map<LeaderlessInstanceId, uint32_t> index;
+    std::map<LeaderlessInstanceId, uint32_t> lowlink;
+    std::set<LeaderlessInstanceId> onStack;
+    std::vector<LeaderlessInstanceId> stack;
+    std::vector<std::pair<LeaderlessInstanceId, uint32_t>> visiting;
+    uint32_t nextIndex = 0;
+
+    auto visit = [&](LeaderlessInstanceId v) {
+        index[v] = nextIndex;
+        lowlink[v] = nextIndex;
+        nextIndex++;
+        stack.push_back(v);
+        onStack.insert(v);
+        visiting.emplace_back(v, 0);
+    };
+
+    visit(id);
+    while (!visiting.empty())
+    {
+        LeaderlessInstanceId v = visiting.back().first;
+        const std::vector<uint64_t> &deps = m_instances[v].deps;
+        uint32_t r = visiting.back().second++;
+        if (r < deps.size())
+        {
+            if (deps[r] == 0)
+            {
+                continue;
+            }
+
+            LeaderlessInstanceId w(r, deps[r]);
+            auto it = m_instances.find(w);
+            if (it == m_instances.end() || it->second.status < LeaderlessInstance::COMMITTED)
+            {
+                // Retried when w commits, see ExecuteLeaderlessInstances
+                m_blockedExecution[w].push_back(id);
+                return false;
+            }
+            if (it->second.status == LeaderlessInstance::EXECUTED)
+            {
+                continue;
+            }
+
+            if (index.find(w) == index.end())
+            {
+                visit(w);
+            }
+            else if (onStack.find(w) != onStack.end())
+            {
+                lowlink[v] = std::min(lowlink[v], index[w]);
+            }
+            continue;
+        }
+
+        visiting.pop_back();
+        if (!visiting.empty())
+        {
+            LeaderlessInstanceId parent = visiting.back().first;
+            lowlink[parent] = std::min(lowlink[parent], lowlink[v]);
+        }
+        if (lowlink[v] != index[v])
+        {
+            continue;
+        }
+
+        // v is the root of a component, execute it in seq order
+        std::vector<LeaderlessInstanceId> component;
+        LeaderlessInstanceId w;
+        do
+        {
+            w = stack.back();
+            stack.pop_back();
+            onStack.erase(w);
+            component.push_back(w);
+        } while (w != v);
+
+        std::sort(component.begin(), component.end(), [this](LeaderlessInstanceId a, LeaderlessInstanceId b) {
+            return std::make_pair(m_instances[a].seq, a) < std::make_pair(m_instances[b].seq, b);
+        });
+
+        for (auto c : component)
+        {
+            LeaderlessInstance &instance = m_instances[c];
+            instance.status = LeaderlessInstance::EXECUTED;
+            m_pendingExecution.erase(c);
+
+            // The execution order is the position in the log
+            std::shared_ptr<Proposal> proposal = std::make_shared<Proposal>();
+            proposal->setProposalId(++m_numExecuted);
+            proposal->setProposerId(c.first);
+            proposal->setNodeId(c.first);
+            proposal->setValue(instance.value);
+            proposal->setCreateTime(instance.createTime);
+            proposal->setDecisionTime(instance.commitTime);
+            m_decidedProposalQueue.push(proposal);
+
+            NS_LOG_INFO("PaxosAppServer " << m_nodeId << " executed instance " << c.first << "." << c.second);
+            PaxosTracer::Record(PAXOS_TRACE_EXECUTED, m_nodeId, c.second, instance.createTime);
+        }
+    }
+    return true;
+}
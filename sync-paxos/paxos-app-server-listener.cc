@@ -48,7 +48,7 @@ void PaxosAppServer::ReceiveRequest(ns3::Ptr<ns3::Socket> socket)
     while ((packet = socket->RecvFrom(from)))
     {
         // If run in async mode, and I am not the leader, ignore the request
-        if (s_async && m_nodeId != s_leader)
+        if (s_mode == PAXOS_MODE_ASYNC && m_nodeId != s_leader)
         {
             NS_LOG_INFO("PaxosAppServer " << m_nodeId << " is not the leader, ignore the request");
             continue;
@@ -58,6 +58,14 @@ void PaxosAppServer::ReceiveRequest(ns3::Ptr<ns3::Socket> socket)
             NS_LOG_INFO("PaxosAppServer " << m_nodeId << " received a request packet");
             RequestFrame requestFrame;
             packet->RemoveHeader(requestFrame);
+            PaxosTracer::Record(PAXOS_TRACE_REQUEST_RECEIVED, m_nodeId, requestFrame.GetTimestamp().GetNanoSeconds(), requestFrame.GetTimestamp());
+
+            // Reads bypass consensus in sync and async mode
+            if (requestFrame.IsRead() && (s_mode == PAXOS_MODE_SYNC || s_mode == PAXOS_MODE_ASYNC))
+            {
+                ns3::Simulator::Schedule(ns3::NanoSeconds(10), &PaxosAppServer::HandleReadRequest, this, requestFrame);
+                continue;
+            }
 
             // Create Proposal from Request
             ns3::Simulator::Schedule(ns3::NanoSeconds(10), &PaxosAppServer::CreateProposalFromRequest, this, requestFrame);
@@ -91,4 +99,10 @@ void PaxosAppServer::CreateProposalFromRequest(RequestFrame requestFrame)
     m_waitingProposals.push(proposal);
 
     NS_LOG_INFO("PaxosAppServer " << m_nodeId << " created proposal " << proposal->getProposalId() << " from request");
+
+    // In leaderless mode every replica leads the requests it receives right away
+    if (s_mode == PAXOS_MODE_LEADERLESS)
+    {
+        DoLeaderlessPropose();
+    }
 }
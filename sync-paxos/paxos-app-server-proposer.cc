@@ -6,7 +6,13 @@ void PaxosAppServer::StartProposerThread()
 {
     NS_LOG_INFO("Starting Proposer Thread");
 
-    if (s_async)
+    if (s_mode == PAXOS_MODE_SEQUENCER || s_mode == PAXOS_MODE_LEADERLESS)
+    {
+        // The sequencer orders the requests, or the replicas propose as requests arrive
+        return;
+    }
+
+    if (s_mode == PAXOS_MODE_ASYNC)
     {
         // This is the asynchronous mode
         // Check if I am the leader
@@ -16,6 +22,12 @@ void PaxosAppServer::StartProposerThread()
             // Do Propose
             m_leaderState = PAXOS_LEADER_WAITING_REQUEST;
             DoAsyncPropose();
+
+            // Hold a read lease to serve reads locally, if the clients send any
+            if (m_readRatio > 0)
+            {
+                RenewLease();
+            }
         }
         else
         {
@@ -27,6 +39,7 @@ void PaxosAppServer::StartProposerThread()
     {
         // This is the synchronous mode
         // Calculate when to start the proposer
+        m_slotOrigin = ns3::Simulator::Now();
         ns3::Time firstProposeTime = m_serverId * (2*m_clockSyncError + m_boundedMessageDelay);
         m_proposeEvent = ns3::Simulator::Schedule(firstProposeTime, &PaxosAppServer::DoSyncPropose, this);
     }
@@ -40,6 +53,10 @@ void PaxosAppServer::StopProposerThread()
     {
         m_proposeEvent.Cancel();
     }
+    if (m_leaseEvent.IsPending())
+    {
+        m_leaseEvent.Cancel();
+    }
 }
 
 int32_t
@@ -130,29 +147,15 @@ uint64_t PaxosAppServer::DoPropose()
     packet->AddHeader(proposalFrame);
 
     NS_LOG_INFO("PaxosAppServer " << m_serverId << " sending Proposal ID " << proposal->getProposalId() << " to all nodes.");
-    // Send Proposal to all nodes
-    for (auto node : m_nodes)
+    PaxosTracer::Record(PAXOS_TRACE_PROPOSAL_SENT, m_nodeId, proposal->getProposalId(), proposal->getProposeTime());
+    // Send Proposal to all other nodes
+    if (m_sendSocket)
     {
-        if (node.serverId == m_nodeId)
-        {
-            // Do not send the proposal to itself
-            continue;
-        }
-
-        ns3::Ipv4Address address = node.address;
-        uint16_t port = node.paxosPort;
-
-        // Send the packet to the node
-        ns3::InetSocketAddress to(address, port);
-
-        if (m_sendSocket)
-        {
-            m_sendSocket->SendTo(packet, 0, to);
-        }
-        else
-        {
-            NS_FATAL_ERROR("SendSocket is null");
-        }
+        m_sendSocket->SendToMany(packet, 0, m_peerAddresses);
+    }
+    else
+    {
+        NS_FATAL_ERROR("SendSocket is null");
     }
 
     m_proposals[proposal->getProposalId()] = proposal;
@@ -170,6 +173,7 @@ void PaxosAppServer::proposeTimerExpired(uint64_t proposalId)
     {
         // The proposal is still in the queue
         NS_LOG_INFO("PaxosAppServer " << m_serverId << " proposal ID " << proposalId << " is still in the queue.");
+        PaxosTracer::Record(PAXOS_TRACE_PROPOSAL_TIMEOUT, m_nodeId, proposalId);
 
         // Repropose
         DoAsyncPropose();
@@ -0,0 +1,117 @@
+#include "paxos-app-server.h"
+
+NS_LOG_COMPONENT_DEFINE("PaxosAppServerRead");
+
+// Local reads
+// Synchronous mode: any replica serves a read at the first slot boundary that
+// is at least one slot (2 * clock sync error + bounded message delay) after
+// the read arrived. Any write decided before the read arrived has reached this
+// replica by then, so the read is linearizable.
+// Asynchronous mode: the leader serves reads while it holds a lease granted by
+// a majority. Reads arriving without a valid lease wait for the next renewal.
+// Only one leader exists in this model, the lease stands for the promise of
+// the replicas not to support another leader until it expires.
+
+void PaxosAppServer::HandleReadRequest(RequestFrame requestFrame)
+{
+    ns3::Time now = ns3::Simulator::Now();
+
+    if (s_mode == PAXOS_MODE_SYNC)
+    {
+        ns3::Time slot = 2 * m_clockSyncError + m_boundedMessageDelay;
+        ns3::Time earliest = now + slot - m_slotOrigin;
+        int64_t slots = (earliest.GetNanoSeconds() + slot.GetNanoSeconds() - 1) / slot.GetNanoSeconds();
+        ns3::Time serveTime = m_slotOrigin + slots * slot;
+
+        NS_LOG_INFO("PaxosAppServer " << m_nodeId << " serving read at slot boundary " << serveTime);
+        ns3::Simulator::Schedule(serveTime - now, &PaxosAppServer::ServeRead, this, requestFrame, now);
+        return;
+    }
+
+    if (now < m_leaseExpiry)
+    {
+        ServeRead(requestFrame, now);
+    }
+    else
+    {
+        NS_LOG_INFO("PaxosAppServer " << m_nodeId << " has no valid lease, read waits for the lease");
+        m_pendingReads.push(std::make_pair(requestFrame, now));
+    }
+}
+
+void PaxosAppServer::ServeRead(RequestFrame requestFrame, ns3::Time receiveTime)
+{
+    std::shared_ptr<Proposal> read = std::make_shared<Proposal>();
+    read->setValue(requestFrame.GetValue());
+    read->setCreateTime(requestFrame.GetTimestamp());
+    read->setReceiveTime(receiveTime);
+    read->setDecisionTime(ns3::Simulator::Now());
+    m_servedReads.push_back(read);
+    PaxosTracer::Record(PAXOS_TRACE_READ_SERVED, m_nodeId, requestFrame.GetTimestamp().GetNanoSeconds(), receiveTime);
+}
+
+void PaxosAppServer::RenewLease()
+{
+    // If App is all ready stopped, do not renew
+    if (ns3::Simulator::Now() >= m_stopTime)
+    {
+        return;
+    }
+
+    m_leaseStart = ns3::Simulator::Now();
+    m_numLeaseAcks = 1;
+
+    PaxosFrame frame;
+    frame.SetMessageType(PaxosFrame::LEASE_REQUEST);
+    frame.SetProposerId(m_serverId);
+    frame.SetProposeTime(m_leaseStart);
+
+    ns3::Ptr<ns3::Packet> packet = ns3::Create<ns3::Packet>();
+    packet->AddHeader(frame);
+
+    m_sendSocket->SendToMany(packet, 0, m_peerAddresses);
+
+    // Renew halfway so that the lease does not lapse under normal delays
+    m_leaseEvent = ns3::Simulator::Schedule(m_leaseDuration / 2, &PaxosAppServer::RenewLease, this);
+}
+
+void PaxosAppServer::DoReceivedLeaseRequest(PaxosFrame frame)
+{
+    NS_LOG_INFO("PaxosAppServer " << m_nodeId << " granting lease to " << frame.GetProposerId());
+
+    frame.SetMessageType(PaxosFrame::LEASE_ACK);
+    frame.SetAcceptorId(m_serverId);
+    frame.SetAcceptTime(ns3::Simulator::Now());
+
+    ns3::Ptr<ns3::Packet> packet = ns3::Create<ns3::Packet>();
+    packet->AddHeader(frame);
+
+    ns3::InetSocketAddress to(m_nodes[frame.GetProposerId()].address, m_nodes[frame.GetProposerId()].paxosPort);
+    m_sendSocket->SendTo(packet, 0, to);
+}
+
+void PaxosAppServer::DoReceivedLeaseAck(PaxosFrame frame)
+{
+    if (frame.GetProposeTime() != m_leaseStart)
+    {
+        // Ack of an older lease request
+        return;
+    }
+
+    m_numLeaseAcks++;
+    if (m_numLeaseAcks != m_numNodes / 2 + 1)
+    {
+        return;
+    }
+
+    // The lease counts from the request, minus the clock error of the replicas
+    ns3::Time expiry = m_leaseStart + m_leaseDuration - m_clockSyncError;
+    m_leaseExpiry = std::max(m_leaseExpiry, expiry);
+    NS_LOG_INFO("PaxosAppServer " << m_nodeId << " holds the read lease until " << m_leaseExpiry);
+
+    while (!m_pendingReads.empty())
+    {
+        ServeRead(m_pendingReads.front().first, m_pendingReads.front().second);
+        m_pendingReads.pop();
+    }
+}
@@ -0,0 +1,433 @@
+#include "paxos-app-server.h"
+
+NS_LOG_COMPONENT_DEFINE("PaxosAppServerSequenced");
+
+// Sequencer mode (NOPaxos style)
+// The sequencer on a spine stamps every request with a global sequence number
+// and multicasts it to all replicas. A replica appends requests in sequence
+// order and acks every entry to the leader (s_leader), with its value. An
+// entry is decided once the leader has it and a quorum of replicas, the leader
+// included, has the same value. The leader then commits it to all replicas.
+// The leader never changes an entry it has, so only its values get decided,
+// and the other replicas only replace entries that are not decided yet.
+// A replica that sees a gap, or keeps an entry undecided for a propose timeout,
+// asks the leader for it every propose timeout until it is decided. The leader
+// answers with its entry or its commit. If it missed the request as well, it
+// takes a NO-OP for the slot and sends it to all replicas, the NO-OP is decided
+// like a request once a quorum acked it (gap agreement). The leader resends its
+// entries undecided for a propose timeout to the replicas that did not ack them.
+
+// Copy a sequenced request, or an entry sent by the leader, into a log entry
+static void SetSequencedEntry(std::shared_ptr<Proposal> entry, const PaxosFrame &frame)
+{
+    entry->setProposalId(frame.GetProposalId());
+    entry->setProposerId(frame.GetProposerId());
+    entry->setNodeId(frame.GetProposerId());
+    entry->setValue(frame.GetValue());
+    entry->setCreateTime(frame.GetProposeTime());
+    entry->setProposeTime(frame.GetProposeTime());
+    entry->setAcceptTime(frame.GetAcceptTime());
+}
+
+// The commits of the leader win over its entries, which win over the requests of the sequencer
+static uint32_t SequencedEntryRank(const PaxosFrame &frame)
+{
+    if (frame.IsSequencedCommit())
+    {
+        return 2;
+    }
+    return frame.IsGapFill() ? 1 : 0;
+}
+
+void PaxosAppServer::DoReceivedSequencedRequest(PaxosFrame frame)
+{
+    uint64_t sequenceNumber = frame.GetProposalId();
+    NS_LOG_INFO("PaxosAppServer " << m_nodeId << " received sequenced request " << sequenceNumber);
+    PaxosTracer::Record(PAXOS_TRACE_SEQUENCED_RECEIVED, m_nodeId, sequenceNumber);
+
+    if (sequenceNumber < m_nextSequenceNumber)
+    {
+        // Already filled, e.g. by a NO-OP from the leader
+        NS_LOG_INFO("PaxosAppServer " << m_nodeId << " ignoring late sequenced request " << sequenceNumber);
+        return;
+    }
+
+    BufferSequencedEntry(frame);
+    if (sequenceNumber > m_nextSequenceNumber)
+    {
+        NS_LOG_WARN("PaxosAppServer " << m_nodeId << " detected gap, expected " << m_nextSequenceNumber
+                                      << " received " << sequenceNumber);
+        HandleSequenceGap(sequenceNumber);
+    }
+
+    DeliverSequencedBuffer();
+}
+
+void PaxosAppServer::HandleSequenceGap(uint64_t sequenceNumber)
+{
+    std::vector<uint64_t> noops;
+    for (uint64_t s = m_nextSequenceNumber; s < sequenceNumber; s++)
+    {
+        if (m_sequencedBuffer.find(s) != m_sequencedBuffer.end())
+        {
+            continue;
+        }
+
+        if (m_serverId == s_leader)
+        {
+            // The leader takes a NO-OP for the missing slot
+            PaxosFrame noop;
+            noop.SetMessageType(PaxosFrame::GAP_FILL);
+            noop.SetProposerId(m_serverId);
+            noop.SetProposalId(s);
+            noop.SetValue(PAXOS_NOOP_VALUE);
+            m_sequencedBuffer[s] = noop;
+            noops.push_back(s);
+        }
+        else if (m_gapRequested.find(s) == m_gapRequested.end())
+        {
+            SendGapRequest(s);
+        }
+    }
+
+    if (noops.empty())
+    {
+        return;
+    }
+
+    // The NO-OPs are decided like requests, once a quorum of replicas acked them
+    DeliverSequencedBuffer();
+    for (auto s : noops)
+    {
+        NS_LOG_INFO("PaxosAppServer " << m_nodeId << " proposing NO-OP for sequence number " << s);
+        m_sendSocket->SendToMany(CreateSequencedPacket(s, PaxosFrame::GAP_FILL), 0, m_peerAddresses);
+    }
+}
+
+void PaxosAppServer::SendGapRequest(uint64_t sequenceNumber)
+{
+    // Ask the leader for the missing or undecided slot
+    PaxosTracer::Record(PAXOS_TRACE_GAP_REQUEST, m_nodeId, sequenceNumber);
+    PaxosFrame request;
+    request.SetMessageType(PaxosFrame::GAP_REQUEST);
+    request.SetProposalId(sequenceNumber);
+    request.SetAcceptorId(m_serverId);
+
+    ns3::Ptr<ns3::Packet> packet = ns3::Create<ns3::Packet>();
+    packet->AddHeader(request);
+
+    ns3::InetSocketAddress to(m_nodes[s_leader].address, m_nodes[s_leader].paxosPort);
+    m_sendSocket->SendTo(packet, 0, to);
+
+    // The request or its answer may be lost, ask again if the slot is still undecided.
+    // Not after the stop, the simulation would otherwise run until the retransmit.
+    if (ns3::Simulator::Now() < m_stopTime)
+    {
+        m_gapRequested[sequenceNumber] =
+            ns3::Simulator::Schedule(s_proposeTimeout, &PaxosAppServer::gapRequestTimerExpired, this, sequenceNumber);
+    }
+}
+
+void PaxosAppServer::gapRequestTimerExpired(uint64_t sequenceNumber)
+{
+    m_gapRequested.erase(sequenceNumber);
+    bool decided = sequenceNumber < m_nextSequenceNumber &&
+                   m_undecidedSequence.find(sequenceNumber) == m_undecidedSequence.end();
+    if (ns3::Simulator::Now() >= m_stopTime || decided)
+    {
+        return;
+    }
+
+    NS_LOG_INFO("PaxosAppServer " << m_nodeId << " got no commit for sequence number " << sequenceNumber
+                                  << ", asking the leader again");
+    SendGapRequest(sequenceNumber);
+}
+
+void PaxosAppServer::DoReceivedGapRequest(PaxosFrame frame)
+{
+    uint64_t sequenceNumber = frame.GetProposalId();
+    NS_LOG_INFO("PaxosAppServer " << m_nodeId << " received gap request " << sequenceNumber
+                                  << " from " << frame.GetAcceptorId());
+
+    if (m_serverId != s_leader)
+    {
+        NS_LOG_WARN("PaxosAppServer " << m_nodeId << " is not the leader, ignore the gap request");
+        return;
+    }
+
+    if (sequenceNumber >= m_nextSequenceNumber)
+    {
+        // The leader misses the slot or one before it, the NO-OPs it takes are sent to all replicas
+        bool missing = m_sequencedBuffer.find(sequenceNumber) == m_sequencedBuffer.end();
+        HandleSequenceGap(sequenceNumber + 1);
+        if (missing)
+        {
+            return;
+        }
+    }
+
+    bool decided = m_undecidedSequence.find(sequenceNumber) == m_undecidedSequence.end();
+    SendSequencedEntry(sequenceNumber, decided ? PaxosFrame::SEQUENCED_COMMIT : PaxosFrame::GAP_FILL,
+                       frame.GetAcceptorId());
+}
+
+ns3::Ptr<ns3::Packet> PaxosAppServer::CreateSequencedPacket(uint64_t sequenceNumber, uint32_t messageType)
+{
+    std::shared_ptr<Proposal> entry = m_sequencedLog[sequenceNumber];
+    PaxosFrame fill;
+    fill.SetMessageType(messageType);
+    fill.SetProposerId(entry->getProposerId());
+    fill.SetProposalId(sequenceNumber);
+    fill.SetValue(entry->getValue());
+    fill.SetProposeTime(entry->getProposeTime());
+    fill.SetAcceptorId(m_serverId);
+    fill.SetAcceptTime(entry->getAcceptTime());
+    fill.SetDecisionTime(entry->getDecisionTime());
+
+    ns3::Ptr<ns3::Packet> packet = ns3::Create<ns3::Packet>();
+    packet->AddHeader(fill);
+    return packet;
+}
+
+void PaxosAppServer::SendSequencedEntry(uint64_t sequenceNumber, uint32_t messageType, uint32_t toId)
+{
+    auto it = m_sequencedLog.find(sequenceNumber);
+    if (it == m_sequencedLog.end())
+    {
+        NS_LOG_WARN("PaxosAppServer " << m_nodeId << " has no entry for sequence number " << sequenceNumber);
+        return;
+    }
+
+    ns3::InetSocketAddress to(m_nodes[toId].address, m_nodes[toId].paxosPort);
+    m_sendSocket->SendTo(CreateSequencedPacket(sequenceNumber, messageType), 0, to);
+}
+
+void PaxosAppServer::DoReceivedGapFill(PaxosFrame frame)
+{
+    uint64_t sequenceNumber = frame.GetProposalId();
+    NS_LOG_INFO("PaxosAppServer " << m_nodeId << " received gap fill " << sequenceNumber
+                                  << " value " << frame.GetValue());
+    PaxosTracer::Record(PAXOS_TRACE_GAP_FILL, m_nodeId, sequenceNumber);
+
+    if (sequenceNumber < m_nextSequenceNumber)
+    {
+        // The entry of the leader replaces ours if it is not decided yet, e.g. a NO-OP
+        // for a request the leader missed, and is acked again
+        if (m_undecidedSequence.find(sequenceNumber) != m_undecidedSequence.end())
+        {
+            SetSequencedEntry(m_sequencedLog[sequenceNumber], frame);
+            SendSequencedEntry(sequenceNumber, PaxosFrame::SEQUENCED_ACK, s_leader);
+        }
+        return;
+    }
+
+    BufferSequencedEntry(frame);
+    if (sequenceNumber > m_nextSequenceNumber)
+    {
+        HandleSequenceGap(sequenceNumber);
+    }
+    DeliverSequencedBuffer();
+}
+
+void PaxosAppServer::DoReceivedSequencedAck(PaxosFrame frame)
+{
+    uint64_t sequenceNumber = frame.GetProposalId();
+    NS_LOG_INFO("PaxosAppServer " << m_nodeId << " received sequenced ack " << sequenceNumber
+                                  << " value " << frame.GetValue() << " from " << frame.GetAcceptorId());
+
+    if (sequenceNumber < m_nextSequenceNumber &&
+        m_undecidedSequence.find(sequenceNumber) == m_undecidedSequence.end())
+    {
+        return; // Already decided
+    }
+
+    // A replica acks again when its value changes, only its last value counts
+    m_sequencedAcks[sequenceNumber][frame.GetAcceptorId()] = frame.GetValue();
+    CheckSequencedQuorum(sequenceNumber);
+}
+
+void PaxosAppServer::DoReceivedSequencedCommit(PaxosFrame frame)
+{
+    uint64_t sequenceNumber = frame.GetProposalId();
+    NS_LOG_INFO("PaxosAppServer " << m_nodeId << " received sequenced commit " << sequenceNumber
+                                  << " value " << frame.GetValue());
+    PaxosTracer::Record(PAXOS_TRACE_DECISION_RECEIVED, m_nodeId, sequenceNumber, frame.GetDecisionTime());
+
+    if (sequenceNumber < m_nextSequenceNumber)
+    {
+        if (m_undecidedSequence.find(sequenceNumber) != m_undecidedSequence.end())
+        {
+            SetSequencedEntry(m_sequencedLog[sequenceNumber], frame);
+            DecideSequencedEntry(sequenceNumber);
+        }
+    }
+    else
+    {
+        BufferSequencedEntry(frame);
+        DeliverSequencedBuffer();
+    }
+
+    if (sequenceNumber > m_nextSequenceNumber)
+    {
+        HandleSequenceGap(sequenceNumber);
+    }
+}
+
+void PaxosAppServer::BufferSequencedEntry(PaxosFrame frame)
+{
+    auto it = m_sequencedBuffer.find(frame.GetProposalId());
+    if (it != m_sequencedBuffer.end() && SequencedEntryRank(frame) < SequencedEntryRank(it->second))
+    {
+        return;
+    }
+    m_sequencedBuffer[frame.GetProposalId()] = frame;
+}
+
+void PaxosAppServer::DeliverSequencedBuffer()
+{
+    while (!m_sequencedBuffer.empty() && m_sequencedBuffer.begin()->first == m_nextSequenceNumber)
+    {
+        PaxosFrame frame = m_sequencedBuffer.begin()->second;
+        m_sequencedBuffer.erase(m_sequencedBuffer.begin());
+        AppendSequencedEntry(frame);
+    }
+}
+
+void PaxosAppServer::AppendSequencedEntry(PaxosFrame frame)
+{
+    // The sequence number is the position in the log
+    uint64_t sequenceNumber = frame.GetProposalId();
+    std::shared_ptr<Proposal> proposal = std::make_shared<Proposal>();
+    SetSequencedEntry(proposal, frame);
+    proposal->setReceiveTime(ns3::Simulator::Now());
+
+    m_sequencedLog[sequenceNumber] = proposal;
+    m_undecidedSequence.insert(sequenceNumber);
+    m_nextSequenceNumber = sequenceNumber + 1;
+
+    NS_LOG_INFO("PaxosAppServer " << m_nodeId << " appended sequence number " << sequenceNumber);
+
+    if (frame.IsSequencedCommit())
+    {
+        DecideSequencedEntry(sequenceNumber);
+        return;
+    }
+
+    if (!m_sequencedRetryEvent.IsPending() && ns3::Simulator::Now() < m_stopTime)
+    {
+        m_sequencedRetryEvent =
+            ns3::Simulator::Schedule(s_proposeTimeout, &PaxosAppServer::sequencedRetryTimerExpired, this);
+    }
+
+    if (m_serverId == s_leader)
+    {
+        // The acks of the other replicas may have come first
+        CheckSequencedQuorum(sequenceNumber);
+    }
+    else
+    {
+        SendSequencedEntry(sequenceNumber, PaxosFrame::SEQUENCED_ACK, s_leader);
+    }
+}
+
+void PaxosAppServer::CheckSequencedQuorum(uint64_t sequenceNumber)
+{
+    // Only the entries the leader has and has not decided yet
+    if (sequenceNumber >= m_nextSequenceNumber ||
+        m_undecidedSequence.find(sequenceNumber) == m_undecidedSequence.end())
+    {
+        return;
+    }
+
+    uint32_t value = m_sequencedLog[sequenceNumber]->getValue();
+    uint32_t numAcks = 0;
+    auto acks = m_sequencedAcks.find(sequenceNumber);
+    if (acks != m_sequencedAcks.end())
+    {
+        for (auto ack : acks->second)
+        {
+            if (ack.second == value)
+            {
+                numAcks++;
+            }
+        }
+    }
+
+    // A quorum is the leader and half of the other replicas
+    if (numAcks >= m_numNodes / 2)
+    {
+        DecideSequencedEntry(sequenceNumber);
+    }
+}
+
+void PaxosAppServer::DecideSequencedEntry(uint64_t sequenceNumber)
+{
+    std::shared_ptr<Proposal> entry = m_sequencedLog[sequenceNumber];
+    entry->setDecisionTime(ns3::Simulator::Now());
+    m_decidedProposalQueue.push(entry);
+    m_undecidedSequence.erase(sequenceNumber);
+
+    // The retransmit of its gap request is removed rather than cancelled,
+    // the simulation would otherwise run until it
+    auto requested = m_gapRequested.find(sequenceNumber);
+    if (requested != m_gapRequested.end())
+    {
+        ns3::Simulator::Remove(requested->second);
+        m_gapRequested.erase(requested);
+    }
+
+    NS_LOG_INFO("PaxosAppServer " << m_nodeId << " added sequence number " << sequenceNumber
+                                  << " to decided proposals queue.");
+
+    if (m_serverId == s_leader)
+    {
+        PaxosTracer::Record(PAXOS_TRACE_DECIDED, m_nodeId, sequenceNumber, entry->getProposeTime());
+        m_sequencedAcks.erase(sequenceNumber);
+        m_sendSocket->SendToMany(CreateSequencedPacket(sequenceNumber, PaxosFrame::SEQUENCED_COMMIT), 0,
+                                 m_peerAddresses);
+    }
+}
+
+void PaxosAppServer::sequencedRetryTimerExpired()
+{
+    if (ns3::Simulator::Now() >= m_stopTime)
+    {
+        return;
+    }
+
+    // The log is appended in sequence order, the younger entries may still be decided in time
+    for (auto s : m_undecidedSequence)
+    {
+        std::shared_ptr<Proposal> entry = m_sequencedLog[s];
+        if (ns3::Simulator::Now() - entry->getReceiveTime() < s_proposeTimeout)
+        {
+            break;
+        }
+
+        // The other replicas lost the ack or the commit, or the leader has not decided it yet
+        if (m_serverId != s_leader)
+        {
+            if (m_gapRequested.find(s) == m_gapRequested.end())
+            {
+                SendGapRequest(s);
+            }
+            continue;
+        }
+
+        const std::map<uint32_t, uint32_t> &acks = m_sequencedAcks[s];
+        for (auto node : m_nodes)
+        {
+            auto ack = acks.find(node.serverId);
+            if (node.serverId != m_serverId && (ack == acks.end() || ack->second != entry->getValue()))
+            {
+                SendSequencedEntry(s, PaxosFrame::GAP_FILL, node.serverId);
+            }
+        }
+    }
+
+    if (!m_undecidedSequence.empty())
+    {
+        m_sequencedRetryEvent =
+            ns3::Simulator::Schedule(s_proposeTimeout, &PaxosAppServer::sequencedRetryTimerExpired, this);
+    }
+}
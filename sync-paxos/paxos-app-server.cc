@@ -2,16 +2,19 @@
 #include "paxos-frame.h"
 
 #include <filesystem>
+#include <iomanip>
 
 // define LOG
 NS_LOG_COMPONENT_DEFINE("PaxosAppServer");
 
-bool PaxosAppServer::s_async = false;
+PaxosMode PaxosAppServer::s_mode = PAXOS_MODE_SYNC;
 uint32_t PaxosAppServer::s_leader = 0;
 ns3::Time PaxosAppServer::s_proposeTimeout = ns3::MilliSeconds(100);
 
 PaxosAppServer::PaxosAppServer()
-    : m_nodeId(0), m_numNodes(0), m_nextProposalId(0)
+    : m_nodeId(0), m_numNodes(0), m_nextProposalId(0), m_nodeFailureRate(0), m_ipTos(0), m_readRatio(0),
+      m_leaseDuration(ns3::MilliSeconds(10)), m_numLeaseAcks(0), m_nextSequenceNumber(1),
+      m_nextInstance(1), m_numExecuted(0), m_numFastCommits(0), m_numSlowCommits(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -22,6 +25,23 @@ PaxosAppServer::PaxosAppServer(uint32_t selfId, NodeInfoList nodes)
     m_serverId = selfId;
     m_numNodes = nodes.size();
     m_nodes = nodes;
+    for (auto node : m_nodes)
+    {
+        if (node.serverId != selfId)
+        {
+            m_peerAddresses.push_back(ns3::InetSocketAddress(node.address, node.paxosPort));
+        }
+    }
+    m_nodeFailureRate = 0;
+    m_ipTos = 0;
+    m_nextSequenceNumber = 1;
+    m_nextInstance = 1;
+    m_numExecuted = 0;
+    m_numFastCommits = 0;
+    m_numSlowCommits = 0;
+    m_readRatio = 0;
+    m_leaseDuration = ns3::MilliSeconds(10);
+    m_numLeaseAcks = 0;
 }
 
 PaxosAppServer::~PaxosAppServer()
@@ -52,6 +72,26 @@ void PaxosAppServer::SetNodeFailureRate(double nodeFailureRate)
     m_nodeFailureRate = nodeFailureRate;
 }
 
+void PaxosAppServer::SetIpTos(uint8_t ipTos)
+{
+    m_ipTos = ipTos;
+}
+
+void PaxosAppServer::SetLeaseDuration(ns3::Time leaseDuration)
+{
+    m_leaseDuration = leaseDuration;
+}
+
+void PaxosAppServer::SetReadRatio(double readRatio)
+{
+    m_readRatio = readRatio;
+}
+
+void PaxosAppServer::SetOutputDir(std::string outputDir)
+{
+    m_outputDir = outputDir;
+}
+
 void PaxosAppServer::StartApplication(void)
 {
     // Create a UDP socket for receiving messages
@@ -60,7 +100,7 @@ void PaxosAppServer::StartApplication(void)
     // Create a UDP socket for sending messages
     CreateSendSocket();
 
-    NS_LOG_INFO("Starting PaxosAppServer " << m_nodeId << " async mode : " << s_async);
+    NS_LOG_INFO("Starting PaxosAppServer " << m_nodeId << " mode : " << s_mode);
     NS_LOG_INFO("Leader: " << s_leader << " Propose timeout: " << s_proposeTimeout.GetMilliSeconds() << "ms");
 
     // Calculate the proposal period, only used for synchronous manner
@@ -79,14 +119,48 @@ void PaxosAppServer::StartApplication(void)
     // Start Acceptor Thread
     NS_LOG_INFO("Starting Acceptor Thread for Node " << m_nodeId);
     ns3::Simulator::ScheduleNow(&PaxosAppServer::StartAcceptorThread, this);
+
+    // Crash at a random time of the run. Only the minority of highest ids can
+    // fail, so that the leader (server 0) and a quorum are always left.
+    if (m_nodeFailureRate > 0 && m_serverId >= m_numNodes - (m_numNodes - 1) / 2)
+    {
+        ns3::Ptr<ns3::UniformRandomVariable> random = ns3::CreateObject<ns3::UniformRandomVariable>();
+        if (random->GetValue() < m_nodeFailureRate)
+        {
+            ns3::Time crashTime = ns3::Seconds(random->GetValue(0, (m_stopTime - ns3::Simulator::Now()).GetSeconds()));
+            NS_LOG_INFO("PaxosAppServer " << m_nodeId << " will crash at " << ns3::Simulator::Now() + crashTime);
+            m_crashEvent = ns3::Simulator::Schedule(crashTime, &PaxosAppServer::Crash, this);
+        }
+    }
+}
+
+void PaxosAppServer::Crash()
+{
+    NS_LOG_INFO("PaxosAppServer " << m_nodeId << " crashed");
+    StopProposerThread();
+    StopListenerThread();
+    if (m_recvSocket != nullptr)
+    {
+        m_recvSocket->Close();
+        m_recvSocket = nullptr;
+    }
 }
 
 void PaxosAppServer::StopApplication(void)
 {
+    // The retransmits of the sequencer mode are removed rather than left to
+    // expire, the simulation would otherwise run until them
+    ns3::Simulator::Remove(m_sequencedRetryEvent);
+    for (auto requested : m_gapRequested)
+    {
+        ns3::Simulator::Remove(requested.second);
+    }
+    m_gapRequested.clear();
+
     // Log the proposal to file
     // Write the proposal to file
-    // Log file path : LOG_DIR + "server-" + m_nodeId + "-decision-log.dat"
-    std::string logFilePath = "server-" + std::to_string(m_nodeId) + "-decision-log.dat";
+    // Log file path : m_outputDir + "server-" + m_nodeId + "-decision-log.dat"
+    std::filesystem::path logFilePath = m_outputDir / ("server-" + std::to_string(m_nodeId) + "-decision-log.dat");
 
     // Create file if it not exists
     if (!std::filesystem::exists(logFilePath))
@@ -96,6 +170,8 @@ void PaxosAppServer::StopApplication(void)
     }
 
     std::ofstream logFile(logFilePath, std::ios::out);
+    // Print the times to the ns, the default precision rounds them to 10us after 1s
+    logFile << std::setprecision(15);
     logFile << "index,proposalId,proposerId,value,decidedTime\n";
 
     uint64_t length = m_decidedProposalQueue.size();
@@ -107,6 +183,27 @@ void PaxosAppServer::StopApplication(void)
     }
 
     logFile.close();
+
+    // Log the served reads, only if there are reads so the decision log stays the only result otherwise
+    if (!m_servedReads.empty())
+    {
+        std::filesystem::path readLogFilePath = m_outputDir / ("server-" + std::to_string(m_nodeId) + "-read-log.dat");
+        std::ofstream readLogFile(readLogFilePath, std::ios::out);
+        readLogFile << std::setprecision(15);
+        readLogFile << "index,value,createTime,receiveTime,servedTime\n";
+        for (uint64_t i = 0; i < m_servedReads.size(); i++)
+        {
+            auto read = m_servedReads[i];
+            readLogFile << i << "," << read->getValue() << "," << read->getCreateTime() << "," << read->getReceiveTime() << "," << read->getDecisionTime() << std::endl;
+        }
+        readLogFile.close();
+    }
+
+    if (s_mode == PAXOS_MODE_LEADERLESS)
+    {
+        NS_LOG_INFO("PaxosAppServer " << m_nodeId << " committed " << m_numFastCommits << " instances on the fast path, "
+                                      << m_numSlowCommits << " on the slow path");
+    }
 }
 
 void PaxosAppServer::SetNodeId(uint32_t serverId)
@@ -130,6 +227,12 @@ void PaxosAppServer::CreateSendSocket()
         NS_LOG_ERROR("Failed to create send socket for PaxosAppServer " << m_nodeId);
         return;
     }
+
+    // Mark the Paxos messages so that the fabric can prioritize them
+    if (m_ipTos != 0)
+    {
+        m_sendSocket->SetIpTos(m_ipTos);
+    }
 }
 
 void PaxosAppServer::CreateRecvSocket()
@@ -151,8 +254,15 @@ void PaxosAppServer::CreateRecvSocket()
         return;
     }
 
-    // Set the receive callback
-    m_recvSocket->SetRecvCallback(MakeCallback(&PaxosAppServer::ReceiveMessage, this));
+    // Set the receive callback, leaderless mode has its own message format
+    if (s_mode == PAXOS_MODE_LEADERLESS)
+    {
+        m_recvSocket->SetRecvBatchCallback(MakeCallback(&PaxosAppServer::ReceiveLeaderlessMessage, this));
+    }
+    else
+    {
+        m_recvSocket->SetRecvBatchCallback(MakeCallback(&PaxosAppServer::ReceiveMessage, this));
+    }
 }
 
 void PaxosAppServer::StartAcceptorThread()
@@ -163,16 +273,15 @@ void PaxosAppServer::StopAcceptorThread()
 {
 }
 
-void PaxosAppServer::ReceiveMessage(ns3::Ptr<ns3::Socket> socket)
+void PaxosAppServer::ReceiveMessage(ns3::Ptr<ns3::Socket>, std::span<const ns3::Socket::RecvItem> batch)
 {
-    ns3::Ptr<ns3::Packet> packet;
-    ns3::Address from;
-
-    // Receive the packet
-    while ((packet = socket->RecvFrom(from)))
+    // The whole batch is handled in this event, the handlers are called
+    // inline rather than scheduled one event per message
+    for (const auto &item : batch)
     {
+        ns3::Ptr<ns3::Packet> packet = item.packet;
         NS_LOG_INFO("PaxosAppServer " << m_nodeId << " received a packet of size " << packet->GetSize()
-                                      << " from " << ns3::InetSocketAddress::ConvertFrom(from).GetIpv4());
+                                      << " from " << ns3::InetSocketAddress::ConvertFrom(item.from).GetIpv4());
 
         PaxosFrame pktHeader;
         packet->RemoveHeader(pktHeader);
@@ -180,26 +289,50 @@ void PaxosAppServer::ReceiveMessage(ns3::Ptr<ns3::Socket> socket)
         if (pktHeader.IsProposal())
         {
             NS_LOG_INFO("PaxosAppServer " << m_nodeId << " receiving proposal message for Proposal ID " << pktHeader.GetProposalId());
-            // Schedule the proposal to be processed
-            ns3::Simulator::ScheduleNow(&PaxosAppServer::DoReceivedProposalMessage, this, pktHeader);
+            DoReceivedProposalMessage(pktHeader);
         }
         else if (pktHeader.IsAccept())
         {
             NS_LOG_INFO("PaxosAppServer " << m_nodeId << " receiving accept message for Proposal ID " << pktHeader.GetProposalId());
-            // Schedule the proposal to be processed
-            ns3::Simulator::ScheduleNow(&PaxosAppServer::DoReceivedAcceptMessage, this, pktHeader);
+            DoReceivedAcceptMessage(pktHeader);
         }
         else if (pktHeader.IsDecision())
         {
             NS_LOG_INFO("PaxosAppServer " << m_nodeId << " receiving decision message for Proposal ID " << pktHeader.GetProposalId());
-            // Schedule the proposal to be processed
-            ns3::Simulator::ScheduleNow(&PaxosAppServer::DoReceivedDecisionMessage, this, pktHeader);
+            DoReceivedDecisionMessage(pktHeader);
         }
         else if (pktHeader.IsDecisionAck())
         {
             NS_LOG_INFO("PaxosAppServer " << m_nodeId << " receiving decision ack message for Proposal ID " << pktHeader.GetProposalId());
-            // Schedule the proposal to be processed
-            ns3::Simulator::ScheduleNow(&PaxosAppServer::DoReceivedDecisionAckMessage, this, pktHeader);
+            DoReceivedDecisionAckMessage(pktHeader);
+        }
+        else if (pktHeader.IsSequencedRequest())
+        {
+            DoReceivedSequencedRequest(pktHeader);
+        }
+        else if (pktHeader.IsGapRequest())
+        {
+            DoReceivedGapRequest(pktHeader);
+        }
+        else if (pktHeader.IsGapFill())
+        {
+            DoReceivedGapFill(pktHeader);
+        }
+        else if (pktHeader.IsSequencedAck())
+        {
+            DoReceivedSequencedAck(pktHeader);
+        }
+        else if (pktHeader.IsSequencedCommit())
+        {
+            DoReceivedSequencedCommit(pktHeader);
+        }
+        else if (pktHeader.IsLeaseRequest())
+        {
+            DoReceivedLeaseRequest(pktHeader);
+        }
+        else if (pktHeader.IsLeaseAck())
+        {
+            DoReceivedLeaseAck(pktHeader);
         }
         else
         {
@@ -213,6 +346,7 @@ void PaxosAppServer::DoReceivedProposalMessage(PaxosFrame frame)
 {
     // Check if the proposer is the right one
     NS_LOG_INFO("PaxosAppServer " << m_nodeId << " receiving proposal message for Proposal ID " << frame.GetProposalId());
+    PaxosTracer::Record(PAXOS_TRACE_PROPOSAL_RECEIVED, m_nodeId, frame.GetProposalId(), frame.GetProposeTime());
     uint32_t proposerId = frame.GetProposerId();
 
     // Set Accept time
@@ -237,6 +371,7 @@ void PaxosAppServer::DoReceivedProposalMessage(PaxosFrame frame)
 void PaxosAppServer::SendAcceptMessage(PaxosFrame frame)
 {
     NS_LOG_INFO("PaxosAppServer " << m_nodeId << " sending accept message for Proposal ID " << frame.GetProposalId());
+    PaxosTracer::Record(PAXOS_TRACE_ACCEPT_SENT, m_nodeId, frame.GetProposalId());
 
     frame.SetMessageType(PaxosFrame::ACCEPT);
     frame.SetAcceptorId(m_serverId);
@@ -257,6 +392,7 @@ void PaxosAppServer::SendAcceptMessage(PaxosFrame frame)
 void PaxosAppServer::DoReceivedAcceptMessage(PaxosFrame frame)
 {
     NS_LOG_INFO("PaxosAppServer " << m_nodeId << " receiving accept message for Proposal ID " << frame.GetProposalId());
+    PaxosTracer::Record(PAXOS_TRACE_ACCEPT_RECEIVED, m_nodeId, frame.GetProposalId(), frame.GetAcceptTime());
 
     uint64_t proposerId = frame.GetProposerId();
     uint64_t proposalId = frame.GetProposalId();
@@ -286,11 +422,12 @@ void PaxosAppServer::DoReceivedAcceptMessage(PaxosFrame frame)
     {
         proposal->setDecisionTime(ns3::Simulator::Now());
         proposal->setNumDecisionAck(1);
+        PaxosTracer::Record(PAXOS_TRACE_DECIDED, m_nodeId, proposalId, proposal->getProposeTime());
         SendDecisionMessage(frame);
 
         // If in sync mode, we can remove the proposal from the map
         // if we are in async mode, we need another round of decisionAck
-        if (!s_async)
+        if (s_mode == PAXOS_MODE_SYNC)
         {
             NS_LOG_INFO("PaxosAppServer " << m_nodeId << " adding proposal ID " << proposalId << " to decided proposals queue.");
             m_decidedProposalQueue.push(proposal);
@@ -315,28 +452,14 @@ void PaxosAppServer::SendDecisionMessage(PaxosFrame frame)
     ns3::Ptr<ns3::Packet> packet = ns3::Create<ns3::Packet>();
     packet->AddHeader(frame);
 
-    // Send the decision message to all nodes
-    for (auto node : m_nodes)
-    {
-        if (node.serverId == m_nodeId)
-        {
-            // Do not send the decision to itself
-            continue;
-        }
-
-        ns3::Ipv4Address address = node.address;
-        uint16_t port = node.paxosPort;
-
-        // Send the packet to the node
-        ns3::InetSocketAddress to(address, port);
-
-        m_sendSocket->SendTo(packet, 0, to);
-    }
+    // Send the decision message to all other nodes
+    m_sendSocket->SendToMany(packet, 0, m_peerAddresses);
 }
 
 void PaxosAppServer::DoReceivedDecisionMessage(PaxosFrame frame)
 {
     NS_LOG_INFO("PaxosAppServer " << m_nodeId << " received decision message for Proposal ID " << frame.GetProposalId());
+    PaxosTracer::Record(PAXOS_TRACE_DECISION_RECEIVED, m_nodeId, frame.GetProposalId(), frame.GetDecisionTime());
 
     // Add the decision to the decided proposals queue
     std::shared_ptr<Proposal> proposal = std::make_shared<Proposal>();
@@ -348,7 +471,7 @@ void PaxosAppServer::DoReceivedDecisionMessage(PaxosFrame frame)
     proposal->setAcceptTime(frame.GetAcceptTime());
     proposal->setDecisionTime(frame.GetDecisionTime());
 
-    if (s_async)
+    if (s_mode == PAXOS_MODE_ASYNC)
     {
         // If we are in async mode, we need response to the server
         PaxosFrame responseFrame;
@@ -379,9 +502,10 @@ void PaxosAppServer::DoReceivedDecisionMessage(PaxosFrame frame)
 void PaxosAppServer::DoReceivedDecisionAckMessage(PaxosFrame frame)
 {
     NS_LOG_INFO("PaxosAppServer " << m_nodeId << " received decision ack message for Proposal ID " << frame.GetProposalId());
+    PaxosTracer::Record(PAXOS_TRACE_DECISION_ACK_RECEIVED, m_nodeId, frame.GetProposalId(), frame.GetProposeTime());
 
     // Check the current mode
-    if (s_async)
+    if (s_mode == PAXOS_MODE_ASYNC)
     {
         // Asynchronous mode
         // Check message and increase the number of acks
@@ -10,8 +10,13 @@
 
 #include "paxos-common.h"
 #include "paxos-frame.h"
+#include "paxos-trace.h"
 
+#include <filesystem>
 #include <unordered_map>
+#include <map>
+#include <set>
+#include <span>
 #include <queue>
 
 /**
@@ -29,6 +34,30 @@ struct ProposalMinHeapCompare {
     }
 };
 
+// State of an instance in leaderless mode
+struct LeaderlessInstance {
+    enum Status {
+        PRE_ACCEPTED = 100,
+        ACCEPTED,
+        COMMITTED,
+        EXECUTED
+    };
+
+    Status status = PRE_ACCEPTED;
+    uint32_t value = 0;
+    uint64_t seq = 0;
+    std::vector<uint64_t> deps;     // Highest conflicting instance of each replica, 0 for none
+    ns3::Time createTime;           // Time when client create the request
+    ns3::Time commitTime;           // Time when the instance is committed on this replica
+
+    // Only used by the command leader
+    uint32_t numReplies = 0;        // Number of PreAcceptOK or AcceptOK received
+    bool fastPath = true;           // Whether all PreAcceptOK agreed with the original attributes
+};
+
+// (command leader, instance number)
+typedef std::pair<uint32_t, uint64_t> LeaderlessInstanceId;
+
 class PaxosAppServer : public ns3::Application
 {
 public:
@@ -41,7 +70,7 @@ public:
         PAXOS_LEADER_DECIDED
     };
 
-    static bool s_async; // Whether to use synchronous or asynchronous Paxos
+    static PaxosMode s_mode; // Consensus mode, see PaxosMode
     static uint32_t s_leader;
     static ns3::Time s_proposeTimeout;
 
@@ -52,6 +81,7 @@ public:
     static ns3::TypeId GetTypeId(void);
     virtual void StartApplication(void);
     virtual void StopApplication(void);
+    void Crash();   // Fail-stop: stop proposing and drop all incoming messages
     void SetNodeId(uint32_t serverId);
     uint32_t GetNodeId() const;
 
@@ -64,6 +94,13 @@ public:
     void StopListenerThread();
     void CreateProposalFromRequest(RequestFrame requestFrame);
 
+    // Read Functions
+    void HandleReadRequest(RequestFrame requestFrame);
+    void ServeRead(RequestFrame requestFrame, ns3::Time receiveTime);
+    void RenewLease();
+    void DoReceivedLeaseRequest(PaxosFrame frame);
+    void DoReceivedLeaseAck(PaxosFrame frame);
+
     // Proposer Functions
     void StartProposerThread();
     void StopProposerThread();
@@ -74,7 +111,7 @@ public:
     // Acceptor Functions
     void StartAcceptorThread();
     void StopAcceptorThread();
-    void ReceiveMessage(ns3::Ptr<ns3::Socket> socket);
+    void ReceiveMessage(ns3::Ptr<ns3::Socket> socket, std::span<const ns3::Socket::RecvItem> batch);
     void SendAcceptMessage(PaxosFrame frame);
     void SendDecisionMessage(PaxosFrame frame);
 
@@ -84,16 +121,37 @@ public:
     void DoReceivedDecisionMessage(PaxosFrame frame);
     void DoReceivedDecisionAckMessage(PaxosFrame frame);
 
+    // Sequencer Mode Functions
+    void DoReceivedSequencedRequest(PaxosFrame frame);
+    void DoReceivedGapRequest(PaxosFrame frame);
+    void DoReceivedGapFill(PaxosFrame frame);
+    void DoReceivedSequencedAck(PaxosFrame frame);
+    void DoReceivedSequencedCommit(PaxosFrame frame);
+
+    // Leaderless Mode Functions
+    void ReceiveLeaderlessMessage(ns3::Ptr<ns3::Socket> socket, std::span<const ns3::Socket::RecvItem> batch);
+    void DoLeaderlessPropose();
+    void DoReceivedPreAccept(LeaderlessFrame frame);
+    void DoReceivedPreAcceptOk(LeaderlessFrame frame);
+    void DoReceivedLeaderlessAccept(LeaderlessFrame frame);
+    void DoReceivedLeaderlessAcceptOk(LeaderlessFrame frame);
+    void DoReceivedCommit(LeaderlessFrame frame);
+
     // Configuration Function
     void SetClockSyncError(ns3::Time clockSyncError);
     void SetBoundedMessageDelay(ns3::Time boundedMessageDelay);
     void SetNodeFailureRate(double nodeFailureRate);
+    void SetIpTos(uint8_t ipTos);
+    void SetLeaseDuration(ns3::Time leaseDuration);
+    void SetReadRatio(double readRatio);
+    void SetOutputDir(std::string outputDir);
 
 private:
     uint32_t m_nodeId;  // Node ID of this node
     uint32_t m_serverId; // Use serverId instead of nodeId
     uint32_t m_numNodes;    // Number of nodes in the network
     NodeInfoList m_nodes; // List of all nodes in the network }; 
+    std::vector<ns3::Address> m_peerAddresses; // Paxos ports of the other nodes, for SendToMany
 
     ns3::Time m_proposePeriod; // Period between proposing
 
@@ -119,13 +177,63 @@ private:
     ns3::Time m_clockSyncError; // Maximum clock synchronization error
     ns3::Time m_boundedMessageDelay; // Maximum message delay
 
-    double m_nodeFailureRate;
+    double m_nodeFailureRate; // Probability to crash during the run, see StartApplication
+    ns3::EventId m_crashEvent; // Event ID for crashing
+    uint8_t m_ipTos; // IP TOS of the Paxos messages, 0 means unmarked
+    std::filesystem::path m_outputDir; // Directory of the log files, empty means the current directory
 
     // Leader state
     PaxosLeaderState m_leaderState;
     std::shared_ptr<Proposal> m_currentProposal; // Current proposal being proposed
     uint32_t m_numDecidedAck; // Number of acceptors that have decided on the current proposal
     void proposeTimerExpired(uint64_t proposalId); // Check if proposer do not get enough acceptors to decide on the proposal
+
+    // Read state
+    ns3::Time m_slotOrigin;     // Start of the first slot, only for synchronous mode
+    double m_readRatio;         // Fraction of client requests that are reads, the leader holds a lease only if > 0
+    ns3::Time m_leaseDuration;  // Duration of the leader's read lease, only for asynchronous mode
+    ns3::Time m_leaseStart;     // Start of the lease being requested
+    ns3::Time m_leaseExpiry;    // Reads are served locally until this time
+    uint32_t m_numLeaseAcks;    // Number of replicas granting the lease being requested
+    ns3::EventId m_leaseEvent;  // Event ID for renewing the lease
+    std::queue<std::pair<RequestFrame, ns3::Time>> m_pendingReads; // Reads waiting for a lease, with receive time
+    std::vector<std::shared_ptr<Proposal>> m_servedReads; // Served reads, for the read log
+
+    // Sequencer mode state
+    uint64_t m_nextSequenceNumber; // Next sequence number expected from the sequencer
+    std::map<uint64_t, std::shared_ptr<Proposal>> m_sequencedLog; // Log entries by sequence number
+    std::map<uint64_t, PaxosFrame> m_sequencedBuffer; // Requests received after a gap
+    std::map<uint64_t, ns3::EventId> m_gapRequested; // Sequence numbers requested from the leader, with their retransmit event
+    std::set<uint64_t> m_undecidedSequence; // Sequence numbers in the log and not decided yet
+    std::map<uint64_t, std::map<uint32_t, uint32_t>> m_sequencedAcks; // Value acked by each replica per undecided sequence number, only on the leader
+    ns3::EventId m_sequencedRetryEvent; // Retries the entries undecided for a propose timeout, see sequencedRetryTimerExpired
+    void BufferSequencedEntry(PaxosFrame frame);
+    void AppendSequencedEntry(PaxosFrame frame);
+    void DeliverSequencedBuffer();
+    void DecideSequencedEntry(uint64_t sequenceNumber);
+    void CheckSequencedQuorum(uint64_t sequenceNumber);
+    void HandleSequenceGap(uint64_t sequenceNumber);
+    void SendGapRequest(uint64_t sequenceNumber);
+    void gapRequestTimerExpired(uint64_t sequenceNumber); // Ask the leader again if the slot is still undecided
+    void sequencedRetryTimerExpired(); // The leader resends them to the replicas that did not ack them, the others ask the leader
+    ns3::Ptr<ns3::Packet> CreateSequencedPacket(uint64_t sequenceNumber, uint32_t messageType); // The log entry as a message
+    void SendSequencedEntry(uint64_t sequenceNumber, uint32_t messageType, uint32_t toId);
+
+    // Leaderless mode state
+    uint64_t m_nextInstance; // Next instance number led by this replica
+    std::map<LeaderlessInstanceId, LeaderlessInstance> m_instances; // All instances seen by this replica
+    std::unordered_map<uint32_t, std::vector<uint64_t>> m_keyConflicts; // Highest instance of each replica per key
+    std::set<LeaderlessInstanceId> m_pendingExecution; // Committed instances not executed yet
+    std::map<LeaderlessInstanceId, std::vector<LeaderlessInstanceId>> m_blockedExecution; // Committed instances waiting for the commit of an instance
+    uint64_t m_numExecuted; // Number of executed instances, the position in the log
+    uint64_t m_numFastCommits; // Instances this replica committed on the fast path
+    uint64_t m_numSlowCommits; // Instances this replica committed on the slow path
+    void UpdateLeaderlessAttributes(LeaderlessInstanceId id, uint32_t value, uint64_t &seq, std::vector<uint64_t> &deps);
+    void RecordLeaderlessInstance(LeaderlessInstanceId id, const LeaderlessFrame &frame, LeaderlessInstance::Status status);
+    void SendLeaderlessMessage(LeaderlessInstanceId id, uint32_t messageType, uint32_t toId);
+    void CommitLeaderlessInstance(LeaderlessInstanceId id);
+    void ExecuteLeaderlessInstances(LeaderlessInstanceId id); // After the commit of id
+    bool ExecuteLeaderlessInstance(LeaderlessInstanceId id); // False if blocked, it waits in m_blockedExecution
 };
 
 #endif // PAXOS_APP_HH
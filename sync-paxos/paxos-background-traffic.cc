@@ -0,0 +1,246 @@
+#include "paxos-background-traffic.h"
+
+NS_LOG_COMPONENT_DEFINE("PaxosBackgroundApp");
+
+// Flow size CDFs commonly used in datacenter transport studies (pFabric, HPCC).
+// Sizes are in bytes.
+static const std::vector<std::pair<double, double>> s_webSearchCdf = {
+    {0, 0.0},
+    {10000, 0.15},
+    {20000, 0.20},
+    {30000, 0.30},
+    {50000, 0.40},
+    {80000, 0.53},
+    {200000, 0.60},
+    {1000000, 0.70},
+    {2000000, 0.80},
+    {5000000, 0.90},
+    {10000000, 0.97},
+    {30000000, 1.0},
+};
+
+static const std::vector<std::pair<double, double>> s_dataMiningCdf = {
+    {0, 0.0},
+    {180, 0.10},
+    {216, 0.20},
+    {560, 0.30},
+    {900, 0.40},
+    {1100, 0.50},
+    {1870, 0.60},
+    {3160, 0.70},
+    {10000, 0.80},
+    {400000, 0.90},
+    {3160000, 0.95},
+    {100000000, 0.98},
+    {1000000000, 1.0},
+};
+
+PaxosBackgroundApp::PaxosBackgroundApp()
+    : m_flowSizeCdf(FLOW_SIZE_WEB_SEARCH), m_flowArrivalRate(0), m_numFlows(0), m_totalBytes(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PaxosBackgroundApp::PaxosBackgroundApp(std::vector<ns3::Ipv4Address> peers, FlowSizeCdf flowSizeCdf, double flowArrivalRate)
+    : m_peers(peers), m_flowSizeCdf(flowSizeCdf), m_flowArrivalRate(flowArrivalRate), m_numFlows(0), m_totalBytes(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PaxosBackgroundApp::~PaxosBackgroundApp()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ns3::TypeId
+PaxosBackgroundApp::GetTypeId(void)
+{
+    static ns3::TypeId tid = ns3::TypeId("PaxosBackgroundApp")
+        .SetParent<ns3::Application>()
+        .AddConstructor<PaxosBackgroundApp>();
+    return tid;
+}
+
+const std::vector<std::pair<double, double>> &
+PaxosBackgroundApp::GetCdfPoints(FlowSizeCdf flowSizeCdf)
+{
+    if (flowSizeCdf == FLOW_SIZE_DATA_MINING)
+    {
+        return s_dataMiningCdf;
+    }
+    return s_webSearchCdf;
+}
+
+bool
+PaxosBackgroundApp::ParseFlowSizeCdf(std::string name, FlowSizeCdf &flowSizeCdf)
+{
+    if (name == "web-search")
+    {
+        flowSizeCdf = FLOW_SIZE_WEB_SEARCH;
+        return true;
+    }
+    if (name == "data-mining")
+    {
+        flowSizeCdf = FLOW_SIZE_DATA_MINING;
+        return true;
+    }
+    return false;
+}
+
+double
+PaxosBackgroundApp::GetMeanFlowSize(FlowSizeCdf flowSizeCdf)
+{
+    // The flow size is interpolated linearly between the CDF points,
+    // so every segment contributes its midpoint weighted by its probability.
+    const auto &points = GetCdfPoints(flowSizeCdf);
+    double mean = 0;
+    for (size_t i = 1; i < points.size(); i++)
+    {
+        mean += (points[i].first + points[i - 1].first) / 2 * (points[i].second - points[i - 1].second);
+    }
+    return mean;
+}
+
+uint64_t
+PaxosBackgroundApp::GetNumFlows() const
+{
+    return m_numFlows;
+}
+
+uint64_t
+PaxosBackgroundApp::GetTotalBytes() const
+{
+    return m_totalBytes;
+}
+
+void
+PaxosBackgroundApp::StartApplication(void)
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_peers.empty() || m_flowArrivalRate <= 0)
+    {
+        NS_LOG_INFO("PaxosBackgroundApp has no peer or no load, do not generate flows");
+        return;
+    }
+
+    m_arrivalRandom = ns3::CreateObject<ns3::ExponentialRandomVariable>();
+    m_arrivalRandom->SetAttribute("Mean", ns3::DoubleValue(1.0 / m_flowArrivalRate));
+
+    m_sizeRandom = ns3::CreateObject<ns3::EmpiricalRandomVariable>();
+    m_sizeRandom->SetInterpolate(true);
+    for (auto point : GetCdfPoints(m_flowSizeCdf))
+    {
+        m_sizeRandom->CDF(point.first, point.second);
+    }
+
+    m_peerRandom = ns3::CreateObject<ns3::UniformRandomVariable>();
+
+    ScheduleNextFlow();
+}
+
+void
+PaxosBackgroundApp::StopApplication(void)
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_nextFlowEvent.IsPending())
+    {
+        m_nextFlowEvent.Cancel();
+    }
+
+    // Abort the flows that are still running
+    for (auto it : m_remainingBytes)
+    {
+        it.first->SetSendCallback(ns3::MakeNullCallback<void, ns3::Ptr<ns3::Socket>, uint32_t>());
+        it.first->Close();
+    }
+    m_remainingBytes.clear();
+
+    NS_LOG_INFO("PaxosBackgroundApp started " << m_numFlows << " flows, " << m_totalBytes << " bytes");
+}
+
+void
+PaxosBackgroundApp::ScheduleNextFlow()
+{
+    ns3::Time interval = ns3::Seconds(m_arrivalRandom->GetValue());
+    m_nextFlowEvent = ns3::Simulator::Schedule(interval, &PaxosBackgroundApp::StartFlow, this);
+}
+
+void
+PaxosBackgroundApp::StartFlow()
+{
+    NS_LOG_FUNCTION(this);
+
+    // Check if the application has already been stopped
+    if (ns3::Simulator::Now() >= m_stopTime)
+    {
+        return;
+    }
+
+    ns3::Ipv4Address peer = m_peers[m_peerRandom->GetInteger(0, m_peers.size() - 1)];
+    uint64_t size = std::max<uint64_t>(1, static_cast<uint64_t>(m_sizeRandom->GetValue()));
+
+    auto tid = ns3::TypeId::LookupByName("ns3::TcpSocketFactory");
+    ns3::Ptr<ns3::Socket> socket = ns3::Socket::CreateSocket(GetNode(), tid);
+    if (!socket)
+    {
+        NS_FATAL_ERROR("Failed to create TCP socket");
+    }
+
+    socket->Bind();
+    socket->Connect(ns3::InetSocketAddress(peer, BACKGROUND_PORT));
+    socket->ShutdownRecv();
+    socket->SetConnectCallback(ns3::MakeCallback(&PaxosBackgroundApp::ConnectionSucceeded, this),
+                               ns3::MakeCallback(&PaxosBackgroundApp::ConnectionFailed, this));
+    socket->SetSendCallback(ns3::MakeCallback(&PaxosBackgroundApp::SendData, this));
+
+    m_remainingBytes[socket] = size;
+    m_numFlows++;
+    m_totalBytes += size;
+    NS_LOG_INFO("PaxosBackgroundApp starting flow of " << size << " bytes to " << peer);
+
+    ScheduleNextFlow();
+}
+
+void
+PaxosBackgroundApp::ConnectionSucceeded(ns3::Ptr<ns3::Socket> socket)
+{
+    SendData(socket, socket->GetTxAvailable());
+}
+
+void
+PaxosBackgroundApp::ConnectionFailed(ns3::Ptr<ns3::Socket> socket)
+{
+    NS_LOG_WARN("PaxosBackgroundApp failed to connect background flow");
+    m_remainingBytes.erase(socket);
+}
+
+void
+PaxosBackgroundApp::SendData(ns3::Ptr<ns3::Socket> socket, uint32_t available)
+{
+    auto it = m_remainingBytes.find(socket);
+    if (it == m_remainingBytes.end())
+    {
+        return;
+    }
+
+    // Fill the TCP send buffer, the socket calls back when there is room again
+    while (it->second > 0 && socket->GetTxAvailable() > 0)
+    {
+        uint32_t size = std::min<uint64_t>(it->second, socket->GetTxAvailable());
+        int sent = socket->Send(ns3::Create<ns3::Packet>(size));
+        if (sent <= 0)
+        {
+            return;
+        }
+        it->second -= sent;
+    }
+
+    if (it->second == 0)
+    {
+        // TCP sends FIN after the buffered data
+        socket->Close();
+        m_remainingBytes.erase(it);
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef PAXOS_BACKGROUND_TRAFFIC_H
+#define PAXOS_BACKGROUND_TRAFFIC_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/application.h"
+
+#include "paxos-common.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+// The PaxosBackgroundApp class generates background TCP flows on a host.
+//
+// Flows arrive as a Poisson process, the flow size is drawn from an empirical
+// datacenter flow size CDF and the destination is picked uniformly from the
+// peer list. Every host that may receive background flows runs a PacketSink
+// on BACKGROUND_PORT.
+
+class PaxosBackgroundApp : public ns3::Application
+{
+public:
+    enum FlowSizeCdf {
+        FLOW_SIZE_WEB_SEARCH = 100,   // DCTCP web search workload
+        FLOW_SIZE_DATA_MINING         // VL2 data mining workload
+    };
+
+    PaxosBackgroundApp();
+    PaxosBackgroundApp(std::vector<ns3::Ipv4Address> peers, FlowSizeCdf flowSizeCdf, double flowArrivalRate);
+    ~PaxosBackgroundApp();
+
+    static ns3::TypeId GetTypeId(void);
+
+    void StartApplication(void) override;
+    void StopApplication(void) override;
+
+    // Parse "web-search" or "data-mining", return false if the name is unknown
+    static bool ParseFlowSizeCdf(std::string name, FlowSizeCdf &flowSizeCdf);
+    // Mean flow size in bytes of the given CDF
+    static double GetMeanFlowSize(FlowSizeCdf flowSizeCdf);
+    // (flow size in bytes, cumulative probability)
+    static const std::vector<std::pair<double, double>> &GetCdfPoints(FlowSizeCdf flowSizeCdf);
+
+    uint64_t GetNumFlows() const;
+    uint64_t GetTotalBytes() const;
+
+private:
+    void ScheduleNextFlow();
+    void StartFlow();
+    void ConnectionSucceeded(ns3::Ptr<ns3::Socket> socket);
+    void ConnectionFailed(ns3::Ptr<ns3::Socket> socket);
+    void SendData(ns3::Ptr<ns3::Socket> socket, uint32_t available);
+
+    std::vector<ns3::Ipv4Address> m_peers; // Possible destinations of the flows
+    FlowSizeCdf m_flowSizeCdf;  // Flow size distribution
+    double m_flowArrivalRate;   // Flows per second started by this host
+
+    ns3::EventId m_nextFlowEvent; // Event ID of the next flow arrival
+    std::map<ns3::Ptr<ns3::Socket>, uint64_t> m_remainingBytes; // Bytes left to send per active flow
+
+    ns3::Ptr<ns3::ExponentialRandomVariable> m_arrivalRandom; // Flow inter-arrival time in seconds
+    ns3::Ptr<ns3::EmpiricalRandomVariable> m_sizeRandom;      // Flow size in bytes
+    ns3::Ptr<ns3::UniformRandomVariable> m_peerRandom;        // Destination index
+
+    uint64_t m_numFlows;    // Number of flows started
+    uint64_t m_totalBytes;  // Number of bytes of all flows started
+};
+
+#endif // PAXOS_BACKGROUND_TRAFFIC_H
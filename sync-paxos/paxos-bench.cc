@@ -0,0 +1,280 @@
+#include "ns3/core-module.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Benchmark of the simulator on a fixed set of sync-paxos scenarios
+// Runs each scenario of the cross product of cluster size (small, large),
+// consensus mode (sync, async), client load (low, high) and failures (none,
+// crash of the minority servers), one at a time so that the wall clock
+// times are comparable, and reports for each one, in JSON:
+//   decisionsPerSecond   decisions of server 0 per simulated second
+//   eventsPerSecond      simulator events per wall clock second of Run()
+//   peakRssKb            peak resident set size of the sync-paxos process
+//   p50LatencyNs         commit latency, from the client request to the
+//   p99LatencyNs           decision at server 0, which never fails
+// Sample usage: sync-paxos-bench --output=bench.json --filter=large
+// With --threads, the speedup of the multithreaded simulator is the ratio of
+// the runSeconds of a run with --threads=1 to the ones of this run.
+
+struct BenchScenario {
+    std::string name;
+    std::vector<std::string> args; // sync-paxos options
+};
+
+struct BenchResult {
+    int status = -1;
+    uint64_t decided = 0;
+    uint64_t events = 0;
+    double runSeconds = 0;
+    double wallSeconds = 0;
+    long peakRssKb = 0;
+    int64_t p50LatencyNs = 0;
+    int64_t p99LatencyNs = 0;
+};
+
+static std::vector<BenchScenario> MakeScenarios(const std::string &duration)
+{
+    struct Option {
+        std::string name;
+        std::vector<std::string> args;
+    };
+    // The fabric links have a 5us delay in sync mode, the async link delay is per path
+    const std::vector<Option> clusters = {
+        {"small", {"--numSpines=2", "--numLeaves=3", "--hostsPerLeaf=2"}},
+        {"large", {"--numSpines=4", "--numLeaves=9", "--hostsPerLeaf=8"}},
+    };
+    const std::vector<Option> modes = {
+        {"sync", {"--mode=sync", "--boundedMessageDelay=50us", "--clockSyncError=10ns"}},
+        {"async", {"--mode=async", "--linkDelay=20us"}},
+    };
+    const std::vector<Option> loads = {
+        {"low", {"--requestInterval=100us"}},
+        {"high", {"--requestInterval=10us"}},
+    };
+    const std::vector<Option> failures = {
+        {"nofail", {"--failureRate=0"}},
+        {"fail", {"--failureRate=1"}},
+    };
+
+    std::vector<BenchScenario> scenarios;
+    for (auto &cluster : clusters)
+    {
+        for (auto &mode : modes)
+        {
+            for (auto &load : loads)
+            {
+                for (auto &failure : failures)
+                {
+                    BenchScenario scenario;
+                    scenario.name = cluster.name + "-" + mode.name + "-" + load.name + "-" + failure.name;
+                    for (auto *option : {&cluster, &mode, &load, &failure})
+                    {
+                        scenario.args.insert(scenario.args.end(), option->args.begin(), option->args.end());
+                    }
+                    scenario.args.push_back("--duration=" + duration);
+                    scenarios.push_back(scenario);
+                }
+            }
+        }
+    }
+    return scenarios;
+}
+
+// Run sync-paxos to the end, returns its exit status and peak RSS
+static int RunScenario(const std::string &binary, const std::vector<std::string> &args,
+                       const std::filesystem::path &outputDir, long &peakRssKb)
+{
+    std::filesystem::create_directories(outputDir);
+    std::string logPath = (outputDir / "sync-paxos.log").string();
+
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        return -1;
+    }
+    if (pid == 0)
+    {
+        // Child: log output goes to the scenario directory
+        FILE *log = freopen(logPath.c_str(), "w", stdout);
+        if (log == nullptr || dup2(fileno(stdout), fileno(stderr)) < 0)
+        {
+            _exit(127);
+        }
+        std::vector<char *> argv;
+        argv.push_back(const_cast<char *>(binary.c_str()));
+        for (auto &arg : args)
+        {
+            argv.push_back(const_cast<char *>(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+        execv(binary.c_str(), argv.data());
+        _exit(127);
+    }
+
+    int status;
+    struct rusage usage;
+    if (wait4(pid, &status, 0, &usage) != pid)
+    {
+        return -1;
+    }
+    peakRssKb = usage.ru_maxrss;
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+// Events and wall clock time of Run(), from the file written by sync-paxos --stats
+static bool ReadStats(const std::filesystem::path &path, BenchResult &result)
+{
+    std::ifstream stats(path);
+    std::string line;
+    if (!std::getline(stats, line) || !std::getline(stats, line))
+    {
+        return false;
+    }
+    char comma;
+    std::istringstream values(line);
+    return bool(values >> result.events >> comma >> result.runSeconds);
+}
+
+// Commit latencies of the decision log of server 0, in ns. The proposal id is
+// the time stamp of the client request in the leader based modes.
+static std::vector<int64_t> ReadLatencies(const std::filesystem::path &outputDir)
+{
+    std::vector<int64_t> latencies;
+    std::ifstream log(outputDir / "server-0-decision-log.dat");
+    std::string line;
+    std::getline(log, line); // header
+    while (std::getline(log, line))
+    {
+        // index,proposalId,proposerId,value,decidedTime e.g. +1000123456ns
+        std::vector<std::string> fields;
+        std::istringstream stream(line);
+        std::string field;
+        while (std::getline(stream, field, ','))
+        {
+            fields.push_back(field);
+        }
+        if (fields.size() != 5)
+        {
+            continue;
+        }
+        int64_t requestNs = std::stoll(fields[1]);
+        int64_t decidedNs = static_cast<int64_t>(std::stod(fields[4]));
+        latencies.push_back(decidedNs - requestNs);
+    }
+    return latencies;
+}
+
+static int64_t Percentile(std::vector<int64_t> &sorted, double percentile)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+    size_t index = static_cast<size_t>(percentile / 100 * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+int main(int argc, char *argv[])
+{
+    std::string outputDir = "bench";
+    std::string output = "";
+    std::string binary = "";
+    std::string filter = "";
+    std::string duration = "50ms";
+    uint32_t threads = 1;
+
+    ns3::CommandLine cmd;
+    cmd.Usage("Run sync-paxos on the fixed benchmark scenarios, one at a time,\n"
+              "and report the throughput, the simulator speed, the memory and the\n"
+              "commit latency of each scenario in JSON.");
+    cmd.AddValue("outputDir", "Root directory of the scenario results.", outputDir);
+    cmd.AddValue("output", "JSON report file. Default is the standard output.", output);
+    cmd.AddValue("binary", "Path of the sync-paxos executable. Default is next to this program.", binary);
+    cmd.AddValue("filter", "Only run the scenarios whose name contains this string, e.g. 'large-sync'.", filter);
+    cmd.AddValue("duration", "Run time of the Paxos applications in each scenario.", duration);
+    cmd.AddValue("threads", "Simulator threads of sync-paxos, more than one needs ns-3 built with NS3_MTP.", threads);
+    cmd.Parse(argc, argv);
+
+    if (binary.empty())
+    {
+        binary = (std::filesystem::absolute(argv[0]).parent_path() / "sync-paxos").string();
+    }
+    double simulatedSeconds = ns3::Time(duration).GetSeconds();
+
+    std::ostringstream json;
+    json << "{\n  \"duration\": \"" << duration << "\",\n  \"threads\": " << threads << ",\n  \"scenarios\": [";
+    bool first = true;
+    for (auto &scenario : MakeScenarios(duration))
+    {
+        if (scenario.name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+        std::filesystem::path scenarioDir = std::filesystem::path(outputDir) / scenario.name;
+        std::filesystem::path statsPath = scenarioDir / "run-stats.dat";
+        std::vector<std::string> args = scenario.args;
+        args.push_back("--outputDir=" + scenarioDir.string());
+        args.push_back("--stats=" + statsPath.string());
+        args.push_back("--threads=" + std::to_string(threads));
+        std::cerr << "Running " << scenario.name << std::endl;
+
+        BenchResult result;
+        auto start = std::chrono::steady_clock::now();
+        result.status = RunScenario(binary, args, scenarioDir, result.peakRssKb);
+        result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (result.status != 0 || !ReadStats(statsPath, result))
+        {
+            std::cerr << "Scenario " << scenario.name << " FAILED, see " << (scenarioDir / "sync-paxos.log").string()
+                      << std::endl;
+            result.status = result.status == 0 ? -1 : result.status;
+        }
+        else
+        {
+            std::vector<int64_t> latencies = ReadLatencies(scenarioDir);
+            std::sort(latencies.begin(), latencies.end());
+            result.decided = latencies.size();
+            result.p50LatencyNs = Percentile(latencies, 50);
+            result.p99LatencyNs = Percentile(latencies, 99);
+        }
+
+        json << (first ? "\n" : ",\n");
+        first = false;
+        json << "    {\"name\": \"" << scenario.name << "\", \"status\": " << result.status
+             << ", \"decisions\": " << result.decided
+             << ", \"decisionsPerSecond\": " << result.decided / simulatedSeconds
+             << ", \"events\": " << result.events
+             << ", \"eventsPerSecond\": " << (result.runSeconds > 0 ? result.events / result.runSeconds : 0)
+             << ", \"runSeconds\": " << result.runSeconds
+             << ", \"wallSeconds\": " << result.wallSeconds
+             << ", \"peakRssKb\": " << result.peakRssKb
+             << ", \"p50LatencyNs\": " << result.p50LatencyNs
+             << ", \"p99LatencyNs\": " << result.p99LatencyNs << "}";
+    }
+    json << "\n  ]\n}\n";
+
+    if (output.empty())
+    {
+        std::cout << json.str();
+    }
+    else
+    {
+        std::ofstream file(output);
+        file << json.str();
+        if (!file.good())
+        {
+            std::cerr << "Can not write " << output << std::endl;
+            return -1;
+        }
+    }
+    return 0;
+}
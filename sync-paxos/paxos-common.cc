@@ -1,5 +1,30 @@
 #include "paxos-common.h"
 
+bool ParsePaxosMode(std::string name, PaxosMode &mode)
+{
+    if (name == "sync")
+    {
+        mode = PAXOS_MODE_SYNC;
+    }
+    else if (name == "async")
+    {
+        mode = PAXOS_MODE_ASYNC;
+    }
+    else if (name == "sequencer")
+    {
+        mode = PAXOS_MODE_SEQUENCER;
+    }
+    else if (name == "leaderless")
+    {
+        mode = PAXOS_MODE_LEADERLESS;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
 Proposal::Proposal()
     : m_proposalId(0), m_nodeId(0), m_value(0), m_numAck(0) {}
 
@@ -28,6 +28,19 @@
 
 #define PAXOS_PORT (9000)   // This port is used for Paxos protocol
 #define SERVER_PORT (9001)  // This port is used for accept client reqeusts
+#define SEQUENCER_PORT (9002) // This port is used for the in-network sequencer
+#define BACKGROUND_PORT (9100) // This port is used for background TCP flows
+
+// Value of a NO-OP log entry, client requests never carry 0
+#define PAXOS_NOOP_VALUE (0)
+
+// Requests operate on key (value % PAXOS_NUM_KEYS), two requests conflict if their keys are equal.
+// Conflicting requests generated by the client use key 0.
+#define PAXOS_NUM_KEYS (1000000)
+
+// IP TOS used to mark consensus traffic (IPTOS_LOWDELAY).
+// ns-3 maps it to NS3_PRIO_INTERACTIVE, which the fabric queue discs put in the high priority band.
+#define PAXOS_IP_TOS (0x10)
 
 #define LOG_DIR ("data/")
 
@@ -41,10 +54,27 @@ typedef struct {
 
 typedef std::vector<NodeInfo> NodeInfoList;
 
+// Consensus mode
+enum PaxosMode {
+    PAXOS_MODE_SYNC = 100,  // Proposers rotate on a fixed schedule over a synchronous network
+    PAXOS_MODE_ASYNC,       // All requests go through a single leader (s_leader)
+    PAXOS_MODE_SEQUENCER,   // A spine stamps requests with a global sequence number (NOPaxos style)
+    PAXOS_MODE_LEADERLESS   // Every replica leads the requests it receives (EPaxos style)
+};
+
+// Parse "sync", "async", "sequencer" or "leaderless", return false if the name is unknown
+bool ParsePaxosMode(std::string name, PaxosMode &mode);
+
 // Define a PaxosConfig struct
 typedef struct PaxosConfig {
     // 1. System mode
     bool isSynchronous = true; // true: synchronous; false: asynchronous
+    PaxosMode mode = PAXOS_MODE_SYNC; // consensus mode, only sync mode runs on a synchronous network
+
+    // Clos fabric, one server on the first host of each leaf
+    uint32_t numSpines = 3;
+    uint32_t numLeaves = 5;               // also the number of servers
+    uint32_t numHostsPerLeaf = 5;
 
     // 2. Network Status
     // Only for synchronous mode
@@ -55,12 +85,64 @@ typedef struct PaxosConfig {
     std::string linkDelay = "10ms";       // link delay
     double packetLossRate = 0.0;          // packet loss rate
 
+    // Strict priority scheduling on fabric links, consensus traffic goes first
+    bool prioritizeConsensus = false;
+
+    // Fabric links
+    std::string linkType = "p2p";         // p2p or csma, a two node CSMA segment per link
+    bool staticNeighbors = false;         // permanent ARP entries at build time, no address resolution
+    bool analyticalLinks = false;         // no transmit end events on the idle point-to-point links
+    bool switches = false;                // leaf and spine nodes forward with PaxosSwitch, not the IPv4 stack
+    bool cutThrough = false;              // switch ports hand packets up after their headers
+    uint32_t switchTableSize = 4096;      // destinations of the switch lookup table
+
+    // Background cross traffic
+    std::string backgroundPattern = "none";         // none, all-to-all or incast
+    std::string backgroundFlowCdf = "web-search";   // web-search or data-mining
+    double backgroundLoad = 0.0;                    // target utilization of the host links (e.g. 0.3)
+    std::string backgroundModel = "packet";         // packet: TCP flows, fluid: max-min fair rates on the links
+
+    // Client workload
+    std::string requestInterval = "";     // time between client requests, empty: derived from the message delay
+    std::string duration = "1s";          // run time of the applications, from 1s
+    double readRatio = 0.0;               // fraction of requests that are reads, served without consensus
+    std::string leaseDuration = "10ms";   // read lease of the leader, only for asynchronous mode
+    double conflictRate = 0.0;            // fraction of requests on the hot key, used by leaderless mode
+
     // 3. Node Failure Rate
     double nodeFailureRate = 0.0;         // node failure rate (e.g. 0.01 means 1% failure rate)
 
     // 4. Paxos Config File Path
     std::string configFilePath = "";
 
+    // Event queue trace for scheduler benchmarks, empty: no trace
+    std::string eventTraceFile = "";
+
+    // Per callback profile of the simulator events, written at the end, empty: no profile
+    std::string profileFile = "";
+
+    // Binary trace of the protocol events, written at the end, empty: no trace
+    std::string traceFile = "";
+    uint32_t traceRecords = 1 << 20;      // ring buffer size, only the last records are kept
+
+    // Simulator statistics of the run (events, wall clock time), empty: none
+    std::string statsFile = "";
+
+    // Packets without metadata nor tags, see ns3::Packet::EnableLean
+    bool leanPackets = false;
+
+    // Directory of the result files, empty: current directory
+    std::string outputDir = "";
+
+    // Distributed simulation over MPI ranks, nodes are partitioned by leaf
+    bool distributed = false;             // run under mpirun, one partition per rank
+    bool nullMessage = true;              // null message engine, otherwise granted time window
+    uint32_t systemId = 0;                // rank of this process
+    uint32_t systemCount = 1;             // number of ranks
+
+    // Multithreaded simulation in one process, nodes are partitioned by leaf
+    uint32_t threads = 1;                 // simulator threads, 1: sequential simulator
+
     ns3::Time serverTimeout = ns3::MilliSeconds(300);
 } PaxosConfig;
 
@@ -0,0 +1,359 @@
+#include "paxos-fluid-background.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("PaxosFluidBackground");
+
+PaxosFluidBackground::PaxosFluidBackground()
+    : m_flowSizeCdf(PaxosBackgroundApp::FLOW_SIZE_WEB_SEARCH), m_numFlows(0), m_totalBytes(0), m_completedFlows(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PaxosFluidBackground::~PaxosFluidBackground()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ns3::TypeId
+PaxosFluidBackground::GetTypeId(void)
+{
+    static ns3::TypeId tid = ns3::TypeId("PaxosFluidBackground")
+        .SetParent<ns3::Object>()
+        .AddConstructor<PaxosFluidBackground>();
+    return tid;
+}
+
+void
+PaxosFluidBackground::SetFlowSizeCdf(PaxosBackgroundApp::FlowSizeCdf flowSizeCdf)
+{
+    m_flowSizeCdf = flowSizeCdf;
+}
+
+void
+PaxosFluidBackground::AddSource(ns3::Ptr<ns3::Node> host, std::vector<ns3::Ipv4Address> peers, double flowArrivalRate)
+{
+    NS_LOG_FUNCTION(this << host << flowArrivalRate);
+    if (peers.empty() || flowArrivalRate <= 0)
+    {
+        return;
+    }
+    m_sources.push_back({host, peers, flowArrivalRate});
+}
+
+void
+PaxosFluidBackground::SetStartStop(ns3::Time start, ns3::Time stop)
+{
+    m_stopTime = stop;
+    ns3::Simulator::Schedule(start, &PaxosFluidBackground::Start, this);
+    ns3::Simulator::Schedule(stop, &PaxosFluidBackground::Stop, this);
+}
+
+uint64_t
+PaxosFluidBackground::GetNumFlows() const
+{
+    return m_numFlows;
+}
+
+uint64_t
+PaxosFluidBackground::GetCompletedFlows() const
+{
+    return m_completedFlows;
+}
+
+void
+PaxosFluidBackground::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_sources.clear();
+    m_links.clear();
+    m_linkIndex.clear();
+    m_paths.clear();
+    m_flows.clear();
+    m_arrivalRandom = nullptr;
+    m_sizeRandom = nullptr;
+    m_peerRandom = nullptr;
+    ns3::Object::DoDispose();
+}
+
+void
+PaxosFluidBackground::Start()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_arrivalRandom = ns3::CreateObject<ns3::ExponentialRandomVariable>();
+    m_sizeRandom = ns3::CreateObject<ns3::EmpiricalRandomVariable>();
+    m_sizeRandom->SetInterpolate(true);
+    for (auto point : PaxosBackgroundApp::GetCdfPoints(m_flowSizeCdf))
+    {
+        m_sizeRandom->CDF(point.first, point.second);
+    }
+    m_peerRandom = ns3::CreateObject<ns3::UniformRandomVariable>();
+
+    m_lastUpdate = ns3::Simulator::Now();
+    m_arrivalEvents.resize(m_sources.size());
+    for (uint32_t i = 0; i < m_sources.size(); i++)
+    {
+        ns3::Time interval = ns3::Seconds(m_arrivalRandom->GetValue(1.0 / m_sources[i].flowArrivalRate, 0));
+        m_arrivalEvents[i] = ns3::Simulator::Schedule(interval, &PaxosFluidBackground::ArriveFlow, this, i);
+    }
+}
+
+void
+PaxosFluidBackground::Stop()
+{
+    NS_LOG_FUNCTION(this);
+
+    // Removed rather than cancelled, the simulation would otherwise run until
+    // the next arrival of every host
+    for (auto &event : m_arrivalEvents)
+    {
+        ns3::Simulator::Remove(event);
+    }
+    ns3::Simulator::Remove(m_completionEvent);
+
+    // Drop the flows that are still running, the links are free again
+    m_flows.clear();
+    Allocate();
+
+    NS_LOG_INFO("PaxosFluidBackground started " << m_numFlows << " flows, " << m_totalBytes << " bytes, "
+                << m_completedFlows << " flows completed on " << m_links.size() << " links");
+}
+
+void
+PaxosFluidBackground::ArriveFlow(uint32_t source)
+{
+    NS_LOG_FUNCTION(this << source);
+
+    if (ns3::Simulator::Now() >= m_stopTime)
+    {
+        return;
+    }
+
+    const Source &s = m_sources[source];
+    ns3::Ipv4Address peer = s.peers[m_peerRandom->GetInteger(0, s.peers.size() - 1)];
+    uint64_t size = std::max<uint64_t>(1, static_cast<uint64_t>(m_sizeRandom->GetValue()));
+
+    Flow flow;
+    flow.remaining = size;
+    if (GetPath(s.host, peer, flow.links))
+    {
+        Advance();
+        m_flows.push_back(flow);
+        m_numFlows++;
+        m_totalBytes += size;
+        NS_LOG_INFO("PaxosFluidBackground flow of " << size << " bytes from node " << s.host->GetId()
+                    << " to " << peer << " over " << flow.links.size() << " links");
+        Allocate();
+        ScheduleCompletion();
+    }
+    else
+    {
+        NS_LOG_WARN("PaxosFluidBackground has no point-to-point path from node " << s.host->GetId() << " to " << peer);
+    }
+
+    ns3::Time interval = ns3::Seconds(m_arrivalRandom->GetValue(1.0 / s.flowArrivalRate, 0));
+    m_arrivalEvents[source] = ns3::Simulator::Schedule(interval, &PaxosFluidBackground::ArriveFlow, this, source);
+}
+
+void
+PaxosFluidBackground::CompleteFlows()
+{
+    NS_LOG_FUNCTION(this);
+
+    Advance();
+
+    // The completion is rounded up to the nanosecond, so a completed flow has
+    // at most rounding errors left
+    for (size_t i = 0; i < m_flows.size();)
+    {
+        if (m_flows[i].remaining < 1)
+        {
+            m_flows[i] = std::move(m_flows.back());
+            m_flows.pop_back();
+            m_completedFlows++;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    Allocate();
+    ScheduleCompletion();
+}
+
+void
+PaxosFluidBackground::Advance()
+{
+    double elapsed = (ns3::Simulator::Now() - m_lastUpdate).GetSeconds();
+    m_lastUpdate = ns3::Simulator::Now();
+    for (auto &flow : m_flows)
+    {
+        flow.remaining -= flow.rate * elapsed / 8;
+    }
+}
+
+void
+PaxosFluidBackground::Allocate()
+{
+    std::vector<double> residual(m_links.size());
+    std::vector<uint32_t> count(m_links.size(), 0);
+    for (uint32_t i = 0; i < m_links.size(); i++)
+    {
+        residual[i] = m_links[i].capacity;
+    }
+    for (const auto &flow : m_flows)
+    {
+        for (uint32_t link : flow.links)
+        {
+            count[link]++;
+        }
+    }
+
+    // Progressive filling: the link with the smallest fair share is the bottleneck
+    // of all its flows, which get that share and leave the other links
+    std::vector<bool> fixed(m_flows.size(), false);
+    size_t left = m_flows.size();
+    while (left > 0)
+    {
+        uint32_t bottleneck = 0;
+        double share = std::numeric_limits<double>::infinity();
+        for (uint32_t i = 0; i < m_links.size(); i++)
+        {
+            if (count[i] > 0 && residual[i] / count[i] < share)
+            {
+                bottleneck = i;
+                share = residual[i] / count[i];
+            }
+        }
+        share = std::max(share, 0.0);
+
+        for (size_t i = 0; i < m_flows.size(); i++)
+        {
+            Flow &flow = m_flows[i];
+            if (fixed[i] || std::find(flow.links.begin(), flow.links.end(), bottleneck) == flow.links.end())
+            {
+                continue;
+            }
+            flow.rate = share;
+            fixed[i] = true;
+            left--;
+            for (uint32_t link : flow.links)
+            {
+                residual[link] -= share;
+                count[link]--;
+            }
+        }
+    }
+
+    // Only the devices whose background changed are updated
+    std::vector<double> rate(m_links.size(), 0);
+    std::fill(count.begin(), count.end(), 0);
+    for (const auto &flow : m_flows)
+    {
+        for (uint32_t link : flow.links)
+        {
+            rate[link] += flow.rate;
+            count[link]++;
+        }
+    }
+    for (uint32_t i = 0; i < m_links.size(); i++)
+    {
+        Link &link = m_links[i];
+        if (link.rate != rate[i] || link.flows != count[i])
+        {
+            link.rate = rate[i];
+            link.flows = count[i];
+            link.device->SetBackgroundRate(ns3::DataRate(static_cast<uint64_t>(link.rate)), link.flows);
+        }
+    }
+}
+
+void
+PaxosFluidBackground::ScheduleCompletion()
+{
+    // A superseded completion is removed, a cancelled one would still keep the
+    // simulation running until its time
+    ns3::Simulator::Remove(m_completionEvent);
+
+    double next = std::numeric_limits<double>::infinity();
+    for (const auto &flow : m_flows)
+    {
+        if (flow.rate > 0)
+        {
+            next = std::min(next, std::max(flow.remaining, 0.0) * 8 / flow.rate);
+        }
+    }
+    if (std::isinf(next))
+    {
+        return;
+    }
+
+    ns3::Time delay = ns3::NanoSeconds(static_cast<int64_t>(std::ceil(next * 1e9)));
+    m_completionEvent = ns3::Simulator::Schedule(delay, &PaxosFluidBackground::CompleteFlows, this);
+}
+
+bool
+PaxosFluidBackground::GetPath(ns3::Ptr<ns3::Node> host, ns3::Ipv4Address destination, std::vector<uint32_t> &links)
+{
+    auto key = std::make_pair(host->GetId(), destination.Get());
+    auto it = m_paths.find(key);
+    if (it != m_paths.end())
+    {
+        links = it->second;
+        return true;
+    }
+
+    // A Clos path has four hops, more is a routing loop
+    const uint32_t maxHops = 16;
+    ns3::Ptr<ns3::Node> node = host;
+    links.clear();
+    for (uint32_t hop = 0; hop < maxHops; hop++)
+    {
+        ns3::Ptr<ns3::Ipv4> ipv4 = node->GetObject<ns3::Ipv4>();
+        if (ipv4->GetInterfaceForAddress(destination) >= 0)
+        {
+            m_paths[key] = links;
+            return !links.empty();
+        }
+
+        ns3::Ipv4Header header;
+        header.SetDestination(destination);
+        ns3::Socket::SocketErrno error;
+        ns3::Ptr<ns3::Ipv4Route> route = ipv4->GetRoutingProtocol()->RouteOutput(nullptr, header, nullptr, error);
+        ns3::Ptr<ns3::PointToPointNetDevice> device =
+            route ? ns3::DynamicCast<ns3::PointToPointNetDevice>(route->GetOutputDevice()) : nullptr;
+        if (!device)
+        {
+            return false;
+        }
+        links.push_back(GetLink(device));
+
+        ns3::Ptr<ns3::Channel> channel = device->GetChannel();
+        ns3::Ptr<ns3::NetDevice> peer = channel->GetDevice(0) == device ? channel->GetDevice(1) : channel->GetDevice(0);
+        node = peer->GetNode();
+    }
+    return false;
+}
+
+uint32_t
+PaxosFluidBackground::GetLink(ns3::Ptr<ns3::PointToPointNetDevice> device)
+{
+    auto it = m_linkIndex.find(device);
+    if (it != m_linkIndex.end())
+    {
+        return it->second;
+    }
+
+    ns3::DataRateValue rate;
+    device->GetAttribute("DataRate", rate);
+    Link link;
+    link.device = device;
+    link.capacity = rate.Get().GetBitRate();
+    m_links.push_back(link);
+    m_linkIndex[device] = m_links.size() - 1;
+    return m_links.size() - 1;
+}
@@ -0,0 +1,111 @@
+#ifndef PAXOS_FLUID_BACKGROUND_H
+#define PAXOS_FLUID_BACKGROUND_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "paxos-background-traffic.h"
+
+#include <map>
+#include <vector>
+
+// The PaxosFluidBackground class models the background flows as fluid rates
+// on the point-to-point links of the fabric, instead of TCP packets.
+//
+// Flows arrive and are sized as with PaxosBackgroundApp. A flow follows the
+// routes of the nodes from its host to its destination, and the flows share
+// the links max-min fairly: the rates are recomputed when a flow arrives or
+// completes, which are the only events of the model. Each device is told the
+// rate of the flows it carries (see PointToPointNetDevice::SetBackgroundRate),
+// so the packet-level traffic gets the bandwidth they leave and queues behind
+// its slower transmissions.
+//
+// The devices are updated from any node, so the model is for sequential
+// simulations only.
+
+class PaxosFluidBackground : public ns3::Object
+{
+public:
+    PaxosFluidBackground();
+    ~PaxosFluidBackground();
+
+    static ns3::TypeId GetTypeId(void);
+
+    void SetFlowSizeCdf(PaxosBackgroundApp::FlowSizeCdf flowSizeCdf);
+
+    // A host which starts flows to its peers, flowArrivalRate flows per second
+    void AddSource(ns3::Ptr<ns3::Node> host, std::vector<ns3::Ipv4Address> peers, double flowArrivalRate);
+
+    // Start the flow arrivals at start, drop the flows still running at stop
+    void SetStartStop(ns3::Time start, ns3::Time stop);
+
+    uint64_t GetNumFlows() const;
+    uint64_t GetCompletedFlows() const;
+
+protected:
+    void DoDispose() override;
+
+private:
+    // One direction of a link, the device which sends on it
+    struct Link {
+        ns3::Ptr<ns3::PointToPointNetDevice> device;
+        double capacity = 0;    // bit/s
+        double rate = 0;        // sum of the rates of the flows, bit/s
+        uint32_t flows = 0;     // number of flows
+    };
+
+    struct Flow {
+        std::vector<uint32_t> links; // path, indexes in m_links
+        double remaining = 0;   // bytes left to send
+        double rate = 0;        // bit/s
+    };
+
+    struct Source {
+        ns3::Ptr<ns3::Node> host;
+        std::vector<ns3::Ipv4Address> peers;
+        double flowArrivalRate; // flows per second
+    };
+
+    void Start();
+    void Stop();
+
+    void ArriveFlow(uint32_t source);
+    void CompleteFlows();
+
+    // Subtract the bytes sent since the last update from the flows
+    void Advance();
+    // Max-min fair rates of the flows by progressive filling, given to the devices
+    void Allocate();
+    // Next flow completion, at the rates of the last allocation
+    void ScheduleCompletion();
+
+    // Links from a host to a destination, following the routes of the nodes.
+    // Returns false if a hop has no route or is not a point-to-point link.
+    bool GetPath(ns3::Ptr<ns3::Node> host, ns3::Ipv4Address destination, std::vector<uint32_t> &links);
+    uint32_t GetLink(ns3::Ptr<ns3::PointToPointNetDevice> device);
+
+    PaxosBackgroundApp::FlowSizeCdf m_flowSizeCdf; // Flow size distribution
+    std::vector<Source> m_sources;
+    std::vector<ns3::EventId> m_arrivalEvents;    // Next flow arrival, by source
+
+    std::vector<Link> m_links;
+    std::map<ns3::Ptr<ns3::NetDevice>, uint32_t> m_linkIndex;            // by device
+    std::map<std::pair<uint32_t, uint32_t>, std::vector<uint32_t>> m_paths; // by (node id, destination)
+    std::vector<Flow> m_flows;  // Active flows
+
+    ns3::Time m_lastUpdate;         // Time of the remaining bytes of the flows
+    ns3::Time m_stopTime;
+    ns3::EventId m_completionEvent; // Next flow completion
+
+    ns3::Ptr<ns3::ExponentialRandomVariable> m_arrivalRandom; // Flow inter-arrival time in seconds
+    ns3::Ptr<ns3::EmpiricalRandomVariable> m_sizeRandom;      // Flow size in bytes
+    ns3::Ptr<ns3::UniformRandomVariable> m_peerRandom;        // Destination index
+
+    uint64_t m_numFlows;        // Number of flows started
+    uint64_t m_totalBytes;      // Number of bytes of all flows started
+    uint64_t m_completedFlows;  // Number of flows completed before the stop
+};
+
+#endif // PAXOS_FLUID_BACKGROUND_H
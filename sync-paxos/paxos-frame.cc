@@ -19,25 +19,34 @@ ns3::TypeId RequestFrame::GetInstanceTypeId(void) const {
     return GetTypeId();
 }
 
-RequestFrame::RequestFrame() : m_timestamp(0), m_value(0) {}
+RequestFrame::RequestFrame() : m_timestamp(0), m_value(0), m_operation(WRITE) {}
 RequestFrame::RequestFrame(ns3::Time timestamp, uint32_t value)
-    : m_timestamp(timestamp), m_value(value) {}
+    : m_timestamp(timestamp), m_value(value), m_operation(WRITE) {}
 RequestFrame::~RequestFrame() {
     // Destructor logic if needed
 }
 
 void RequestFrame::Print(std::ostream &os) const {
     os << "RequestFrame: Timestamp=" << m_timestamp
-       << ", Value=" << m_value;
+       << ", Value=" << m_value
+       << ", Operation=" << m_operation;
 }
 
+// The operation is the top bit of the timestamp, which a simulation time never
+// sets, so that a request keeps its size of before the reads
+static const uint64_t REQUEST_READ_BIT = 1ULL << 63;
+
 uint32_t RequestFrame::GetSerializedSize(void) const {
-    return 8 + 4; // Timestamp (8 bytes) + Value (4 bytes)
+    return 8 + 4; // Timestamp and operation (8 bytes) + Value (4 bytes)
 }
 
 void RequestFrame::Serialize(ns3::Buffer::Iterator start) const {
     // Convert ns3::Time to uint64_t for serialization
     uint64_t timestamp = m_timestamp.GetNanoSeconds();
+    if (m_operation == READ)
+    {
+        timestamp |= REQUEST_READ_BIT;
+    }
     start.WriteU64(timestamp);
     start.WriteU32(m_value);
 }
@@ -45,6 +54,8 @@ void RequestFrame::Serialize(ns3::Buffer::Iterator start) const {
 uint32_t RequestFrame::Deserialize(ns3::Buffer::Iterator start) {
     // Convert uint64_t back to ns3::Time
     uint64_t timestamp = start.ReadU64();
+    m_operation = (timestamp & REQUEST_READ_BIT) ? READ : WRITE;
+    timestamp &= ~REQUEST_READ_BIT;
     // Convert to 1233ns format
     m_timestamp = ns3::Time(std::to_string(timestamp) + "ns");
     m_value = start.ReadU32();
@@ -53,9 +64,12 @@ uint32_t RequestFrame::Deserialize(ns3::Buffer::Iterator start) {
 
 ns3::Time RequestFrame::GetTimestamp() const { return m_timestamp; }
 uint32_t RequestFrame::GetValue() const { return m_value; }
+uint32_t RequestFrame::GetOperation() const { return m_operation; }
+bool RequestFrame::IsRead() const { return m_operation == READ; }
 
 void RequestFrame::SetTimestamp(ns3::Time timestamp) { m_timestamp = timestamp; }
 void RequestFrame::SetValue(uint32_t value) { m_value = value; }
+void RequestFrame::SetOperation(uint32_t operation) { m_operation = operation; }
 
 //********************************************************
 //              PaxosFrame
@@ -163,3 +177,108 @@ bool PaxosFrame::IsProposal() const { return m_messageType == PROPOSAL; }
 bool PaxosFrame::IsAccept() const { return m_messageType == ACCEPT; }
 bool PaxosFrame::IsDecision() const { return m_messageType == DECISION; }
 bool PaxosFrame::IsDecisionAck() const { return m_messageType == DECISION_ACK; }
+bool PaxosFrame::IsSequencedRequest() const { return m_messageType == SEQUENCED_REQUEST; }
+bool PaxosFrame::IsGapRequest() const { return m_messageType == GAP_REQUEST; }
+bool PaxosFrame::IsGapFill() const { return m_messageType == GAP_FILL; }
+bool PaxosFrame::IsLeaseRequest() const { return m_messageType == LEASE_REQUEST; }
+bool PaxosFrame::IsLeaseAck() const { return m_messageType == LEASE_ACK; }
+bool PaxosFrame::IsSequencedAck() const { return m_messageType == SEQUENCED_ACK; }
+bool PaxosFrame::IsSequencedCommit() const { return m_messageType == SEQUENCED_COMMIT; }
+
+
+//********************************************************
+//              LeaderlessFrame
+//********************************************************
+
+ns3::TypeId LeaderlessFrame::GetTypeId(void) {
+    static ns3::TypeId tid = ns3::TypeId("LeaderlessFrame")
+        .SetParent<ns3::Header>()
+        .SetGroupName("Paxos")
+        .AddConstructor<LeaderlessFrame>();
+        return tid;
+}
+
+ns3::TypeId LeaderlessFrame::GetInstanceTypeId(void) const {
+    return GetTypeId();
+}
+
+LeaderlessFrame::LeaderlessFrame() : m_messageType(0), m_replicaId(0), m_instance(0), m_senderId(0), m_value(0), m_seq(0), m_proposeTime(0) {}
+LeaderlessFrame::~LeaderlessFrame() {
+    // Destructor logic if needed
+}
+
+void LeaderlessFrame::Print(std::ostream &os) const {
+    os << "LeaderlessFrame: MessageType=" << m_messageType
+       << ", ReplicaId=" << m_replicaId
+       << ", Instance=" << m_instance
+       << ", SenderId=" << m_senderId
+       << ", Value=" << m_value
+       << ", Seq=" << m_seq
+       << ", ProposeTime=" << m_proposeTime
+       << ", Deps=";
+    for (auto dep : m_deps)
+    {
+        os << dep << " ";
+    }
+}
+
+uint32_t LeaderlessFrame::GetSerializedSize(void) const {
+    return sizeof(m_messageType)
+       + sizeof(m_replicaId)
+       + sizeof(m_instance)
+       + sizeof(m_senderId)
+       + sizeof(m_value)
+       + sizeof(m_seq)
+       + sizeof(uint64_t) // ns3::Time m_proposeTime
+       + sizeof(uint32_t) // number of deps
+       + sizeof(uint64_t) * m_deps.size();
+}
+
+void LeaderlessFrame::Serialize(ns3::Buffer::Iterator start) const {
+    start.WriteU32(m_messageType);
+    start.WriteU32(m_replicaId);
+    start.WriteU64(m_instance);
+    start.WriteU32(m_senderId);
+    start.WriteU32(m_value);
+    start.WriteU64(m_seq);
+    start.WriteU64(m_proposeTime.GetNanoSeconds());
+    start.WriteU32(m_deps.size());
+    for (auto dep : m_deps)
+    {
+        start.WriteU64(dep);
+    }
+}
+
+uint32_t LeaderlessFrame::Deserialize(ns3::Buffer::Iterator start) {
+    m_messageType = start.ReadU32();
+    m_replicaId = start.ReadU32();
+    m_instance = start.ReadU64();
+    m_senderId = start.ReadU32();
+    m_value = start.ReadU32();
+    m_seq = start.ReadU64();
+    m_proposeTime = ns3::NanoSeconds(start.ReadU64());
+    uint32_t numDeps = start.ReadU32();
+    m_deps.resize(numDeps);
+    for (uint32_t i = 0; i < numDeps; i++)
+    {
+        m_deps[i] = start.ReadU64();
+    }
+    return GetSerializedSize();
+}
+
+uint32_t LeaderlessFrame::GetMessageType() const { return m_messageType; }
+void LeaderlessFrame::SetMessageType(uint32_t messageType) { m_messageType = messageType; }
+uint32_t LeaderlessFrame::GetReplicaId() const { return m_replicaId; }
+void LeaderlessFrame::SetReplicaId(uint32_t replicaId) { m_replicaId = replicaId; }
+uint64_t LeaderlessFrame::GetInstance() const { return m_instance; }
+void LeaderlessFrame::SetInstance(uint64_t instance) { m_instance = instance; }
+uint32_t LeaderlessFrame::GetSenderId() const { return m_senderId; }
+void LeaderlessFrame::SetSenderId(uint32_t senderId) { m_senderId = senderId; }
+uint32_t LeaderlessFrame::GetValue() const { return m_value; }
+void LeaderlessFrame::SetValue(uint32_t value) { m_value = value; }
+uint64_t LeaderlessFrame::GetSeq() const { return m_seq; }
+void LeaderlessFrame::SetSeq(uint64_t seq) { m_seq = seq; }
+ns3::Time LeaderlessFrame::GetProposeTime() const { return m_proposeTime; }
+void LeaderlessFrame::SetProposeTime(ns3::Time proposeTime) { m_proposeTime = proposeTime; }
+const std::vector<uint64_t> &LeaderlessFrame::GetDeps() const { return m_deps; }
+void LeaderlessFrame::SetDeps(std::vector<uint64_t> deps) { m_deps = deps; }
@@ -9,6 +9,12 @@
 class RequestFrame : public ns3::Header
 {
 public:
+    enum Operation
+    {
+        WRITE = 0,  // Goes through consensus
+        READ        // Served locally by a replica
+    };
+
     RequestFrame();
     RequestFrame(ns3::Time timestamp, uint32_t value);
     ~RequestFrame();
@@ -23,15 +29,19 @@ public:
     // Getters for the request frame fields
     ns3::Time GetTimestamp() const;
     uint32_t GetValue() const;
+    uint32_t GetOperation() const;
+    bool IsRead() const;
 
     // Setters for the request frame fields
     void SetTimestamp(ns3::Time timestamp);
     void SetValue(uint32_t value);
+    void SetOperation(uint32_t operation);
 
 private:
     // Payload fields
     ns3::Time m_timestamp; // Timestamp of the request
     uint32_t  m_value; // Value of the request
+    uint32_t  m_operation; // Operation of the request, see Operation
 };
 
 // Paxos Frame
@@ -43,7 +53,14 @@ public:
         PROPOSAL = 100,
         ACCEPT,
         DECISION,
-        DECISION_ACK
+        DECISION_ACK,
+        SEQUENCED_REQUEST,  // Client request stamped by the sequencer, ProposalId is the sequence number
+        GAP_REQUEST,        // Replica asks the leader for a missing sequence number
+        GAP_FILL,           // Leader sends its entry of a sequence number, the request or a NO-OP
+        LEASE_REQUEST,      // Leader asks for a read lease starting at ProposeTime
+        LEASE_ACK,          // Replica grants the read lease starting at ProposeTime
+        SEQUENCED_ACK,      // Replica tells the leader the Value it has at a sequence number
+        SEQUENCED_COMMIT    // Leader tells the replicas a sequence number is decided, with its Value
     };
 
     PaxosFrame();
@@ -82,6 +99,13 @@ public:
     bool IsAccept() const;
     bool IsDecision() const;
     bool IsDecisionAck() const;
+    bool IsSequencedRequest() const;
+    bool IsGapRequest() const;
+    bool IsGapFill() const;
+    bool IsLeaseRequest() const;
+    bool IsLeaseAck() const;
+    bool IsSequencedAck() const;
+    bool IsSequencedCommit() const;
 
 private:
     // Message type (4 bytes) - A unique identifier for the message type.
@@ -101,4 +125,58 @@ private:
     ns3::Time m_decisionTime; // Timestamp of the decision
 };
 
+// Leaderless Frame
+// Messages of the leaderless mode (EPaxos style). An instance is identified
+// by the command leader (ReplicaId) and its instance number.
+class LeaderlessFrame : public ns3::Header
+{
+public:
+    enum MessageType
+    {
+        PRE_ACCEPT = 200,
+        PRE_ACCEPT_OK,
+        ACCEPT,
+        ACCEPT_OK,
+        COMMIT
+    };
+
+    LeaderlessFrame();
+    ~LeaderlessFrame();
+    static ns3::TypeId GetTypeId();
+    ns3::TypeId GetInstanceTypeId() const override;
+
+    void Print(std::ostream &os) const override;
+    uint32_t GetSerializedSize() const override;
+    void Serialize(ns3::Buffer::Iterator start) const override;
+    uint32_t Deserialize(ns3::Buffer::Iterator start) override;
+
+    // Getters and Setters for the leaderless frame fields
+    uint32_t GetMessageType() const;
+    void SetMessageType(uint32_t messageType);
+    uint32_t GetReplicaId() const;
+    void SetReplicaId(uint32_t replicaId);
+    uint64_t GetInstance() const;
+    void SetInstance(uint64_t instance);
+    uint32_t GetSenderId() const;
+    void SetSenderId(uint32_t senderId);
+    uint32_t GetValue() const;
+    void SetValue(uint32_t value);
+    uint64_t GetSeq() const;
+    void SetSeq(uint64_t seq);
+    ns3::Time GetProposeTime() const;
+    void SetProposeTime(ns3::Time proposeTime);
+    const std::vector<uint64_t> &GetDeps() const;
+    void SetDeps(std::vector<uint64_t> deps);
+
+private:
+    uint32_t m_messageType;     // Type of the message
+    uint32_t m_replicaId;       // Command leader of the instance
+    uint64_t m_instance;        // Instance number at the command leader
+    uint32_t m_senderId;        // ID of the sender
+    uint32_t m_value;           // Value of the command
+    uint64_t m_seq;             // Sequence number attribute, used to break dependency cycles
+    ns3::Time m_proposeTime;    // Timestamp of the client request
+    std::vector<uint64_t> m_deps; // Highest conflicting instance of each replica, 0 for none
+};
+
 #endif
@@ -4,12 +4,20 @@
 #include "ns3/point-to-point-module.h"
 #include "ns3/csma-module.h"
 #include "ns3/applications-module.h"
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#endif
 
 #include "paxos-app-server.h"
 #include "paxos-frame.h"
 #include "paxos-common.h"
 #include "paxos-app-client.h"
 #include "paxos-topology-clos.h"
+#include "paxos-trace.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
 
 // Define Log Component
 
@@ -20,6 +28,7 @@ NS_LOG_COMPONENT_DEFINE("SyncPaxos");
 // The client sends a single packet to the server, which echoes it back.
 
 PaxosConfig g_paxosConfig;
+std::string g_paxosMode = "";
 
 int main(int argc, char *argv[])
 {
@@ -39,8 +48,13 @@ int main(int argc, char *argv[])
     // The configuration file has the lower priority than the command line arguments.
     cmd.AddValue("config", "Path to the configuration file.", g_paxosConfig.configFilePath);
     cmd.AddValue("sync", "Set Paxos execution to synchronous (true) or asynchronous (false). Default is true (synchronous).", g_paxosConfig.isSynchronous);
+    cmd.AddValue("mode", "Consensus mode: sync, async, sequencer or leaderless. Overrides --sync if set.", g_paxosMode);
 
     // 2. Network parameters
+    cmd.AddValue("numSpines", "Number of spine switches of the Clos fabric.", g_paxosConfig.numSpines);
+    cmd.AddValue("numLeaves", "Number of leaf switches of the Clos fabric, one server per leaf.", g_paxosConfig.numLeaves);
+    cmd.AddValue("hostsPerLeaf", "Number of hosts per leaf switch.", g_paxosConfig.numHostsPerLeaf);
+
     //    for synchronous mode
     cmd.AddValue("clockSyncError", "Clock synchronization error for synchronous mode (e.g., '10ns', '1us').", g_paxosConfig.clockSyncError);
     cmd.AddValue("boundedMessageDelay", "Bounded message delay for synchronous mode (e.g., '5ms', '10ms').", g_paxosConfig.boundedMessageDelay);
@@ -49,22 +63,197 @@ int main(int argc, char *argv[])
     cmd.AddValue("linkDelay", "Link delay for asynchronous mode (e.g., '10ms', '50ms').", g_paxosConfig.linkDelay);
     cmd.AddValue("lossRate", "Packet loss rate for asynchronous mode (e.g., 0.01 for 1%).", g_paxosConfig.packetLossRate);
 
+    //    for both modes
+    cmd.AddValue("prioritizeConsensus", "Install strict priority queue discs on fabric links and mark Paxos messages as high priority.", g_paxosConfig.prioritizeConsensus);
+    cmd.AddValue("linkType", "Fabric links: p2p (point-to-point) or csma (a two node CSMA segment per link).", g_paxosConfig.linkType);
+    cmd.AddValue("switches", "Forward on the leaf and spine nodes with a lightweight switch rather than the IPv4 stack.", g_paxosConfig.switches);
+    cmd.AddValue("cutThrough", "With --switches, the switches start forwarding a packet once its headers have arrived.", g_paxosConfig.cutThrough);
+    cmd.AddValue("switchTableSize", "Number of destinations of the lookup table of the switches.", g_paxosConfig.switchTableSize);
+    cmd.AddValue("analyticalLinks", "Schedule only the reception of the packets sent on idle point-to-point links, not the end of their transmission.", g_paxosConfig.analyticalLinks);
+    cmd.AddValue("staticNeighbors", "Fill the ARP caches of the fabric at build time, so that the first packets on the csma links do not wait for address resolution.", g_paxosConfig.staticNeighbors);
+
+    //    workload
+    cmd.AddValue("requestInterval", "Time between two client requests (e.g., '10us'). Default is derived from the message delay.", g_paxosConfig.requestInterval);
+    cmd.AddValue("duration", "Run time of the Paxos applications, which start at 1s (e.g., '100ms').", g_paxosConfig.duration);
+    cmd.AddValue("readRatio", "Fraction of client requests that are reads (e.g., 0.9 for 90%).", g_paxosConfig.readRatio);
+    cmd.AddValue("leaseDuration", "Read lease duration of the leader for asynchronous mode (e.g., '10ms').", g_paxosConfig.leaseDuration);
+    cmd.AddValue("conflictRate", "Fraction of client requests on the same key (e.g., 0.02 for 2%), used by leaderless mode.", g_paxosConfig.conflictRate);
+
+    //    background cross traffic
+    cmd.AddValue("backgroundPattern", "Background traffic pattern: none, all-to-all or incast.", g_paxosConfig.backgroundPattern);
+    cmd.AddValue("backgroundFlowCdf", "Background flow size distribution: web-search or data-mining.", g_paxosConfig.backgroundFlowCdf);
+    cmd.AddValue("backgroundLoad", "Background traffic target utilization of the host links (e.g., 0.3 for 30%).", g_paxosConfig.backgroundLoad);
+    cmd.AddValue("backgroundModel", "Background flows as TCP packets (packet) or as max-min fair rates on the point-to-point links (fluid).", g_paxosConfig.backgroundModel);
+
     // 3. Node failure rate
     cmd.AddValue("failureRate", "Node failure rate (e.g., 0.05 for 5%).", g_paxosConfig.nodeFailureRate);
 
+    // 4. Event queue trace, replayed by bench-scheduler --replay
+    cmd.AddValue("eventTrace", "Record the event queue operations to this file.", g_paxosConfig.eventTraceFile);
+    cmd.AddValue("trace", "Write a binary trace of the Paxos events to this file, decoded by sync-paxos-trace.", g_paxosConfig.traceFile);
+    cmd.AddValue("traceRecords", "Number of Paxos trace records kept, the last ones.", g_paxosConfig.traceRecords);
+    cmd.AddValue("profile", "Write the wall clock time spent per event callback to this file ('-' for stdout).", g_paxosConfig.profileFile);
+    cmd.AddValue("stats", "Write the number of events and the wall clock time of the run to this file, read by sync-paxos-bench.", g_paxosConfig.statsFile);
+    cmd.AddValue("leanPackets", "Packets without metadata nor tags, faster but incompatible with --prioritizeConsensus and --distributed.", g_paxosConfig.leanPackets);
+
+    // 5. Result directory, so that several runs can share the working directory
+    cmd.AddValue("outputDir", "Directory of the result files, created if needed. Default is the current directory.", g_paxosConfig.outputDir);
+
+    // 6. Distributed simulation, needs ns-3 built with MPI and mpirun
+    cmd.AddValue("distributed", "Partition the fabric by leaf over the MPI ranks (run under mpirun), the --stats and --trace files get the rank as suffix.", g_paxosConfig.distributed);
+    cmd.AddValue("nullMessage", "Use the null message engine for the distributed simulation, otherwise the granted time window one.", g_paxosConfig.nullMessage);
+
+    // 7. Multithreaded simulation, more than one thread needs ns-3 built with NS3_MTP
+    cmd.AddValue("threads", "Run the simulation on this many threads, partitioned by leaf. Default is 1 (sequential).", g_paxosConfig.threads);
+
     cmd.Parse(argc, argv);
 
+    // Must be set before the simulator is created, i.e. before the first log with time prefix
+    if (!g_paxosConfig.eventTraceFile.empty())
+    {
+        ns3::Config::SetDefault("ns3::DefaultSimulatorImpl::TraceFile", ns3::StringValue(g_paxosConfig.eventTraceFile));
+    }
+    if (!g_paxosConfig.profileFile.empty())
+    {
+        ns3::Config::SetDefault("ns3::DefaultSimulatorImpl::ProfileFile", ns3::StringValue(g_paxosConfig.profileFile));
+    }
+
+    if (g_paxosConfig.distributed)
+    {
+#ifdef NS3_MPI
+        // Also before the simulator is created. The lookahead is the delay of the leaf-spine links.
+        ns3::GlobalValue::Bind("SimulatorImplementationType",
+                               ns3::StringValue(g_paxosConfig.nullMessage ? "ns3::NullMessageSimulatorImpl"
+                                                                          : "ns3::DistributedSimulatorImpl"));
+        ns3::MpiInterface::Enable(&argc, &argv);
+        g_paxosConfig.systemId = ns3::MpiInterface::GetSystemId();
+        g_paxosConfig.systemCount = ns3::MpiInterface::GetSize();
+        // Each rank writes its own statistics and trace, suffixed by its rank
+        if (!g_paxosConfig.statsFile.empty())
+        {
+            g_paxosConfig.statsFile += "." + std::to_string(g_paxosConfig.systemId);
+        }
+        if (!g_paxosConfig.traceFile.empty())
+        {
+            g_paxosConfig.traceFile += "." + std::to_string(g_paxosConfig.systemId);
+        }
+#else
+        NS_LOG_ERROR("sync-paxos was built without MPI, configure ns-3 with NS3_MPI=ON");
+        return -1;
+#endif
+    }
+
+    if (g_paxosConfig.threads > 1)
+    {
+        if (g_paxosConfig.distributed)
+        {
+            NS_LOG_ERROR("--threads can not be combined with --distributed");
+            return -1;
+        }
+        // Also before the simulator is created. The topology sets the partitions and the lookahead.
+        ns3::GlobalValue::Bind("SimulatorImplementationType", ns3::StringValue("ns3::MultithreadedSimulatorImpl"));
+        ns3::Config::SetDefault("ns3::MultithreadedSimulatorImpl::MaxThreads", ns3::UintegerValue(g_paxosConfig.threads));
+    }
+
+    // A CSMA channel is shared state of its two nodes, it can not cross partitions nor ranks
+    if (g_paxosConfig.linkType != "p2p" && g_paxosConfig.linkType != "csma")
+    {
+        NS_LOG_ERROR("Unknown link type " << g_paxosConfig.linkType);
+        return -1;
+    }
+    if (g_paxosConfig.linkType == "csma" && (g_paxosConfig.distributed || g_paxosConfig.threads > 1))
+    {
+        NS_LOG_ERROR("--linkType=csma can not be combined with --distributed or --threads");
+        return -1;
+    }
+
+    if (g_paxosConfig.backgroundModel != "packet" && g_paxosConfig.backgroundModel != "fluid")
+    {
+        NS_LOG_ERROR("Unknown background model " << g_paxosConfig.backgroundModel);
+        return -1;
+    }
+    if (g_paxosConfig.backgroundModel == "fluid" &&
+        (g_paxosConfig.linkType != "p2p" || g_paxosConfig.distributed || g_paxosConfig.threads > 1))
+    {
+        NS_LOG_ERROR("--backgroundModel=fluid needs point-to-point links and can not be combined with --distributed or --threads");
+        return -1;
+    }
+    if (g_paxosConfig.cutThrough && (!g_paxosConfig.switches || g_paxosConfig.linkType != "p2p"))
+    {
+        NS_LOG_ERROR("--cutThrough needs --switches and point-to-point links");
+        return -1;
+    }
+
+    if (g_paxosConfig.analyticalLinks)
+    {
+        ns3::Config::SetDefault("ns3::PointToPointNetDevice::AnalyticalTx", ns3::BooleanValue(true));
+    }
+
+    // Before any packet is created. The IP TOS of the Paxos messages and the MPI
+    // transfers need packet tags and serialization, which lean packets have not.
+    if (g_paxosConfig.leanPackets)
+    {
+        if (g_paxosConfig.prioritizeConsensus || g_paxosConfig.distributed)
+        {
+            NS_LOG_ERROR("--leanPackets can not be combined with --prioritizeConsensus or --distributed");
+            return -1;
+        }
+        ns3::Packet::EnableLean();
+    }
+
+    if (!g_paxosConfig.traceFile.empty())
+    {
+        PaxosTracer::Enable(g_paxosConfig.traceRecords);
+    }
+
+    if (!g_paxosConfig.outputDir.empty())
+    {
+        std::error_code error;
+        std::filesystem::create_directories(g_paxosConfig.outputDir, error);
+        if (error)
+        {
+            NS_LOG_ERROR("Can not create output directory " << g_paxosConfig.outputDir << ": " << error.message());
+            return -1;
+        }
+    }
+
+    // Only sync mode runs on a synchronous network, the other modes use the link delay
+    if (g_paxosMode.empty())
+    {
+        g_paxosConfig.mode = g_paxosConfig.isSynchronous ? PAXOS_MODE_SYNC : PAXOS_MODE_ASYNC;
+    }
+    else if (ParsePaxosMode(g_paxosMode, g_paxosConfig.mode))
+    {
+        g_paxosConfig.isSynchronous = (g_paxosConfig.mode == PAXOS_MODE_SYNC);
+    }
+    else
+    {
+        NS_LOG_ERROR("Unknown consensus mode " << g_paxosMode);
+        return -1;
+    }
+
     // Output Configuration
     NS_LOG_INFO("-------- Configuration: --------");
     NS_LOG_INFO("Config File Path: " << g_paxosConfig.configFilePath);
     NS_LOG_INFO("Synchronous: " << g_paxosConfig.isSynchronous);
+    NS_LOG_INFO("Mode: " << g_paxosConfig.mode);
     NS_LOG_INFO("Clock Sync Error: " << g_paxosConfig.clockSyncError);
     NS_LOG_INFO("Bounded Message Delay: " << g_paxosConfig.boundedMessageDelay);
+    NS_LOG_INFO("Prioritize Consensus: " << g_paxosConfig.prioritizeConsensus);
+    NS_LOG_INFO("Links: " << g_paxosConfig.linkType << ", static neighbors " << g_paxosConfig.staticNeighbors
+                          << ", analytical " << g_paxosConfig.analyticalLinks);
+    NS_LOG_INFO("Switches: " << g_paxosConfig.switches << ", cut-through " << g_paxosConfig.cutThrough);
+    NS_LOG_INFO("Background Traffic: " << g_paxosConfig.backgroundPattern << ", " << g_paxosConfig.backgroundFlowCdf << ", load " << g_paxosConfig.backgroundLoad << ", " << g_paxosConfig.backgroundModel);
 
     NS_LOG_INFO("Starting SyncPaxos Simulation");
-    uint32_t numSpine = 3;
-    uint32_t numLeaf = 5;
-    uint32_t numHostsPerLeaf = 5;
+    uint32_t numSpine = g_paxosConfig.numSpines;
+    uint32_t numLeaf = g_paxosConfig.numLeaves;
+    uint32_t numHostsPerLeaf = g_paxosConfig.numHostsPerLeaf;
+    if (numSpine == 0 || numLeaf == 0 || numHostsPerLeaf == 0)
+    {
+        NS_LOG_ERROR("The Clos fabric needs at least one spine, one leaf and one host per leaf");
+        return -1;
+    }
 
     std::string bandwidthLeaf2Spine = "1Gbps";
     std::string delayLeaf2Spine = "5us";
@@ -114,10 +303,22 @@ int main(int argc, char *argv[])
         return -1;
     }
 
-    // Init Paxos Client Cluster
-    NS_LOG_INFO("Init Paxos Client Cluster");
+    // Init Paxos Sequencer, on the spine of the client so that stamping adds no hop
     std::vector<uint32_t> spineIdList;
     spineIdList.push_back(numSpine / 2);
+    if (g_paxosConfig.mode == PAXOS_MODE_SEQUENCER)
+    {
+        NS_LOG_INFO("Init Paxos Sequencer");
+        ret = topology.InitPaxosSequencer(spineIdList[0]);
+        if (ret != 0)
+        {
+            NS_LOG_ERROR("Init Paxos Sequencer failed");
+            return -1;
+        }
+    }
+
+    // Init Paxos Client Cluster
+    NS_LOG_INFO("Init Paxos Client Cluster");
     ret = topology.InitPaxosClientCluster(spineIdList);
     if (ret != 0)
     {
@@ -125,14 +326,54 @@ int main(int argc, char *argv[])
         return -1;
     }
 
+    // Init Background Traffic
+    NS_LOG_INFO("Init Background Traffic");
+    ret = topology.InitBackgroundTraffic();
+    if (ret != 0)
+    {
+        NS_LOG_ERROR("Init Background Traffic failed");
+        return -1;
+    }
+
     // Set Paxos Server App Start Stop
     ns3::Time start = ns3::Seconds(1.0);
-    ns3::Time end = ns3::Seconds(2.0);
+    ns3::Time end = start + ns3::Time(g_paxosConfig.duration);
     topology.SetPaxosServerAppStartStop(start, end);
     topology.SetPaxosClientAppStartStop(start, end);
+    topology.SetBackgroundAppStartStop(start, end);
+
+    // The null message engine always has null messages to send, so a distributed
+    // run never runs out of events and ends just after the applications stop,
+    // whose stop events are only scheduled when the nodes are initialized
+    if (g_paxosConfig.distributed)
+    {
+        ns3::Simulator::Stop(end + ns3::NanoSeconds(1));
+    }
 
     // Run the simulation
+    auto runStart = std::chrono::steady_clock::now();
     ns3::Simulator::Run();
+    double runSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+    if (!g_paxosConfig.statsFile.empty())
+    {
+        std::ofstream stats(g_paxosConfig.statsFile, std::ios::out | std::ios::trunc);
+        stats << "events,wallSeconds,simulatedSeconds\n";
+        stats << ns3::Simulator::GetEventCount() << "," << runSeconds << "," << ns3::Simulator::Now().GetSeconds() << "\n";
+        if (!stats.good())
+        {
+            NS_LOG_ERROR("Can not write the run statistics to " << g_paxosConfig.statsFile);
+        }
+    }
+    if (PaxosTracer::IsEnabled() && !PaxosTracer::Write(g_paxosConfig.traceFile))
+    {
+        NS_LOG_ERROR("Can not write the Paxos trace to " << g_paxosConfig.traceFile);
+    }
     ns3::Simulator::Destroy();
+#ifdef NS3_MPI
+    if (g_paxosConfig.distributed)
+    {
+        ns3::MpiInterface::Disable();
+    }
+#endif
     return 0;
 }
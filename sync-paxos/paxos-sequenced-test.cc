@@ -0,0 +1,180 @@
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "paxos-app-client.h"
+#include "paxos-app-server.h"
+#include "paxos-sequencer.h"
+
+#include <filesystem>
+#include <fstream>
+
+// Tests of the sequencer mode, run with ctest or by hand:
+//   sync-paxos-test --suite=paxos-sequenced --verbose
+
+// The replicas lose requests, acks, gap fills and commits for a while, then the
+// network heals. Every replica must end up with the same decided log, without
+// holes, and the leader must have filled some of the slots it missed with NO-OPs.
+class PaxosSequencedDropTest : public ns3::TestCase
+{
+public:
+    PaxosSequencedDropTest();
+
+private:
+    void DoRun() override;
+
+    // The decision log of a server without the decision times, which differ per server
+    std::vector<std::string> ReadDecisions(std::filesystem::path outputDir, uint32_t serverId);
+};
+
+PaxosSequencedDropTest::PaxosSequencedDropTest()
+    : ns3::TestCase("Sequencer mode replicas decide the same log despite drops")
+{
+}
+
+std::vector<std::string>
+PaxosSequencedDropTest::ReadDecisions(std::filesystem::path outputDir, uint32_t serverId)
+{
+    std::ifstream log(outputDir / ("server-" + std::to_string(serverId) + "-decision-log.dat"));
+    std::vector<std::string> decisions;
+    std::string line;
+    std::getline(log, line); // header
+    while (std::getline(log, line))
+    {
+        decisions.push_back(line.substr(0, line.rfind(',')));
+    }
+    return decisions;
+}
+
+void
+PaxosSequencedDropTest::DoRun()
+{
+    const uint32_t numServers = 5;
+    const ns3::Time start = ns3::Seconds(1);
+    const ns3::Time healTime = start + ns3::MilliSeconds(20);   // the client stops and the drops end
+    const ns3::Time stop = start + ns3::MilliSeconds(40);
+
+    // A star: the sequencer on the hub, the client and the servers on the spokes
+    ns3::Ptr<ns3::Node> hub = ns3::CreateObject<ns3::Node>();
+    ns3::Ptr<ns3::Node> clientNode = ns3::CreateObject<ns3::Node>();
+    ns3::NodeContainer serverNodes(numServers);
+    ns3::NodeContainer nodes(hub, clientNode);
+    nodes.Add(serverNodes);
+
+    ns3::InternetStackHelper stack;
+    stack.Install(nodes);
+
+    ns3::PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", ns3::StringValue("10Gbps"));
+    p2p.SetChannelAttribute("Delay", ns3::StringValue("5us"));
+    ns3::Ipv4AddressHelper address("10.0.0.0", "255.255.255.0");
+
+    ns3::Ipv4InterfaceContainer clientInterfaces = address.Assign(p2p.Install(hub, clientNode));
+
+    NodeInfoList servers;
+    std::vector<ns3::Ptr<ns3::RateErrorModel>> errorModels;
+    for (uint32_t i = 0; i < numServers; i++)
+    {
+        address.NewNetwork();
+        ns3::NetDeviceContainer devices = p2p.Install(hub, serverNodes.Get(i));
+        ns3::Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+        // Drop 5% of the packets the server receives
+        ns3::Ptr<ns3::RateErrorModel> errorModel = ns3::CreateObject<ns3::RateErrorModel>();
+        errorModel->SetRate(0.05);
+        errorModel->SetUnit(ns3::RateErrorModel::ERROR_UNIT_PACKET);
+        devices.Get(1)->SetAttribute("ReceiveErrorModel", ns3::PointerValue(errorModel));
+        errorModels.push_back(errorModel);
+
+        NodeInfo server;
+        server.serverId = i;
+        server.address = interfaces.GetAddress(1);
+        server.paxosPort = PAXOS_PORT;
+        server.serverPort = SERVER_PORT;
+        servers.push_back(server);
+    }
+    ns3::Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    PaxosMode mode = PaxosAppServer::s_mode;
+    ns3::Time proposeTimeout = PaxosAppServer::s_proposeTimeout;
+    PaxosAppServer::s_mode = PAXOS_MODE_SEQUENCER;
+    PaxosAppServer::s_leader = 0;
+    PaxosAppServer::s_proposeTimeout = ns3::MicroSeconds(500);
+
+    std::filesystem::path outputDir = CreateTempDirFilename("");
+    for (uint32_t i = 0; i < numServers; i++)
+    {
+        ns3::Ptr<PaxosAppServer> server = ns3::CreateObject<PaxosAppServer>(i, servers);
+        server->SetOutputDir(outputDir);
+        serverNodes.Get(i)->AddApplication(server);
+        server->SetStartTime(start);
+        server->SetStopTime(stop);
+    }
+
+    ns3::Ptr<PaxosSequencerApp> sequencer = ns3::CreateObject<PaxosSequencerApp>(0, servers);
+    hub->AddApplication(sequencer);
+    sequencer->SetStartTime(start);
+    sequencer->SetStopTime(stop);
+
+    ns3::Ptr<PaxosAppClient> client = ns3::CreateObject<PaxosAppClient>(servers);
+    client->SetSendInterval(ns3::MicroSeconds(10));
+    client->SetSequencer(clientInterfaces.GetAddress(0), SEQUENCER_PORT);
+    clientNode->AddApplication(client);
+    client->SetStartTime(start);
+    client->SetStopTime(healTime);
+
+    ns3::Simulator::Schedule(healTime, [errorModels]() {
+        for (auto errorModel : errorModels)
+        {
+            errorModel->Disable();
+        }
+    });
+
+    ns3::Simulator::Run();
+    ns3::Simulator::Destroy();
+
+    PaxosAppServer::s_mode = mode;
+    PaxosAppServer::s_proposeTimeout = proposeTimeout;
+
+    // index,proposalId,proposerId,value: the sequence number is the position in the log
+    std::vector<std::string> leaderLog = ReadDecisions(outputDir, 0);
+    NS_TEST_ASSERT_MSG_GT(leaderLog.size(), 1000, "The leader decided too few entries");
+    uint32_t numNoops = 0;
+    for (uint64_t i = 0; i < leaderLog.size(); i++)
+    {
+        std::stringstream line(leaderLog[i]);
+        std::string field;
+        std::getline(line, field, ',');
+        std::getline(line, field, ',');
+        NS_TEST_ASSERT_MSG_EQ(std::stoull(field), i + 1, "The leader log has a hole at index " << i);
+        std::getline(line, field, ',');
+        std::getline(line, field, ',');
+        numNoops += std::stoul(field) == PAXOS_NOOP_VALUE;
+    }
+    NS_TEST_EXPECT_MSG_GT(numNoops, 0, "The leader took no NO-OP, the drops missed the gap agreement");
+
+    for (uint32_t i = 1; i < numServers; i++)
+    {
+        std::vector<std::string> log = ReadDecisions(outputDir, i);
+        NS_TEST_ASSERT_MSG_EQ(log.size(), leaderLog.size(), "Server " << i << " decided another number of entries");
+        for (uint64_t j = 0; j < log.size(); j++)
+        {
+            NS_TEST_ASSERT_MSG_EQ(log[j], leaderLog[j], "Server " << i << " decided another entry at index " << j);
+        }
+    }
+}
+
+class PaxosSequencedTestSuite : public ns3::TestSuite
+{
+public:
+    PaxosSequencedTestSuite();
+};
+
+PaxosSequencedTestSuite::PaxosSequencedTestSuite()
+    : ns3::TestSuite("paxos-sequenced", Type::SYSTEM)
+{
+    AddTestCase(new PaxosSequencedDropTest, ns3::TestCase::Duration::QUICK);
+}
+
+static PaxosSequencedTestSuite g_paxosSequencedTestSuite;
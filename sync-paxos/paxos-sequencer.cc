@@ -0,0 +1,112 @@
+#include "paxos-sequencer.h"
+
+NS_LOG_COMPONENT_DEFINE("PaxosSequencerApp");
+
+PaxosSequencerApp::PaxosSequencerApp()
+    : m_sessionId(0), m_nextSequenceNumber(1), m_ipTos(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PaxosSequencerApp::PaxosSequencerApp(uint32_t sessionId, NodeInfoList nodes)
+    : m_sessionId(sessionId), m_nextSequenceNumber(1), m_nodes(nodes), m_ipTos(0)
+{
+    NS_LOG_FUNCTION(this);
+    for (auto node : m_nodes)
+    {
+        m_replicaAddresses.push_back(ns3::InetSocketAddress(node.address, node.paxosPort));
+    }
+}
+
+PaxosSequencerApp::~PaxosSequencerApp()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ns3::TypeId
+PaxosSequencerApp::GetTypeId(void)
+{
+    static ns3::TypeId tid = ns3::TypeId("PaxosSequencerApp")
+        .SetParent<ns3::Application>()
+        .AddConstructor<PaxosSequencerApp>();
+    return tid;
+}
+
+void
+PaxosSequencerApp::StartApplication(void)
+{
+    NS_LOG_FUNCTION(this);
+    NS_LOG_INFO("Starting PaxosSequencerApp session " << m_sessionId);
+
+    auto tid = ns3::TypeId::LookupByName("ns3::UdpSocketFactory");
+    m_recvSocket = ns3::Socket::CreateSocket(GetNode(), tid);
+    m_sendSocket = ns3::Socket::CreateSocket(GetNode(), tid);
+    if (!m_recvSocket || !m_sendSocket)
+    {
+        NS_FATAL_ERROR("Failed to create UDP socket");
+    }
+
+    ns3::Address local = ns3::InetSocketAddress(ns3::Ipv4Address::GetAny(), SEQUENCER_PORT);
+    if (m_recvSocket->Bind(local) == -1)
+    {
+        NS_FATAL_ERROR("Failed to bind socket");
+    }
+    if (m_ipTos != 0)
+    {
+        m_sendSocket->SetIpTos(m_ipTos);
+    }
+
+    m_recvSocket->SetRecvCallback(MakeCallback(&PaxosSequencerApp::ReceiveRequest, this));
+}
+
+void
+PaxosSequencerApp::SetIpTos(uint8_t ipTos)
+{
+    NS_LOG_FUNCTION(this << static_cast<uint32_t>(ipTos));
+    m_ipTos = ipTos;
+}
+
+void
+PaxosSequencerApp::StopApplication(void)
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_recvSocket != nullptr)
+    {
+        m_recvSocket->Close();
+        m_recvSocket = nullptr;
+    }
+
+    NS_LOG_INFO("Stopping PaxosSequencerApp, stamped " << m_nextSequenceNumber - 1 << " requests");
+}
+
+void
+PaxosSequencerApp::ReceiveRequest(ns3::Ptr<ns3::Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+    ns3::Ptr<ns3::Packet> packet;
+    ns3::Address from;
+
+    while ((packet = socket->RecvFrom(from)))
+    {
+        RequestFrame requestFrame;
+        packet->RemoveHeader(requestFrame);
+
+        // Stamp the request, keep the client timestamp as the propose time
+        PaxosFrame frame;
+        frame.SetMessageType(PaxosFrame::SEQUENCED_REQUEST);
+        frame.SetProposerId(m_sessionId);
+        frame.SetProposalId(m_nextSequenceNumber++);
+        frame.SetValue(requestFrame.GetValue());
+        frame.SetProposeTime(requestFrame.GetTimestamp());
+        frame.SetAcceptTime(ns3::Simulator::Now());
+
+        NS_LOG_INFO("PaxosSequencerApp stamped request with sequence number " << frame.GetProposalId());
+
+        ns3::Ptr<ns3::Packet> sequenced = ns3::Create<ns3::Packet>();
+        sequenced->AddHeader(frame);
+
+        // Multicast to all replicas
+        m_sendSocket->SendToMany(sequenced, 0, m_replicaAddresses);
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef PAXOS_SEQUENCER_H
+#define PAXOS_SEQUENCER_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/application.h"
+
+#include "paxos-common.h"
+#include "paxos-frame.h"
+
+// The PaxosSequencerApp class implements the in-network sequencer of the
+// sequencer mode. It runs on a spine switch, stamps every client request
+// with the next global sequence number and multicasts it to all replicas.
+// Replicas detect dropped requests by gaps in the sequence numbers.
+
+class PaxosSequencerApp : public ns3::Application
+{
+public:
+    PaxosSequencerApp();
+    PaxosSequencerApp(uint32_t sessionId, NodeInfoList nodes);
+    ~PaxosSequencerApp();
+
+    static ns3::TypeId GetTypeId(void);
+
+    void StartApplication(void) override;
+    void StopApplication(void) override;
+
+    // IP TOS of the sequenced requests, 0 leaves them unmarked
+    void SetIpTos(uint8_t ipTos);
+
+private:
+    void ReceiveRequest(ns3::Ptr<ns3::Socket> socket);
+
+    uint32_t m_sessionId;       // Sequencer session, carried in the ProposerId field
+    uint64_t m_nextSequenceNumber; // Next sequence number to stamp, starts at 1
+    NodeInfoList m_nodes;       // Replicas to multicast to
+    std::vector<ns3::Address> m_replicaAddresses; // Paxos ports of the replicas, for SendToMany
+    uint8_t m_ipTos;            // IP TOS of the sequenced requests, 0 means unmarked
+
+    ns3::Ptr<ns3::Socket> m_recvSocket; // UDP socket for client requests
+    ns3::Ptr<ns3::Socket> m_sendSocket; // UDP socket for multicasting to replicas
+};
+
+#endif // PAXOS_SEQUENCER_H
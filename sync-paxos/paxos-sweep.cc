@@ -0,0 +1,271 @@
+#include "ns3/core-module.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Parameter sweep driver
+// Runs sync-paxos once per point of a parameter grid, each point in its own
+// process and its own output directory, with up to --jobs processes at once.
+// A grid is a list of dimensions separated by ';', each dimension is
+// [label:]option=value1,value2,... and the point directories are named
+// label_value, nested in the order of the dimensions, e.g.
+//   --grid="Delay:boundedMessageDelay=50us,5us;Sync:clockSyncError=50ns,5ns"
+// gives result/Delay_50us/Sync_50ns ... as batch-test.sh does.
+
+struct SweepDimension {
+    std::string label;  // Directory name prefix
+    std::string option; // sync-paxos option
+    std::vector<std::string> values;
+};
+
+struct SweepPoint {
+    std::filesystem::path outputDir;
+    std::vector<std::string> args;
+    pid_t pid = -1;
+    int status = -1;
+    double wallSeconds = 0;
+    std::chrono::steady_clock::time_point startTime;
+};
+
+static std::vector<std::string> Split(const std::string &text, char separator)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, separator))
+    {
+        if (!item.empty())
+        {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+static bool ParseGrid(const std::string &grid, std::vector<SweepDimension> &dimensions)
+{
+    for (auto &text : Split(grid, ';'))
+    {
+        SweepDimension dimension;
+        auto equal = text.find('=');
+        if (equal == std::string::npos)
+        {
+            std::cerr << "Grid dimension without values: " << text << std::endl;
+            return false;
+        }
+        std::string name = text.substr(0, equal);
+        auto colon = name.find(':');
+        dimension.option = (colon == std::string::npos) ? name : name.substr(colon + 1);
+        dimension.label = (colon == std::string::npos) ? name : name.substr(0, colon);
+        dimension.values = Split(text.substr(equal + 1), ',');
+        if (dimension.option.empty() || dimension.values.empty())
+        {
+            std::cerr << "Invalid grid dimension: " << text << std::endl;
+            return false;
+        }
+        dimensions.push_back(dimension);
+    }
+    return !dimensions.empty();
+}
+
+// Cartesian product of the dimensions, the last dimension varies fastest
+static std::vector<SweepPoint> ExpandGrid(const std::vector<SweepDimension> &dimensions,
+                                          const std::filesystem::path &outputDir,
+                                          const std::vector<std::string> &fixedArgs)
+{
+    std::vector<SweepPoint> points(1);
+    points[0].outputDir = outputDir;
+    points[0].args = fixedArgs;
+    for (auto &dimension : dimensions)
+    {
+        std::vector<SweepPoint> expanded;
+        for (auto &point : points)
+        {
+            for (auto &value : dimension.values)
+            {
+                SweepPoint next = point;
+                next.outputDir /= dimension.label + "_" + value;
+                next.args.push_back("--" + dimension.option + "=" + value);
+                expanded.push_back(next);
+            }
+        }
+        points = expanded;
+    }
+    for (auto &point : points)
+    {
+        point.args.push_back("--outputDir=" + point.outputDir.string());
+    }
+    return points;
+}
+
+static pid_t StartPoint(const std::string &binary, SweepPoint &point)
+{
+    std::filesystem::create_directories(point.outputDir);
+    std::string logPath = (point.outputDir / "sync-paxos.log").string();
+
+    pid_t pid = fork();
+    if (pid != 0)
+    {
+        return pid;
+    }
+
+    // Child: log output goes to the point directory
+    FILE *log = freopen(logPath.c_str(), "w", stdout);
+    if (log == nullptr || dup2(fileno(stdout), fileno(stderr)) < 0)
+    {
+        _exit(127);
+    }
+    std::vector<char *> argv;
+    argv.push_back(const_cast<char *>(binary.c_str()));
+    for (auto &arg : point.args)
+    {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+    execv(binary.c_str(), argv.data());
+    _exit(127);
+}
+
+// Number of decided operations, from the decision log of the first server
+static uint64_t CountDecided(const std::filesystem::path &outputDir)
+{
+    std::ifstream log(outputDir / "server-0-decision-log.dat");
+    if (!log.is_open())
+    {
+        return 0;
+    }
+    uint64_t lines = 0;
+    std::string line;
+    while (std::getline(log, line))
+    {
+        lines++;
+    }
+    // The first line is the header
+    return lines > 0 ? lines - 1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    std::string grid = "";
+    std::string fixed = "";
+    std::string outputDir = "result";
+    std::string binary = "";
+    uint32_t jobs = std::thread::hardware_concurrency();
+    double runtime = 1.0;
+
+    ns3::CommandLine cmd;
+    cmd.Usage("Run sync-paxos over a parameter grid, one process per point.\n"
+              "\n"
+              "A grid is a list of dimensions separated by ';', each dimension is\n"
+              "[label:]option=value1,value2,... Each point writes its results to\n"
+              "<outputDir>/<label>_<value>/..., and the sweep writes summary.csv.");
+    cmd.AddValue("grid", "Parameter grid, e.g. 'Delay:boundedMessageDelay=50us,5us;Sync:clockSyncError=50ns,5ns'.", grid);
+    cmd.AddValue("fixed", "sync-paxos options shared by all points, separated by spaces, e.g. '--mode=sync'.", fixed);
+    cmd.AddValue("outputDir", "Root directory of the results.", outputDir);
+    cmd.AddValue("binary", "Path of the sync-paxos executable. Default is next to this program.", binary);
+    cmd.AddValue("jobs", "Number of points run at the same time. Default is the number of cores.", jobs);
+    cmd.AddValue("runtime", "Duration of the Paxos applications in seconds, for the operations per second.", runtime);
+    cmd.Parse(argc, argv);
+
+    std::vector<SweepDimension> dimensions;
+    if (!ParseGrid(grid, dimensions))
+    {
+        std::cerr << "A parameter grid is required, see --help" << std::endl;
+        return -1;
+    }
+    if (binary.empty())
+    {
+        binary = (std::filesystem::absolute(argv[0]).parent_path() / "sync-paxos").string();
+    }
+    jobs = std::max<uint32_t>(jobs, 1);
+
+    std::vector<SweepPoint> points = ExpandGrid(dimensions, outputDir, Split(fixed, ' '));
+    std::cout << "Running " << points.size() << " points with " << jobs << " jobs" << std::endl;
+
+    // Keep up to jobs points running, start the next one whenever one exits
+    std::map<pid_t, size_t> running;
+    size_t next = 0;
+    size_t done = 0;
+    while (done < points.size())
+    {
+        while (next < points.size() && running.size() < jobs)
+        {
+            SweepPoint &point = points[next];
+            point.startTime = std::chrono::steady_clock::now();
+            point.pid = StartPoint(binary, point);
+            if (point.pid < 0)
+            {
+                std::cerr << "Can not start point " << point.outputDir << std::endl;
+                done++;
+            }
+            else
+            {
+                running[point.pid] = next;
+            }
+            next++;
+        }
+        if (running.empty())
+        {
+            continue;
+        }
+
+        int status;
+        pid_t pid = waitpid(-1, &status, 0);
+        auto it = running.find(pid);
+        if (pid < 0 || it == running.end())
+        {
+            continue;
+        }
+        SweepPoint &point = points[it->second];
+        point.status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+        point.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - point.startTime).count();
+        running.erase(it);
+        done++;
+        std::cout << "[" << done << "/" << points.size() << "] " << point.outputDir.string()
+                  << (point.status == 0 ? "" : " FAILED") << std::endl;
+    }
+
+    // Summary table, also written as CSV next to the point directories
+    std::filesystem::path summaryPath = std::filesystem::path(outputDir) / "summary.csv";
+    std::ofstream summary(summaryPath);
+    summary << "point";
+    std::cout << std::endl << std::left;
+    for (auto &dimension : dimensions)
+    {
+        summary << "," << dimension.option;
+        std::cout << std::setw(24) << dimension.option;
+    }
+    summary << ",status,wallSeconds,decided,opsPerSecond\n";
+    std::cout << std::setw(8) << "status" << std::setw(12) << "wall (s)" << std::setw(12) << "decided"
+              << "ops/s" << std::endl;
+
+    for (auto &point : points)
+    {
+        uint64_t decided = point.status == 0 ? CountDecided(point.outputDir) : 0;
+        summary << point.outputDir.string();
+        for (size_t i = 0; i < dimensions.size(); i++)
+        {
+            // The grid options come right before --outputDir, in order
+            std::string value = point.args[point.args.size() - 1 - dimensions.size() + i];
+            value = value.substr(value.find('=') + 1);
+            summary << "," << value;
+            std::cout << std::setw(24) << value;
+        }
+        summary << "," << point.status << "," << point.wallSeconds << "," << decided << "," << decided / runtime << "\n";
+        std::cout << std::setw(8) << point.status << std::setw(12) << point.wallSeconds << std::setw(12) << decided
+                  << decided / runtime << std::endl;
+    }
+    std::cout << std::endl << "Summary written to " << summaryPath.string() << std::endl;
+
+    return 0;
+}
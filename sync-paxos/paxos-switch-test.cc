@@ -0,0 +1,97 @@
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "paxos-switch.h"
+
+// Tests of the PaxosSwitch forwarding plane, run with ctest or by hand:
+//   sync-paxos-test --suite=paxos-switch --verbose
+
+// A packet to the switch node itself, received on a cut-through port, reaches
+// the IPv4 stack at the end of its reception and not after its headers.
+class PaxosSwitchLocalDeliveryTest : public ns3::TestCase
+{
+public:
+    PaxosSwitchLocalDeliveryTest();
+
+private:
+    void DoRun() override;
+    void Receive(ns3::Ptr<ns3::Socket> socket);
+
+    ns3::Time m_rxTime; // time at which the socket of the switch got the packet
+};
+
+PaxosSwitchLocalDeliveryTest::PaxosSwitchLocalDeliveryTest()
+    : ns3::TestCase("PaxosSwitch local delivery on a cut-through port")
+{
+}
+
+void
+PaxosSwitchLocalDeliveryTest::Receive(ns3::Ptr<ns3::Socket> socket)
+{
+    while (socket->Recv())
+    {
+        m_rxTime = ns3::Simulator::Now();
+    }
+}
+
+void
+PaxosSwitchLocalDeliveryTest::DoRun()
+{
+    ns3::NodeContainer nodes(2);
+    ns3::Ptr<ns3::Node> host = nodes.Get(0);
+    ns3::Ptr<ns3::Node> sw = nodes.Get(1);
+
+    // One byte per microsecond
+    ns3::PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", ns3::StringValue("8Mbps"));
+    p2p.SetChannelAttribute("Delay", ns3::StringValue("5us"));
+    ns3::NetDeviceContainer devices = p2p.Install(host, sw);
+    devices.Get(1)->SetAttribute("CutThroughBytes", ns3::UintegerValue(PaxosSwitch::CUT_THROUGH_BYTES));
+
+    ns3::InternetStackHelper stack;
+    stack.Install(nodes);
+    ns3::Ipv4AddressHelper address("10.0.0.0", "255.255.255.0");
+    ns3::Ipv4InterfaceContainer interfaces = address.Assign(devices);
+    ns3::Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    ns3::Ptr<PaxosSwitch> paxosSwitch = ns3::CreateObject<PaxosSwitch>();
+    paxosSwitch->Install(sw, 16);
+
+    ns3::Ptr<ns3::Socket> rxSocket = ns3::Socket::CreateSocket(sw, ns3::UdpSocketFactory::GetTypeId());
+    rxSocket->Bind(ns3::InetSocketAddress(ns3::Ipv4Address::GetAny(), 9));
+    rxSocket->SetRecvCallback(MakeCallback(&PaxosSwitchLocalDeliveryTest::Receive, this));
+
+    ns3::Ptr<ns3::Socket> txSocket = ns3::Socket::CreateSocket(host, ns3::UdpSocketFactory::GetTypeId());
+    txSocket->Connect(ns3::InetSocketAddress(interfaces.GetAddress(1), 9));
+    ns3::Simulator::Schedule(ns3::Seconds(1), [txSocket]() { txSocket->Send(ns3::Create<ns3::Packet>(1000)); });
+
+    ns3::Simulator::Run();
+
+    // 1000 bytes of payload, 8 of UDP, 20 of IPv4 and 2 of PPP
+    NS_TEST_EXPECT_MSG_EQ(m_rxTime,
+                          ns3::Seconds(1) + ns3::MicroSeconds(5 + 1030),
+                          "The packet is not delivered at the end of its reception");
+
+    ns3::Simulator::Destroy();
+}
+
+class PaxosSwitchTestSuite : public ns3::TestSuite
+{
+public:
+    PaxosSwitchTestSuite();
+};
+
+PaxosSwitchTestSuite::PaxosSwitchTestSuite()
+    : ns3::TestSuite("paxos-switch", Type::UNIT)
+{
+    AddTestCase(new PaxosSwitchLocalDeliveryTest, ns3::TestCase::Duration::QUICK);
+}
+
+static PaxosSwitchTestSuite g_paxosSwitchTestSuite;
+
+int main(int argc, char *argv[])
+{
+    return ns3::TestRunner::Run(argc, argv);
+}
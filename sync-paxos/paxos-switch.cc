@@ -0,0 +1,245 @@
+#include "paxos-switch.h"
+
+NS_LOG_COMPONENT_DEFINE("PaxosSwitch");
+
+PaxosSwitch::PaxosSwitch()
+    : m_tableMask(0), m_tableGeneration(0), m_forwarded(0), m_punted(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PaxosSwitch::~PaxosSwitch()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ns3::TypeId
+PaxosSwitch::GetTypeId(void)
+{
+    static ns3::TypeId tid = ns3::TypeId("PaxosSwitch")
+        .SetParent<ns3::Object>()
+        .AddConstructor<PaxosSwitch>();
+    return tid;
+}
+
+void
+PaxosSwitch::Install(ns3::Ptr<ns3::Node> node, uint32_t tableSize)
+{
+    NS_LOG_FUNCTION(this << node << tableSize);
+    m_node = node;
+    m_ipv4 = node->GetObject<ns3::Ipv4L3Protocol>();
+    m_tc = node->GetObject<ns3::TrafficControlLayer>();
+    NS_ABORT_MSG_IF(!m_ipv4 || !m_tc, "PaxosSwitch needs the internet stack on node " << node->GetId());
+
+    // Round up to a power of two, so that the table index is a mask
+    uint32_t size = 1;
+    while (size < std::max<uint32_t>(tableSize, 1))
+    {
+        size <<= 1;
+    }
+    m_table.assign(size, Entry());
+    m_tableMask = size - 1;
+    m_tableGeneration = 0;
+
+    for (uint32_t i = 0; i < node->GetNDevices(); i++)
+    {
+        ns3::Ptr<ns3::NetDevice> device = node->GetDevice(i);
+        m_interfaces.push_back(m_ipv4->GetInterfaceForDevice(device));
+        m_ports.push_back(ns3::DynamicCast<ns3::PointToPointNetDevice>(device));
+        // The packets a node sends to itself stay on the IPv4 stack
+        if (!ns3::DynamicCast<ns3::LoopbackNetDevice>(device))
+        {
+            device->SetReceiveCallback(MakeCallback(&PaxosSwitch::Receive, this));
+        }
+    }
+    node->AggregateObject(this);
+    NS_LOG_INFO("PaxosSwitch on node " << node->GetId() << " with " << size << " table entries");
+}
+
+void
+PaxosSwitch::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_node)
+    {
+        NS_LOG_INFO("PaxosSwitch on node " << m_node->GetId() << " forwarded " << m_forwarded
+                                           << " packets, handed " << m_punted << " to the IPv4 stack");
+    }
+    m_node = nullptr;
+    m_ipv4 = nullptr;
+    m_tc = nullptr;
+    m_ports.clear();
+    m_table.clear();
+    ns3::Object::DoDispose();
+}
+
+bool
+PaxosSwitch::Receive(ns3::Ptr<ns3::NetDevice> device, ns3::Ptr<const ns3::Packet> packet,
+                     uint16_t protocol, const ns3::Address &from)
+{
+    NS_LOG_FUNCTION(this << device << packet << protocol << from);
+    uint32_t index = device->GetIfIndex();
+    int32_t interface = m_interfaces[index];
+    if (protocol != ns3::Ipv4L3Protocol::PROT_NUMBER || interface < 0 || !m_ipv4->IsUp(interface))
+    {
+        return Punt(device, packet, protocol, from);
+    }
+
+    ns3::Ptr<ns3::Packet> p = packet->Copy();
+    ns3::Ipv4Header header;
+    if (ns3::Node::ChecksumEnabled())
+    {
+        header.EnableChecksum();
+    }
+    p->RemoveHeader(header);
+    ns3::Ipv4Address destination = header.GetDestination();
+    if (header.GetTtl() <= 1 || destination.IsBroadcast() || destination.IsMulticast() ||
+        !header.IsChecksumOk())
+    {
+        return Punt(device, packet, protocol, from);
+    }
+
+    const Entry *entry = Lookup(p, header, interface);
+    if (!entry || entry->local || p->GetSize() + header.GetSerializedSize() > entry->mtu)
+    {
+        return Punt(device, packet, protocol, from);
+    }
+
+    // As Ipv4L3Protocol::IpForward, the queue discs classify the packets on the priority tag
+    header.SetTtl(header.GetTtl() - 1);
+    ns3::SocketPriorityTag priorityTag;
+    p->RemovePacketTag(priorityTag);
+    uint8_t priority = ns3::Socket::IpTos2Priority(header.GetTos());
+    if (priority)
+    {
+        priorityTag.SetPriority(priority);
+        p->AddPacketTag(priorityTag);
+    }
+    ns3::Ptr<ns3::Ipv4QueueDiscItem> item =
+        ns3::Create<ns3::Ipv4QueueDiscItem>(p, entry->neighbor, ns3::Ipv4L3Protocol::PROT_NUMBER, header);
+    m_forwarded++;
+
+    // A cut-through port hands the packet up before its end: the egress starts now,
+    // unless a faster egress would finish sending the packet before receiving it
+    ns3::Ptr<ns3::PointToPointNetDevice> port = m_ports[index];
+    if (port && entry->port)
+    {
+        ns3::Time rxEnd = port->GetReceiveEnd();
+        ns3::Time txEnd = ns3::Simulator::Now() + entry->port->GetBackgroundDelay(p) +
+                          entry->port->GetAvailableRate(p).CalculateBytesTxTime(item->GetSize());
+        if (txEnd < rxEnd)
+        {
+            ns3::Simulator::Schedule(rxEnd - txEnd, &PaxosSwitch::Send, this, entry->device, item);
+            return true;
+        }
+    }
+    Send(entry->device, item);
+    return true;
+}
+
+bool
+PaxosSwitch::Punt(ns3::Ptr<ns3::NetDevice> device, ns3::Ptr<const ns3::Packet> packet,
+                  uint16_t protocol, const ns3::Address &from)
+{
+    m_punted++;
+
+    // A cut-through port hands the packet up before its end, the IPv4 stack only
+    // gets it once received in full, as without cut-through
+    ns3::Ptr<ns3::PointToPointNetDevice> port = m_ports[device->GetIfIndex()];
+    ns3::Time now = ns3::Simulator::Now();
+    if (port && port->GetReceiveEnd() > now)
+    {
+        ns3::Simulator::Schedule(port->GetReceiveEnd() - now, &PaxosSwitch::Deliver, this,
+                                 device, packet, protocol, from);
+        return true;
+    }
+    Deliver(device, packet, protocol, from);
+    return true;
+}
+
+void
+PaxosSwitch::Deliver(ns3::Ptr<ns3::NetDevice> device, ns3::Ptr<const ns3::Packet> packet,
+                     uint16_t protocol, const ns3::Address &from)
+{
+    NS_LOG_FUNCTION(this << device << packet << protocol << from);
+    // The internet stack registers the traffic control layer as the node protocol
+    // handler of all its protocols, so this is what the node would have called
+    m_tc->Receive(device, packet, protocol, from, device->GetAddress(), ns3::NetDevice::PACKET_HOST);
+}
+
+const PaxosSwitch::Entry *
+PaxosSwitch::Lookup(ns3::Ptr<ns3::Packet> packet, const ns3::Ipv4Header &header, uint32_t iif)
+{
+    // The entries are the routes of a generation, none can be kept for 0
+    ns3::Ptr<ns3::Ipv4RoutingProtocol> routing = m_ipv4->GetRoutingProtocol();
+    uint64_t generation = routing->GetRouteGeneration();
+    if (generation != m_tableGeneration)
+    {
+        std::fill(m_table.begin(), m_table.end(), Entry());
+        m_tableGeneration = generation;
+    }
+    if (generation == 0)
+    {
+        return nullptr;
+    }
+
+    ns3::Ipv4Address destination = header.GetDestination();
+    Entry &entry = m_table[ns3::Ipv4AddressHash()(destination) & m_tableMask];
+    if (entry.valid && entry.destination == destination)
+    {
+        return &entry;
+    }
+
+    // Miss, the new destination replaces the one of its slot
+    Entry fill;
+    fill.destination = destination;
+    fill.valid = true;
+    if (m_ipv4->IsDestinationAddress(destination, iif))
+    {
+        fill.local = true;
+        entry = fill;
+        return &entry;
+    }
+
+    ns3::Socket::SocketErrno error;
+    ns3::Ptr<ns3::Ipv4Route> route = routing->RouteOutput(packet, header, nullptr, error);
+    if (!route)
+    {
+        return nullptr;
+    }
+    fill.device = route->GetOutputDevice();
+    int32_t interface = m_ipv4->GetInterfaceForDevice(fill.device);
+    if (interface < 0)
+    {
+        return nullptr;
+    }
+    fill.mtu = m_ipv4->GetMtu(interface);
+
+    // Only the neighbors known at build time, the IPv4 stack resolves the others
+    ns3::Ipv4Address nextHop = route->GetGateway() == ns3::Ipv4Address::GetAny() ? destination : route->GetGateway();
+    if (fill.device->NeedsArp())
+    {
+        ns3::Ptr<ns3::ArpCache> cache = m_ipv4->GetInterface(interface)->GetArpCache();
+        ns3::ArpCache::Entry *neighbor = cache ? cache->Lookup(nextHop) : nullptr;
+        if (!neighbor || !(neighbor->IsPermanent() || neighbor->IsAutoGenerated()))
+        {
+            return nullptr;
+        }
+        fill.neighbor = neighbor->GetMacAddress();
+    }
+    else
+    {
+        fill.neighbor = fill.device->GetBroadcast();
+    }
+
+    fill.port = ns3::DynamicCast<ns3::PointToPointNetDevice>(fill.device);
+    entry = fill;
+    return &entry;
+}
+
+void
+PaxosSwitch::Send(ns3::Ptr<ns3::NetDevice> device, ns3::Ptr<ns3::Ipv4QueueDiscItem> item)
+{
+    NS_LOG_FUNCTION(this << device << item);
+    m_tc->Send(device, item);
+}
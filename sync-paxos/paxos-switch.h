@@ -0,0 +1,86 @@
+#ifndef PAXOS_SWITCH_H
+#define PAXOS_SWITCH_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/traffic-control-module.h"
+
+#include <vector>
+
+// The PaxosSwitch class is a lightweight IPv4 forwarding plane for the leaf
+// and spine nodes of the Clos fabric. It takes the packets of the node devices
+// before the IPv4 stack: a packet to another node is looked up in a fixed-size
+// table and handed to the queue discs of the egress device at once, without
+// Ipv4L3Protocol (no route callbacks, forwarding traces nor ICMP). The packets
+// to the node itself and those the switch can not forward (TTL expired, too
+// large for the egress MTU, no route, neighbor not resolved) go up the IPv4
+// stack as before, so applications still run on the switch nodes.
+//
+// The ports may hand packets up after their headers (cut-through, see the
+// CutThroughBytes attribute of ns3::PointToPointNetDevice): the egress then
+// starts at once, unless it would finish before the ingress does.
+
+class PaxosSwitch : public ns3::Object
+{
+public:
+    // Bytes a cut-through port needs to forward a packet: the PPP and IPv4 headers
+    static const uint32_t CUT_THROUGH_BYTES = 2 + 20;
+
+    PaxosSwitch();
+    ~PaxosSwitch();
+
+    static ns3::TypeId GetTypeId(void);
+
+    // Take the packets of all the devices of the node, which must have the
+    // internet stack and no other protocol handler on its devices.
+    // The table has tableSize entries, rounded up to a power of two.
+    void Install(ns3::Ptr<ns3::Node> node, uint32_t tableSize);
+
+protected:
+    void DoDispose() override;
+
+private:
+    // A destination of the table, direct mapped by address
+    struct Entry {
+        ns3::Ipv4Address destination;
+        bool valid = false;
+        bool local = false;              // to the node itself, for the IPv4 stack
+        ns3::Ptr<ns3::NetDevice> device; // egress device
+        ns3::Address neighbor;           // MAC address of the next hop
+        uint16_t mtu = 0;                // of the egress interface
+        ns3::Ptr<ns3::PointToPointNetDevice> port; // egress device if point-to-point
+    };
+
+    bool Receive(ns3::Ptr<ns3::NetDevice> device, ns3::Ptr<const ns3::Packet> packet,
+                 uint16_t protocol, const ns3::Address &from);
+
+    // Hand a packet to the IPv4 stack, as the node would have done, once it is
+    // received in full
+    bool Punt(ns3::Ptr<ns3::NetDevice> device, ns3::Ptr<const ns3::Packet> packet,
+              uint16_t protocol, const ns3::Address &from);
+    void Deliver(ns3::Ptr<ns3::NetDevice> device, ns3::Ptr<const ns3::Packet> packet,
+                 uint16_t protocol, const ns3::Address &from);
+
+    // Entry of a destination, filled from the routing protocol on a miss.
+    // Returns nullptr if the destination can not be cached.
+    const Entry *Lookup(ns3::Ptr<ns3::Packet> packet, const ns3::Ipv4Header &header, uint32_t iif);
+
+    void Send(ns3::Ptr<ns3::NetDevice> device, ns3::Ptr<ns3::Ipv4QueueDiscItem> item);
+
+    ns3::Ptr<ns3::Node> m_node;
+    ns3::Ptr<ns3::Ipv4L3Protocol> m_ipv4;
+    ns3::Ptr<ns3::TrafficControlLayer> m_tc;
+    std::vector<int32_t> m_interfaces; // IPv4 interface of each device, by device index, -1: none
+    std::vector<ns3::Ptr<ns3::PointToPointNetDevice>> m_ports; // point-to-point devices, by device index
+
+    std::vector<Entry> m_table;
+    uint32_t m_tableMask;
+    uint64_t m_tableGeneration; // route generation of the entries, 0: empty
+
+    uint64_t m_forwarded; // packets forwarded by the switch
+    uint64_t m_punted;    // packets handed to the IPv4 stack
+};
+
+#endif // PAXOS_SWITCH_H
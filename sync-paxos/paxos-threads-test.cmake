@@ -0,0 +1,34 @@
+# Test of the multithreaded simulator, run by ctest when ns-3 is built with
+# NS3_MTP=ON: sync-paxos runs the same scenario sequentially and on THREADS
+# threads, and the decision logs of the servers must be the same.
+#   cmake -DSYNC_PAXOS=<sync-paxos> -DTHREADS=4 -DOUTPUT_DIR=<dir> -P paxos-threads-test.cmake
+
+foreach(threads 1 ${THREADS})
+    set(dir ${OUTPUT_DIR}/threads-${threads})
+    file(REMOVE_RECURSE ${dir})
+    file(MAKE_DIRECTORY ${dir})
+    execute_process(
+        COMMAND ${SYNC_PAXOS} --threads=${threads} --duration=20ms --outputDir=${dir}
+                --numSpines=2 --numLeaves=3 --hostsPerLeaf=2 --mode=sync --boundedMessageDelay=50us
+                --clockSyncError=10ns --requestInterval=10us
+        WORKING_DIRECTORY ${dir}
+        RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "sync-paxos --threads=${threads} failed: ${result}")
+    endif()
+endforeach()
+
+file(GLOB logs RELATIVE ${OUTPUT_DIR}/threads-1 ${OUTPUT_DIR}/threads-1/*-decision-log.dat)
+if(NOT logs)
+    message(FATAL_ERROR "sync-paxos --threads=1 wrote no decision log")
+endif()
+foreach(log ${logs})
+    execute_process(
+        COMMAND ${CMAKE_COMMAND} -E compare_files ${OUTPUT_DIR}/threads-1/${log} ${OUTPUT_DIR}/threads-${THREADS}/${log}
+        RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "${log} differs between 1 and ${THREADS} threads")
+    endif()
+endforeach()
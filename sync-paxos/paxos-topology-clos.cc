@@ -15,21 +15,57 @@ PaxosTopologyClos::PaxosTopologyClos(uint32_t numSpines,
     NS_LOG_INFO("Creating Clos topology with " << numSpines << " spines, " << numLeaves << " leaves, " << numHostsPerLeaf << " hosts per leaf, " << bandwidthLeaf2Spine << " bandwidth leaf to spine, " << delayLeaf2Spine << " delay leaf to spine, " << bandwidthHost2Leaf << " bandwidth host to leaf, " << delayHost2Leaf << " delay host to leaf");
 
     m_paxosConfig = paxosConfig;
+    m_bandwidthHost2Leaf = bandwidthHost2Leaf;
+
+    // Partition the nodes over the ranks of a distributed simulation (one rank otherwise):
+    // a leaf and its hosts are on the same rank, the spines are spread over the ranks,
+    // so only the leaf-spine links cross ranks and become remote channels.
+    uint32_t systemCount = std::max<uint32_t>(m_paxosConfig.systemCount, 1);
+    NS_LOG_INFO("Partitioning the nodes over " << systemCount << " ranks, this is rank " << m_paxosConfig.systemId);
 
     // Create spine nodes
-    m_spineNodes.Create(numSpines);
+    for (uint32_t i = 0; i < numSpines; i++)
+    {
+        m_spineNodes.Create(1, i % systemCount);
+    }
 
     // Create leaf nodes
-    m_leafNodes.Create(numLeaves);
+    for (uint32_t i = 0; i < numLeaves; i++)
+    {
+        m_leafNodes.Create(1, i % systemCount);
+    }
 
     // Create host nodes
     for (uint32_t i = 0; i < numLeaves; i++)
     {
         ns3::NodeContainer hostNodes;
-        hostNodes.Create(numHostsPerLeaf);
+        hostNodes.Create(numHostsPerLeaf, i % systemCount);
         m_hostNodes.push_back(hostNodes);
     }
 
+    // In a multithreaded simulation, a leaf and its hosts are one partition and each spine
+    // is another one, so only the leaf-spine links cross partitions and bound the lookahead.
+    if (m_paxosConfig.threads > 1)
+    {
+        ns3::Ptr<ns3::MultithreadedSimulatorImpl> impl =
+            ns3::DynamicCast<ns3::MultithreadedSimulatorImpl>(ns3::Simulator::GetImplementation());
+        NS_ASSERT_MSG(impl, "--threads needs ns3::MultithreadedSimulatorImpl");
+        for (uint32_t i = 0; i < numLeaves; i++)
+        {
+            impl->SetPartition(m_leafNodes.Get(i)->GetId(), i);
+            for (uint32_t j = 0; j < numHostsPerLeaf; j++)
+            {
+                impl->SetPartition(m_hostNodes[i].Get(j)->GetId(), i);
+            }
+        }
+        for (uint32_t i = 0; i < numSpines; i++)
+        {
+            impl->SetPartition(m_spineNodes.Get(i)->GetId(), numLeaves + i);
+        }
+        impl->SetAttribute("Lookahead", ns3::TimeValue(ns3::Time(delayLeaf2Spine)));
+        NS_LOG_INFO("Partitioning the nodes over " << impl->GetPartitionCount() << " partitions on " << m_paxosConfig.threads << " threads");
+    }
+
     // Install Network Stacks
     NS_LOG_INFO("Installing network stacks");
     ns3::InternetStackHelper internet;
@@ -40,20 +76,18 @@ PaxosTopologyClos::PaxosTopologyClos(uint32_t numSpines,
         internet.Install(*it);
     }
 
-    // Create point-to-point links between spine and leaf
-    ns3::PointToPointHelper p2p;
-    p2p.SetDeviceAttribute("DataRate", ns3::StringValue(bandwidthLeaf2Spine));
-    p2p.SetChannelAttribute("Delay", ns3::StringValue(delayLeaf2Spine));
-
+    // Create links between spine and leaf
     for (uint32_t i = 0; i < numSpines; i++)
     {
         std::vector<ns3::NetDeviceContainer> spineLeafLinksMatrixRow;
         std::vector<ns3::Ipv4InterfaceContainer> spineLeafInterfaceMatrixRow;
         for (uint32_t j = 0; j < numLeaves; j++)
         {
-            // Install P2P link between spine and leaf
-            ns3::NetDeviceContainer spineLeafLink = p2p.Install(m_spineNodes.Get(i), m_leafNodes.Get(j));
+            // Install link between spine and leaf
+            ns3::NetDeviceContainer spineLeafLink =
+                InstallLink(m_spineNodes.Get(i), m_leafNodes.Get(j), bandwidthLeaf2Spine, delayLeaf2Spine);
             spineLeafLinksMatrixRow.push_back(spineLeafLink);
+            InstallQueueDiscs(spineLeafLink);
 
             // Assign IP addresses to the devices
             ns3::Ipv4AddressHelper ipv4;
@@ -61,26 +95,25 @@ PaxosTopologyClos::PaxosTopologyClos(uint32_t numSpines,
             subnet << "10." << i << "." << j << ".0";
             ipv4.SetBase(subnet.str().c_str(), "255.255.255.0");
             ns3::Ipv4InterfaceContainer spineLeafInterface = ipv4.Assign(spineLeafLink);
+            PopulateNeighbors(spineLeafInterface);
             spineLeafInterfaceMatrixRow.push_back(spineLeafInterface);
         }
         m_spineLeafLinksMatrix.push_back(spineLeafLinksMatrixRow);
         m_spineLeafInterfaceMatrix.push_back(spineLeafInterfaceMatrixRow);
     }
 
-    // Create point-to-point links between leaf and host
-    ns3::PointToPointHelper p2pHost;
-    p2pHost.SetDeviceAttribute("DataRate", ns3::StringValue(bandwidthHost2Leaf));
-    p2pHost.SetChannelAttribute("Delay", ns3::StringValue(delayHost2Leaf));
-
+    // Create links between leaf and host
     for (uint32_t i = 0; i < numLeaves; i++)
     {
         std::vector<ns3::NetDeviceContainer> leafHostLinksMatrixRow;
         std::vector<ns3::Ipv4InterfaceContainer> leafHostInterfaceMatrixRow;
         for (uint32_t j = 0; j < numHostsPerLeaf; j++)
         {
-            // Install P2P link between leaf and host
-            ns3::NetDeviceContainer leafHostLink = p2pHost.Install(m_leafNodes.Get(i), m_hostNodes[i].Get(j));
+            // Install link between leaf and host
+            ns3::NetDeviceContainer leafHostLink =
+                InstallLink(m_leafNodes.Get(i), m_hostNodes[i].Get(j), bandwidthHost2Leaf, delayHost2Leaf);
             leafHostLinksMatrixRow.push_back(leafHostLink);
+            InstallQueueDiscs(leafHostLink);
 
             // Assign IP addresses to the devices
             ns3::Ipv4AddressHelper ipv4;
@@ -88,6 +121,7 @@ PaxosTopologyClos::PaxosTopologyClos(uint32_t numSpines,
             subnet << "20." << i << "." << j << ".0";
             ipv4.SetBase(subnet.str().c_str(), "255.255.255.0");
             ns3::Ipv4InterfaceContainer leafHostInterface = ipv4.Assign(leafHostLink);
+            PopulateNeighbors(leafHostInterface);
             leafHostInterfaceMatrixRow.push_back(leafHostInterface);
         }
 
@@ -114,15 +148,108 @@ PaxosTopologyClos::PaxosTopologyClos(uint32_t numSpines,
 
     // Populate the Routing table
     ns3::Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    // Leaf and spine nodes forward without the IPv4 stack
+    if (m_paxosConfig.switches)
+    {
+        InstallSwitches(m_spineNodes);
+        InstallSwitches(m_leafNodes);
+    }
 }
 
 PaxosTopologyClos::~PaxosTopologyClos()
 {
 }
 
+bool PaxosTopologyClos::IsLocalNode(ns3::Ptr<ns3::Node> node)
+{
+    return !m_paxosConfig.distributed || node->GetSystemId() == m_paxosConfig.systemId;
+}
+
+void PaxosTopologyClos::InstallQueueDiscs(ns3::NetDeviceContainer devices)
+{
+    if (!m_paxosConfig.prioritizeConsensus)
+    {
+        return;
+    }
+
+    // Two strict priority bands: band 0 for consensus traffic (NS3_PRIO_INTERACTIVE/CONTROL),
+    // band 1 for everything else. PrioQueueDisc creates a FIFO child queue disc per band.
+    ns3::TrafficControlHelper tch;
+    uint16_t handle = tch.SetRootQueueDisc("ns3::PrioQueueDisc",
+                                           "Priomap", ns3::StringValue("1 1 1 1 1 1 0 0 1 1 1 1 1 1 1 1"));
+    ns3::TrafficControlHelper::ClassIdList cid = tch.AddQueueDiscClasses(handle, 2, "ns3::QueueDiscClass");
+    tch.AddChildQueueDisc(handle, cid[0], "ns3::FifoQueueDisc");
+    tch.AddChildQueueDisc(handle, cid[1], "ns3::FifoQueueDisc");
+    tch.Install(devices);
+
+    // The fluid background flows are in band 1, band 0 goes ahead of them. The queue disc
+    // removes the priority tag before the device, which reads the TOS as the priomap does.
+    ns3::PointToPointNetDevice::BackgroundBypassCallback inBand0([](ns3::Ptr<const ns3::Packet> p) {
+        ns3::Ipv4Header header;
+        p->PeekHeader(header);
+        return ns3::Socket::IpTos2Priority(header.GetTos()) >= ns3::Socket::NS3_PRIO_INTERACTIVE;
+    });
+    for (uint32_t i = 0; i < devices.GetN(); i++)
+    {
+        ns3::Ptr<ns3::PointToPointNetDevice> device = ns3::DynamicCast<ns3::PointToPointNetDevice>(devices.Get(i));
+        if (device)
+        {
+            device->SetBackgroundBypassCallback(inBand0);
+        }
+    }
+}
+
+ns3::NetDeviceContainer PaxosTopologyClos::InstallLink(ns3::Ptr<ns3::Node> a, ns3::Ptr<ns3::Node> b,
+                                                       std::string dataRate, std::string delay)
+{
+    if (m_paxosConfig.linkType == "csma")
+    {
+        ns3::CsmaHelper csma;
+        csma.SetChannelAttribute("DataRate", ns3::StringValue(dataRate));
+        csma.SetChannelAttribute("Delay", ns3::StringValue(delay));
+        return csma.Install(ns3::NodeContainer(a, b));
+    }
+
+    ns3::PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", ns3::StringValue(dataRate));
+    p2p.SetChannelAttribute("Delay", ns3::StringValue(delay));
+    return p2p.Install(a, b);
+}
+
+void PaxosTopologyClos::PopulateNeighbors(ns3::Ipv4InterfaceContainer interfaces)
+{
+    if (!m_paxosConfig.staticNeighbors)
+    {
+        return;
+    }
+
+    // Both ends of the link are known here, so no ARP request is ever sent on it
+    ns3::NeighborCacheHelper neighborCache;
+    neighborCache.PopulateNeighborCache(interfaces);
+}
+
+void PaxosTopologyClos::InstallSwitches(ns3::NodeContainer nodes)
+{
+    for (uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        ns3::Ptr<ns3::Node> node = nodes.Get(i);
+        for (uint32_t j = 0; m_paxosConfig.cutThrough && j < node->GetNDevices(); j++)
+        {
+            ns3::Ptr<ns3::PointToPointNetDevice> port = ns3::DynamicCast<ns3::PointToPointNetDevice>(node->GetDevice(j));
+            if (port)
+            {
+                port->SetAttribute("CutThroughBytes", ns3::UintegerValue(PaxosSwitch::CUT_THROUGH_BYTES));
+            }
+        }
+        ns3::CreateObject<PaxosSwitch>()->Install(node, m_paxosConfig.switchTableSize);
+    }
+}
+
 ns3::Ipv4Address PaxosTopologyClos::GetSpineAddress(uint32_t spineId)
 {
-    return m_spineLeafInterfaceMatrix[spineId][0].GetAddress(1);
+    // Interface 0 is the spine side of the spine-leaf link
+    return m_spineLeafInterfaceMatrix[spineId][0].GetAddress(0);
 }
 
 ns3::Ipv4Address PaxosTopologyClos::GetLeafAddress(uint32_t spineId, uint32_t leafId)
@@ -141,18 +268,26 @@ PaxosTopologyClos::InitPaxosServerCluster(std::vector<std::pair<uint32_t, uint32
     NS_LOG_INFO("Initializing Paxos servers");
     int32_t ret = 0;
 
-    if (m_paxosConfig.isSynchronous)
+    PaxosAppServer::s_mode = m_paxosConfig.mode;
+    if (m_paxosConfig.mode == PAXOS_MODE_SYNC)
     {
         NS_LOG_INFO("   ---- Paxos servers are synchronous");
-        PaxosAppServer::s_async = false;
     }
-    else
+    else if (m_paxosConfig.mode == PAXOS_MODE_ASYNC)
     {
         NS_LOG_INFO("   ---- Paxos servers are asynchronous");
-        PaxosAppServer::s_async = true;
         PaxosAppServer::s_leader = 0;
         PaxosAppServer::s_proposeTimeout = ns3::Time(m_paxosConfig.serverTimeout);
     }
+    else if (m_paxosConfig.mode == PAXOS_MODE_SEQUENCER)
+    {
+        NS_LOG_INFO("   ---- Paxos servers are ordered by the sequencer");
+        PaxosAppServer::s_leader = 0;
+    }
+    else
+    {
+        NS_LOG_INFO("   ---- Paxos servers are leaderless");
+    }
 
     // Collect all hosts Info
     for (uint32_t i = 0; i < hostIdList.size(); i++)
@@ -178,12 +313,23 @@ PaxosTopologyClos::InitPaxosServerCluster(std::vector<std::pair<uint32_t, uint32
     {
         NS_LOG_INFO("   ---- Creating Paxos server " << i << " on host " << m_serverInfoList[i].address << "");
         ns3::Ptr<ns3::Node> node = m_hostNodes[hostIdList[i].first].Get(hostIdList[i].second);
+        if (!IsLocalNode(node))
+        {
+            continue;
+        }
 
         // Create PaxosAppServer and Install on this node
         ns3::Ptr<PaxosAppServer> paxosAppServer = ns3::CreateObject<PaxosAppServer>(i, m_serverInfoList);
         paxosAppServer->SetClockSyncError(ns3::Time(m_paxosConfig.clockSyncError));
         paxosAppServer->SetBoundedMessageDelay(ns3::Time(m_paxosConfig.boundedMessageDelay));
         paxosAppServer->SetNodeFailureRate(m_paxosConfig.nodeFailureRate);
+        paxosAppServer->SetLeaseDuration(ns3::Time(m_paxosConfig.leaseDuration));
+        paxosAppServer->SetReadRatio(m_paxosConfig.readRatio);
+        paxosAppServer->SetOutputDir(m_paxosConfig.outputDir);
+        if (m_paxosConfig.prioritizeConsensus)
+        {
+            paxosAppServer->SetIpTos(PAXOS_IP_TOS);
+        }
 
         m_paxosAppServerContainer.Add(paxosAppServer);
         node->AddApplication(paxosAppServer);
@@ -202,10 +348,18 @@ PaxosTopologyClos::InitPaxosClientCluster(std::vector<uint32_t> spineIdList)
     {
         NS_LOG_INFO("   ---- Creating Paxos client " << i << " on spine " << spineIdList[i]);
         ns3::Ptr<ns3::Node> node = m_spineNodes.Get(spineIdList[i]);
+        if (!IsLocalNode(node))
+        {
+            continue;
+        }
 
         // Create PaxosAppClient and Install on this node
         ns3::Ptr<PaxosAppClient> paxosAppClient = ns3::CreateObject<PaxosAppClient>(m_serverInfoList);
-        if (m_paxosConfig.isSynchronous)
+        if (!m_paxosConfig.requestInterval.empty())
+        {
+            paxosAppClient->SetSendInterval(ns3::Time(m_paxosConfig.requestInterval));
+        }
+        else if (m_paxosConfig.isSynchronous)
         {
             uint32_t interval = ns3::Time(m_paxosConfig.boundedMessageDelay).GetNanoSeconds() / 10;
             paxosAppClient->SetSendInterval(ns3::Time(std::to_string(interval) + "ns"));
@@ -215,6 +369,20 @@ PaxosTopologyClos::InitPaxosClientCluster(std::vector<uint32_t> spineIdList)
             uint32_t interval = ns3::Time(m_paxosConfig.linkDelay).GetNanoSeconds() / 5;
             paxosAppClient->SetSendInterval(ns3::Time(std::to_string(interval) + "ns"));
         }
+        if (m_paxosConfig.mode == PAXOS_MODE_SEQUENCER)
+        {
+            paxosAppClient->SetSequencer(m_sequencerAddress, SEQUENCER_PORT);
+        }
+        paxosAppClient->SetConflictRate(m_paxosConfig.conflictRate);
+        paxosAppClient->SetReadRatio(m_paxosConfig.readRatio);
+        if (m_paxosConfig.prioritizeConsensus)
+        {
+            paxosAppClient->SetIpTos(PAXOS_IP_TOS);
+        }
+        if (m_paxosConfig.mode == PAXOS_MODE_ASYNC)
+        {
+            paxosAppClient->SetReadLeader(PaxosAppServer::s_leader);
+        }
         m_paxosAppClientContainer.Add(paxosAppClient);
         node->AddApplication(paxosAppClient);
     }
@@ -222,6 +390,160 @@ PaxosTopologyClos::InitPaxosClientCluster(std::vector<uint32_t> spineIdList)
     return ret;
 }
 
+int32_t
+PaxosTopologyClos::InitPaxosSequencer(uint32_t spineId)
+{
+    NS_LOG_INFO("Initializing Paxos sequencer on spine " << spineId);
+
+    if (spineId >= m_spineNodes.GetN())
+    {
+        NS_LOG_ERROR("Invalid spine " << spineId);
+        return -1;
+    }
+
+    // The clients of all ranks need the address
+    m_sequencerAddress = GetSpineAddress(spineId);
+    if (!IsLocalNode(m_spineNodes.Get(spineId)))
+    {
+        return 0;
+    }
+
+    ns3::Ptr<PaxosSequencerApp> sequencer = ns3::CreateObject<PaxosSequencerApp>(spineId, m_serverInfoList);
+    if (m_paxosConfig.prioritizeConsensus)
+    {
+        sequencer->SetIpTos(PAXOS_IP_TOS);
+    }
+    m_spineNodes.Get(spineId)->AddApplication(sequencer);
+    m_paxosSequencerContainer.Add(sequencer);
+
+    return 0;
+}
+
+int32_t
+PaxosTopologyClos::InitBackgroundTraffic()
+{
+    NS_LOG_INFO("Initializing background traffic");
+
+    std::string pattern = m_paxosConfig.backgroundPattern;
+    if (pattern == "none" || m_paxosConfig.backgroundLoad <= 0)
+    {
+        NS_LOG_INFO("   ---- No background traffic");
+        return 0;
+    }
+
+    PaxosBackgroundApp::FlowSizeCdf flowSizeCdf;
+    if (!PaxosBackgroundApp::ParseFlowSizeCdf(m_paxosConfig.backgroundFlowCdf, flowSizeCdf))
+    {
+        NS_LOG_ERROR("Unknown background flow size CDF " << m_paxosConfig.backgroundFlowCdf);
+        return -1;
+    }
+
+    if (pattern != "all-to-all" && pattern != "incast")
+    {
+        NS_LOG_ERROR("Unknown background traffic pattern " << pattern);
+        return -1;
+    }
+
+    bool fluid = m_paxosConfig.backgroundModel == "fluid";
+    if (!fluid && m_paxosConfig.backgroundModel != "packet")
+    {
+        NS_LOG_ERROR("Unknown background model " << m_paxosConfig.backgroundModel);
+        return -1;
+    }
+
+    // Collect all hosts
+    std::vector<ns3::Ptr<ns3::Node>> hosts;
+    std::vector<ns3::Ipv4Address> hostAddresses;
+    for (uint32_t i = 0; i < m_hostNodes.size(); i++)
+    {
+        for (uint32_t j = 0; j < m_hostNodes[i].GetN(); j++)
+        {
+            hosts.push_back(m_hostNodes[i].Get(j));
+            hostAddresses.push_back(GetHostAddress(i, j));
+        }
+    }
+
+    if (hosts.size() < 2)
+    {
+        NS_LOG_ERROR("Background traffic needs at least 2 hosts");
+        return -1;
+    }
+
+    // The load is the target utilization of the host links.
+    // all-to-all: every host sends at load * bandwidth, spread over all other hosts.
+    // incast: all other hosts send to the last host on leaf 0, whose downlink is loaded at load * bandwidth.
+    double bitRate = ns3::DataRate(m_bandwidthHost2Leaf).GetBitRate() * m_paxosConfig.backgroundLoad;
+    double meanFlowSize = PaxosBackgroundApp::GetMeanFlowSize(flowSizeCdf);
+    double flowArrivalRate = bitRate / (8 * meanFlowSize);
+    uint32_t incastTarget = m_hostNodes[0].GetN() - 1;
+    if (pattern == "incast")
+    {
+        flowArrivalRate /= (hosts.size() - 1);
+    }
+
+    NS_LOG_INFO("   ---- Pattern " << pattern << ", flow size CDF " << m_paxosConfig.backgroundFlowCdf
+                << ", mean flow size " << meanFlowSize << " bytes, " << flowArrivalRate << " flows/s per sender");
+
+    // Fluid flows have no packets, the model is the sender and the receiver
+    if (fluid)
+    {
+        NS_LOG_INFO("   ---- Fluid flows, max-min fair rates on the links");
+        m_fluidBackground = ns3::CreateObject<PaxosFluidBackground>();
+        m_fluidBackground->SetFlowSizeCdf(flowSizeCdf);
+    }
+
+    // Install a sink on every receiving host
+    ns3::PacketSinkHelper sink("ns3::TcpSocketFactory",
+                               ns3::InetSocketAddress(ns3::Ipv4Address::GetAny(), BACKGROUND_PORT));
+    for (uint32_t i = 0; i < hosts.size() && !fluid; i++)
+    {
+        if ((pattern == "all-to-all" || i == incastTarget) && IsLocalNode(hosts[i]))
+        {
+            m_backgroundAppContainer.Add(sink.Install(hosts[i]));
+        }
+    }
+
+    // Install a flow generator on every sending host
+    for (uint32_t i = 0; i < hosts.size(); i++)
+    {
+        std::vector<ns3::Ipv4Address> peers;
+        if (pattern == "incast")
+        {
+            if (i == incastTarget)
+            {
+                continue;
+            }
+            peers.push_back(hostAddresses[incastTarget]);
+        }
+        else
+        {
+            for (uint32_t j = 0; j < hosts.size(); j++)
+            {
+                if (j != i)
+                {
+                    peers.push_back(hostAddresses[j]);
+                }
+            }
+        }
+
+        if (fluid)
+        {
+            m_fluidBackground->AddSource(hosts[i], peers, flowArrivalRate);
+            continue;
+        }
+        if (!IsLocalNode(hosts[i]))
+        {
+            continue;
+        }
+
+        ns3::Ptr<PaxosBackgroundApp> app = ns3::CreateObject<PaxosBackgroundApp>(peers, flowSizeCdf, flowArrivalRate);
+        m_backgroundAppContainer.Add(app);
+        hosts[i]->AddApplication(app);
+    }
+
+    return 0;
+}
+
 void PaxosTopologyClos::SetPaxosServerAppStartStop(ns3::Time start, ns3::Time end)
 {
     for (auto it = m_paxosAppServerContainer.Begin(); it != m_paxosAppServerContainer.End(); it++)
@@ -229,6 +551,13 @@ void PaxosTopologyClos::SetPaxosServerAppStartStop(ns3::Time start, ns3::Time en
         (*it)->SetStartTime(start);
         (*it)->SetStopTime(end);
     }
+
+    // The sequencer is part of the server side
+    for (auto it = m_paxosSequencerContainer.Begin(); it != m_paxosSequencerContainer.End(); it++)
+    {
+        (*it)->SetStartTime(start);
+        (*it)->SetStopTime(end);
+    }
 }
 
 void PaxosTopologyClos::SetPaxosClientAppStartStop(ns3::Time start, ns3::Time end)
@@ -239,3 +568,16 @@ void PaxosTopologyClos::SetPaxosClientAppStartStop(ns3::Time start, ns3::Time en
         (*it)->SetStopTime(end);
     }
 }
+
+void PaxosTopologyClos::SetBackgroundAppStartStop(ns3::Time start, ns3::Time end)
+{
+    for (auto it = m_backgroundAppContainer.Begin(); it != m_backgroundAppContainer.End(); it++)
+    {
+        (*it)->SetStartTime(start);
+        (*it)->SetStopTime(end);
+    }
+    if (m_fluidBackground)
+    {
+        m_fluidBackground->SetStartStop(start, end);
+    }
+}
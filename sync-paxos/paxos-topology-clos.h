@@ -9,10 +9,16 @@
 #include "ns3/applications-module.h"
 #include "ns3/ipv4-list-routing-helper.h"
 #include "ns3/ipv4-static-routing-helper.h"
+#include "ns3/traffic-control-module.h"
+#include "ns3/multithreaded-simulator-impl.h"
 
 #include "paxos-common.h"
 #include "paxos-app-server.h"
 #include "paxos-app-client.h"
+#include "paxos-background-traffic.h"
+#include "paxos-fluid-background.h"
+#include "paxos-sequencer.h"
+#include "paxos-switch.h"
 
 #include <vector>
 #include <string>
@@ -41,10 +47,39 @@ public:
     // and there is only one client
     int32_t InitPaxosClientCluster(std::vector<uint32_t> spineIdList);
 
+    // Only for sequencer mode, install the sequencer on a spine.
+    // Must be called after the servers and before the clients.
+    int32_t InitPaxosSequencer(uint32_t spineId);
+
+    // Install background flow generators on all hosts according to the
+    // background pattern, flow size CDF and load of the Paxos config,
+    // or the fluid flows of all hosts for the fluid background model
+    int32_t InitBackgroundTraffic();
+
     void SetPaxosServerAppStartStop(ns3::Time start, ns3::Time end);
     void SetPaxosClientAppStartStop(ns3::Time start, ns3::Time end);
+    void SetBackgroundAppStartStop(ns3::Time start, ns3::Time end);
 
 private:
+    // In a distributed simulation, applications are only installed on the nodes of this rank
+    bool IsLocalNode(ns3::Ptr<ns3::Node> node);
+
+    // Install strict priority queue discs on the devices if consensus traffic is prioritized.
+    // Must be called before assigning addresses, otherwise the default queue disc is installed.
+    void InstallQueueDiscs(ns3::NetDeviceContainer devices);
+
+    // Install a fabric link between two nodes, point-to-point or CSMA depending on the Paxos config
+    ns3::NetDeviceContainer InstallLink(ns3::Ptr<ns3::Node> a, ns3::Ptr<ns3::Node> b,
+                                        std::string dataRate, std::string delay);
+
+    // Add permanent ARP entries for the peer of a link if static neighbors are enabled.
+    // Point-to-point devices do not use ARP, only the csma links have entries.
+    void PopulateNeighbors(ns3::Ipv4InterfaceContainer interfaces);
+
+    // Forward with a PaxosSwitch on the nodes, cut-through if configured.
+    // Must be called once the routing tables are populated.
+    void InstallSwitches(ns3::NodeContainer nodes);
+
     ns3::NodeContainer m_spineNodes;
     ns3::NodeContainer m_leafNodes;
     std::vector<ns3::NodeContainer> m_hostNodes;
@@ -59,6 +94,12 @@ private:
     
     ns3::ApplicationContainer m_paxosAppServerContainer;
     ns3::ApplicationContainer m_paxosAppClientContainer;
+    ns3::ApplicationContainer m_paxosSequencerContainer;
+    ns3::Ipv4Address m_sequencerAddress;
+    ns3::ApplicationContainer m_backgroundAppContainer;
+    ns3::Ptr<PaxosFluidBackground> m_fluidBackground; // fluid background model, nullptr: none
+
+    std::string m_bandwidthHost2Leaf;
 
     PaxosConfig m_paxosConfig;
 };
@@ -0,0 +1,44 @@
+#include "ns3/core-module.h"
+
+#include "paxos-trace.h"
+
+#include <iostream>
+
+// Decode a binary trace written by sync-paxos --trace, one line per record:
+//   time_ns,node,event,proposal_id,stamp_ns
+// Sample usage: sync-paxos-trace --trace=paxos.trace --node=3 > paxos.csv
+
+NS_LOG_COMPONENT_DEFINE("PaxosTraceDecode");
+
+int main(int argc, char *argv[])
+{
+    std::string traceFile = "";
+    int64_t node = -1;
+    std::string event = "";
+
+    ns3::CommandLine cmd;
+    cmd.AddValue("trace", "Trace file written by sync-paxos --trace.", traceFile);
+    cmd.AddValue("node", "Only decode the records of this node, -1 for all.", node);
+    cmd.AddValue("event", "Only decode the records of this event (e.g. 'decided'), empty for all.", event);
+    cmd.Parse(argc, argv);
+
+    std::vector<PaxosTraceRecord> records;
+    if (traceFile.empty() || !PaxosTracer::Read(traceFile, records))
+    {
+        std::cerr << "Can not read trace file '" << traceFile << "'" << std::endl;
+        return -1;
+    }
+
+    std::cout << "time_ns,node,event,proposal_id,stamp_ns" << std::endl;
+    for (const auto &record : records)
+    {
+        const char *name = PaxosTracer::GetEventName(record.event);
+        if ((node >= 0 && record.node != static_cast<uint64_t>(node)) || (!event.empty() && event != name))
+        {
+            continue;
+        }
+        std::cout << record.time << "," << record.node << "," << name << "," << record.proposalId << ","
+                  << record.stamp << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "paxos-trace.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE("PaxosTrace");
+
+bool PaxosTracer::s_enabled = false;
+std::vector<PaxosTraceRecord> PaxosTracer::s_records;
+uint64_t PaxosTracer::s_mask = 0;
+#ifdef NS3_MTP
+std::atomic<uint64_t> PaxosTracer::s_next = 0;
+#else
+uint64_t PaxosTracer::s_next = 0;
+#endif
+
+static_assert(sizeof(PaxosTraceRecord) == 32, "PaxosTraceRecord is stored as is in the trace file");
+
+void PaxosTracer::Enable(uint32_t numRecords)
+{
+    // Round up to a power of two, so that the ring index is a mask
+    uint64_t size = 1;
+    while (size < std::max<uint32_t>(numRecords, 1))
+    {
+        size <<= 1;
+    }
+    NS_LOG_INFO("Tracing Paxos events in a ring buffer of " << size << " records");
+    s_records.assign(size, PaxosTraceRecord());
+    s_mask = size - 1;
+    s_next = 0;
+    s_enabled = true;
+}
+
+bool PaxosTracer::Write(const std::string &fileName)
+{
+    std::ofstream file(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        NS_LOG_ERROR("Can not open trace file " << fileName);
+        return false;
+    }
+
+    // Once the ring has wrapped, the oldest record is the next one to be overwritten
+    uint64_t next = s_next;
+    uint64_t count = std::min<uint64_t>(next, s_records.size());
+    uint64_t first = next - count;
+    file.write(MAGIC, sizeof(MAGIC) - 1);
+    file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    for (uint64_t i = first; i < next; i++)
+    {
+        file.write(reinterpret_cast<const char *>(&s_records[i & s_mask]), sizeof(PaxosTraceRecord));
+    }
+    NS_LOG_INFO("Wrote " << count << " of " << next << " Paxos trace records to " << fileName);
+    return file.good();
+}
+
+bool PaxosTracer::Read(const std::string &fileName, std::vector<PaxosTraceRecord> &records)
+{
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+    char magic[sizeof(MAGIC) - 1];
+    uint64_t count = 0;
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(magic)) != 0 ||
+        !file.read(reinterpret_cast<char *>(&count), sizeof(count)))
+    {
+        return false;
+    }
+    records.resize(count);
+    return count == 0 || bool(file.read(reinterpret_cast<char *>(records.data()), count * sizeof(PaxosTraceRecord)));
+}
+
+const char *PaxosTracer::GetEventName(uint16_t event)
+{
+    static const char *names[PAXOS_TRACE_EVENT_COUNT] = {
+        "unknown",
+        "request-sent",
+        "request-received",
+        "proposal-sent",
+        "proposal-received",
+        "accept-sent",
+        "accept-received",
+        "decided",
+        "decision-received",
+        "decision-ack-received",
+        "proposal-timeout",
+        "sequenced-received",
+        "gap-request",
+        "gap-fill",
+        "pre-accept",
+        "fast-commit",
+        "slow-commit",
+        "executed",
+        "read-served",
+    };
+    return event < PAXOS_TRACE_EVENT_COUNT ? names[event] : names[0];
+}
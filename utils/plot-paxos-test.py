@@ -43,6 +43,11 @@ def to_readable_time(time_str):
     else:  #ns
         return f"{int(value_ns)}ns"
 
+def first_decision_log(result_dir):
+    # The read logs live next to the decision logs, only count decisions
+    logs = sorted(f for f in os.listdir(result_dir) if f.endswith("decision-log.dat"))
+    return os.path.join(result_dir, logs[0])
+
 class PaxosPlot:
     def __init__(self, results_root_dir, simulation_seconds):
         self.results_root_dir = results_root_dir
@@ -53,6 +58,11 @@ class PaxosPlot:
         
         self.sync_res_dir = os.path.join(results_root_dir, "Sync")
         self.async_res_dir = os.path.join(results_root_dir, "Async")
+        self.async_mode_dirs = {
+            "Async": self.async_res_dir,
+            "Sequencer": os.path.join(results_root_dir, "Sequencer"),
+            "Leaderless": os.path.join(results_root_dir, "Leaderless"),
+        }
 
     def plot_sync_opps(self):
         # Plot the results to a line chart
@@ -87,8 +97,14 @@ class PaxosPlot:
         # Y-axis: number of operations per second
         plt.figure()
         plt.yscale('log')
-        sns.barplot(data=self.async_result_df, color='white',
-                    width=0.5, edgecolor='black', hatch='x')
+        async_long_df = self.async_result_df.reset_index(names="Mode").melt(
+            id_vars="Mode", var_name="Delay", value_name="Opps")
+        bars = sns.barplot(data=async_long_df, x="Delay", y="Opps", hue="Mode", color='white',
+                           width=0.5, edgecolor='black')
+        hatches = ['x', '/', '.', '\\']
+        for i, container in enumerate(bars.containers):
+            for bar in container:
+                bar.set_hatch(hatches[i % len(hatches)])
         
         plt.xlabel("End to End Delay", fontsize=14)
         plt.ylabel("Operations per second (log scale)", fontsize=14)
@@ -113,6 +129,8 @@ class PaxosPlot:
             line = plt.axhline(y=sync_res, color=colors[i], linestyle=line_styles[i], linewidth=2.5, label=self.sync_result_df.columns[i])
             lines.append(line)
         
+        mode_legend = plt.legend(handles=bars.containers, labels=list(self.async_result_df.index), loc='upper right', fontsize=12, title="Mode")
+        plt.gca().add_artist(mode_legend)
         plt.legend(handles=lines, loc='best', fontsize=12, title="Bound Delay")
         
         print(sync_results)
@@ -129,6 +147,9 @@ class PaxosPlot:
         # list dirs in this directory
         sync_dirs = os.listdir(self.sync_res_dir)
         for delay_dir in sync_dirs:
+            # Skip the sweep summary
+            if not os.path.isdir(os.path.join(self.sync_res_dir, delay_dir)):
+                continue
             # Parse the delay bound
             # Dir name format: Delay_50us
             delay_bound = int(re.search(r"Delay_(\d+)us", delay_dir).group(1))
@@ -140,7 +161,7 @@ class PaxosPlot:
                 current_dir = os.path.join(self.sync_res_dir, delay_dir, sync_dir)
                 
                 # Parse the number of operations. Get the number of lines of the first file in the directory
-                num_lines = sum(1 for line in open(os.path.join(current_dir, os.listdir(current_dir)[0]), 'r'))
+                num_lines = sum(1 for line in open(first_decision_log(current_dir), 'r'))
             
                 # Calculate the number of operations per second
                 opps = num_lines / self.simulation_seconds
@@ -153,28 +174,33 @@ class PaxosPlot:
         print(self.sync_result_df.describe())
     
     def parse_async_result_dir(self):
-        # Parse the async test results
-        print(f"Reading async test results from '{self.async_res_dir}' directory...")        
+        # Parse the async test results, and the results of the other modes
+        # that run on an asynchronous network (e.g. Sequencer) if present
         results_dict = {}
-        # list dirs in this directory
-        async_dirs = os.listdir(self.async_res_dir)
-        for delay_dir in async_dirs:
-            current_dir = os.path.join(self.async_res_dir, delay_dir)
-            # Parse the e2e delay. Dir name format: Delay_50us
-            e2e_delay = int(re.search(r"Delay_(\d+)us", delay_dir).group(1))
-            
-            # Parse the number of operations. Get the number of lines of the first file in the directory
-            num_lines = sum(1 for line in open(os.path.join(current_dir, os.listdir(current_dir)[0]), 'r'))
-            
-            # Calculate the number of operations per second
-            opps = num_lines / self.simulation_seconds
+        for mode, mode_dir in self.async_mode_dirs.items():
+            if not os.path.isdir(mode_dir):
+                continue
+            print(f"Reading {mode} test results from '{mode_dir}' directory...")
+            results_dict[mode] = {}
+            for delay_dir in os.listdir(mode_dir):
+                current_dir = os.path.join(mode_dir, delay_dir)
+                if not os.path.isdir(current_dir):
+                    continue
+                # Parse the e2e delay. Dir name format: Delay_50us
+                e2e_delay = int(re.search(r"Delay_(\d+)us", delay_dir).group(1))
+
+                # Parse the number of operations. Get the number of lines of the first file in the directory
+                num_lines = sum(1 for line in open(first_decision_log(current_dir), 'r'))
+
+                # Calculate the number of operations per second
+                opps = num_lines / self.simulation_seconds
+
+                results_dict[mode][f"{e2e_delay}us"] = opps
 
-            results_dict[f"{e2e_delay}us"] = opps
-        
         print(f"Async test results:\n{results_dict}")
-            
-        # Transform the dictionary to a Pandas DataFrame
-        self.async_result_df = pd.DataFrame(results_dict, index=[0]).sort_index(axis=1)
+
+        # Transform the dictionary to a Pandas DataFrame, one row per mode
+        self.async_result_df = pd.DataFrame.from_dict(results_dict, orient='index').sort_index(axis=1)
         self.async_result_df = self.async_result_df.rename(columns=to_readable_time)
         print(f"Async test results:\n{self.async_result_df}")
     